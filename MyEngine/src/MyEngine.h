@@ -15,6 +15,15 @@
 
 #include "MyEngine/Filesystem/Filesystem.h"
 
+#include "MyEngine/Renderer/EditorCamera.h"
+#include "MyEngine/Renderer/GeometryPool.h"
+#include "MyEngine/Renderer/Mesh.h"
+#include "MyEngine/Renderer/Quantize.h"
+#include "MyEngine/Renderer/Readback.h"
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/Renderer.h"
 #include "MyEngine/Renderer/Shader.h"
+#include "MyEngine/Renderer/StaticBatch.h"
+#include "MyEngine/Renderer/Texture.h"
 #include "MyEngine/Renderer/VertexArray.h"
+#include "MyEngine/Renderer/VertexLayout.h"
@@ -1,24 +1,84 @@
 
 #include "Application.h"
+#include "MyEngine/Core/InputRecording.h"
+#include "MyEngine/Core/PerfStats.h"
 #include "MyEngine/ImGui/ImGuiLayer.h"
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/Renderer.h"
 #include "MyEngine/Time/Time.h"
 
+#include <charconv>
+
 namespace MyEngine {
 Application *Application::s_Instance = nullptr;
 
-Application::Application(const ApplicationSpecification &specification) {
+Application::Application(const ApplicationSpecification &specification)
+    : m_Specification(specification) {
   s_Instance = this;
 
-  m_Window = Window::Create();
-  m_Window->Init();
+  const ApplicationCommandLineArgs &args = m_Specification.CommandLineArgs;
+  PerfConfig perfConfig;
+  perfConfig.Frames = (uint32_t)args.GetUnsignedOption("perf-frames", 0);
+  perfConfig.WarmupFrames = (uint32_t)args.GetUnsignedOption(
+      "perf-warmup", perfConfig.WarmupFrames);
+  perfConfig.OutputPath = args.GetOption("perf-output", perfConfig.OutputPath);
+  PerfStats::Init(perfConfig);
+
+  // Replay starts first so a replay can be re-recorded for verification
+  std::string replayPath = args.GetOption("input-replay");
+  if (!replayPath.empty()) {
+    InputRecording::StartReplay(replayPath);
+  }
+  std::string recordPath = args.GetOption("input-record");
+  if (!recordPath.empty()) {
+    InputRecording::StartRecording(recordPath);
+  }
+  InputRecording::SetFixedTimestep(
+      (unsigned long)args.GetUnsignedOption("fixed-timestep", 0));
+
+  std::string renderer = args.GetOption("renderer", "vulkan");
+  if (renderer == "null") {
+    RendererAPI::SetAPI(RendererAPI::API::Null);
+  } else if (renderer == "software") {
+    RendererAPI::SetAPI(RendererAPI::API::Software);
+  } else if (renderer != "vulkan") {
+    ME_CORE_ERROR("Unknown renderer {0}, falling back to vulkan", renderer);
+  }
+
+  // Nothing closes a headless run, it needs a limit
+  m_FrameLimit = args.GetUnsignedOption("frames", 0);
+  const bool headless = args.HasFlag("headless") ||
+                        RendererAPI::GetAPI() == RendererAPI::API::Null;
+  if (headless && m_FrameLimit == 0 && !PerfStats::IsEnabled() &&
+      replayPath.empty() && !m_Specification.ClosesItself) {
+    ME_CORE_ERROR("Headless runs never end on their own, pass --frames, "
+                  "--perf-frames or --input-replay");
+    m_Running = false;
+  }
+
+  WindowProperties windowProperties;
+  windowProperties.Headless = args.HasFlag("headless");
+  windowProperties.VSync = m_Specification.VSync && !args.HasFlag("no-vsync");
+  m_Window = Window::Create(windowProperties);
+  m_Window->Init(windowProperties);
   ME_CORE_ASSERT(m_Window != nullptr, "Window is null after creation!");
   m_Window->SetEventCallback(ME_BIND_EVENT_FN(Application::OnEvent));
 
   Renderer::Init();
 
-  m_ImGuiLayer = new ImGuiLayer();
-  PushOverlay(m_ImGuiLayer);
+  // Capture starts before any layer is pushed so resource creation is recorded
+  std::string capturePath = args.GetOption("render-capture");
+  if (!capturePath.empty()) {
+    RenderCapture::Begin(
+        capturePath,
+        (uint32_t)args.GetUnsignedOption("render-capture-frames", 0));
+  }
+
+  // The ImGui backend renders through vulkan
+  if (RendererAPI::GetAPI() == RendererAPI::API::Vulkan) {
+    m_ImGuiLayer = new ImGuiLayer();
+    PushOverlay(m_ImGuiLayer);
+  }
 }
 
 Application::~Application() { Shutdown(); }
@@ -43,6 +103,8 @@ void Application::PushOverlay(Layer *layer) {
 }
 
 void Application::Run() {
+  PerfStats::MarkStartupComplete();
+
   while (m_Running) {
     unsigned long milliseconds = Time::GetTime();
     Timestep timestep = milliseconds - m_LastFrameTime;
@@ -52,26 +114,67 @@ void Application::Run() {
       continue;
     }
 
+    timestep = InputRecording::BeginFrame(timestep);
+
+    PerfStats::BeginFrame();
     if (Renderer::BeginFrame()) {
-      for (Layer *layer : m_LayerStack) {
-        layer->OnUpdate(timestep);
+      {
+        PerfStageScope stage(PerfStage::Update);
+        for (Layer *layer : m_LayerStack) {
+          layer->OnUpdate(timestep);
+        }
+      }
+
+      if (m_ImGuiLayer != nullptr) {
+        PerfStageScope stage(PerfStage::ImGui);
+        m_ImGuiLayer->Begin();
+        for (Layer *layer : m_LayerStack) {
+          layer->OnImGuiRender();
+        }
+        m_ImGuiLayer->End();
+      }
+
+      {
+        PerfStageScope stage(PerfStage::Render);
+        Renderer::EndFrame();
       }
 
-      m_ImGuiLayer->Begin();
-      for (Layer *layer : m_LayerStack) {
-        layer->OnImGuiRender();
+      {
+        PerfStageScope stage(PerfStage::Present);
+        Renderer::PresentFrame();
       }
-      m_ImGuiLayer->End();
+    }
 
-      Renderer::EndFrame();
-      Renderer::PresentFrame();
+    {
+      PerfStageScope stage(PerfStage::Events);
+      m_Window->OnUpdate();
+      InputRecording::DispatchFrameEvents(
+          [this](Event &e) { OnEvent(e, nullptr); });
     }
+    PerfStats::EndFrame();
 
-    m_Window->OnUpdate();
+    m_FrameCount++;
+    if (PerfStats::IsComplete() || InputRecording::IsReplayFinished() ||
+        (m_FrameLimit > 0 && m_FrameCount >= m_FrameLimit)) {
+      m_Running = false;
+    }
   }
+
+  RenderCapture::End();
+  InputRecording::Stop();
+  PerfStats::WriteReport();
 }
 
 void Application::OnEvent(Event &e, void *pData) {
+  // While replaying, live input from the platform is dropped and only the
+  // injected events (which carry no platform data) reach the layers.
+  if (e.IsInCategory(EventCategoryInput)) {
+    if (InputRecording::IsReplaying() && pData != nullptr) {
+      return;
+    }
+    InputRecording::RecordEvent(e);
+  }
+
   EventDispatcher dispatcher(e);
 
   dispatcher.Dispatch<WindowCloseEvent>(
@@ -87,6 +190,8 @@ void Application::OnEvent(Event &e, void *pData) {
   }
 }
 
+void Application::Close() { m_Running = false; }
+
 bool Application::OnWindowClose(WindowCloseEvent &e) {
   m_Running = false;
   return true;
@@ -96,4 +201,47 @@ bool Application::OnWindowResize(WindowResizeEvent &e) {
   // TODO: Renderer resize
   return false;
 }
+
+std::string
+ApplicationCommandLineArgs::GetOption(const std::string &name,
+                                      const std::string &fallback) const {
+  const std::string prefix = "--" + name + "=";
+  for (int i = 1; i < Count; i++) {
+    std::string arg = Args[i];
+    if (arg.rfind(prefix, 0) == 0) {
+      return arg.substr(prefix.size());
+    }
+  }
+
+  return fallback;
+}
+
+unsigned long long ApplicationCommandLineArgs::GetUnsignedOption(
+    const std::string &name, unsigned long long fallback) const {
+  const std::string value = GetOption(name);
+  if (value.empty()) {
+    return fallback;
+  }
+
+  unsigned long long result;
+  const char *end = value.data() + value.size();
+  auto [ptr, ec] = std::from_chars(value.data(), end, result);
+  if (ec != std::errc() || ptr != end) {
+    ME_CORE_ERROR("--{0}={1} is not an unsigned number, using {2}", name,
+                  value, fallback);
+    return fallback;
+  }
+  return result;
+}
+
+bool ApplicationCommandLineArgs::HasFlag(const std::string &name) const {
+  const std::string flag = "--" + name;
+  for (int i = 1; i < Count; i++) {
+    if (flag == Args[i]) {
+      return true;
+    }
+  }
+
+  return false;
+}
 } // namespace MyEngine
@@ -9,9 +9,35 @@
 int main(int argc, char **argv);
 
 namespace MyEngine {
+struct ApplicationCommandLineArgs {
+  int Count = 0;
+  char **Args = nullptr;
+
+  const char *operator[](int index) const {
+    ME_CORE_ASSERT(index < Count);
+    return Args[index];
+  }
+
+  // Looks up an option of the form --name=value, returns the fallback if the
+  // option was not passed.
+  std::string GetOption(const std::string &name,
+                        const std::string &fallback = "") const;
+  // Same for unsigned numbers, values that don't parse log an error and
+  // return the fallback
+  unsigned long long GetUnsignedOption(const std::string &name,
+                                       unsigned long long fallback) const;
+  bool HasFlag(const std::string &name) const;
+};
+
 struct ApplicationSpecification {
   std::string Name = "MyEngine Application";
   std::vector<unsigned char> Version = {'0', '0', '5'};
+  ApplicationCommandLineArgs CommandLineArgs;
+  // Tools measuring throughput turn it off, so does --no-vsync
+  bool VSync = true;
+  // Apps that close themselves once their work is done may run headless
+  // without a frame limit
+  bool ClosesItself = false;
 };
 
 class MYENGINE_API Application {
@@ -20,6 +46,7 @@ public:
   virtual ~Application();
 
   void Shutdown();
+  void Close();
 
   void PushLayer(Layer *layer);
   void PushOverlay(Layer *layer);
@@ -43,10 +70,13 @@ private:
   bool OnWindowResize(WindowResizeEvent &e);
 
   Unique<Window> m_Window;
-  ImGuiLayer *m_ImGuiLayer;
+  ImGuiLayer *m_ImGuiLayer = nullptr;
   ApplicationSpecification m_Specification;
   bool m_Running = true;
   bool m_IsShuttingDown = false;
+  // --frames, 0 runs until the app is closed
+  uint64_t m_FrameLimit = 0;
+  uint64_t m_FrameCount = 0;
   LayerStack m_LayerStack;
 
   unsigned long m_LastFrameTime = 0.0f;
@@ -56,5 +86,5 @@ private:
   friend int ::main(int argc, char *argv[]);
 };
 
-Application *CreateApplication();
+Application *CreateApplication(ApplicationCommandLineArgs args);
 } // namespace MyEngine
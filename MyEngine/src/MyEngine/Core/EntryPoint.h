@@ -5,12 +5,13 @@
 
 #ifdef ME_PLATFORM_LINUX
 
-extern MyEngine::Application *MyEngine::CreateApplication();
+extern MyEngine::Application *
+MyEngine::CreateApplication(MyEngine::ApplicationCommandLineArgs args);
 
 int main(int argc, char *argv[]) {
   MyEngine::Log::Init();
 
-  auto app = MyEngine::CreateApplication();
+  auto app = MyEngine::CreateApplication({argc, argv});
   app->Run();
   delete app;
 
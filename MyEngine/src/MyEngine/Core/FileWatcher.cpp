@@ -0,0 +1,46 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/FileWatcher.h"
+
+#include <filesystem>
+
+namespace MyEngine {
+std::string FileWatcher::Normalize(const std::string &filepath) {
+  std::error_code error;
+  std::filesystem::path path = std::filesystem::weakly_canonical(
+      std::filesystem::absolute(filepath), error);
+  return error ? filepath : path.string();
+}
+
+#ifndef ME_PLATFORM_LINUX
+// Fallback for platforms without a native watcher, compares modification
+// times on every poll.
+struct FileWatcher::FileWatcherData {
+  std::unordered_map<std::string, std::filesystem::file_time_type> Files;
+};
+
+FileWatcher::FileWatcher() : m_Data(CreateUnique<FileWatcherData>()) {}
+
+FileWatcher::~FileWatcher() {}
+
+void FileWatcher::Watch(const std::string &filepath) {
+  std::string path = Normalize(filepath);
+  std::error_code error;
+  m_Data->Files[path] = std::filesystem::last_write_time(path, error);
+}
+
+std::vector<std::string> FileWatcher::Poll() {
+  std::vector<std::string> changed;
+  for (auto &[path, time] : m_Data->Files) {
+    std::error_code error;
+    auto current = std::filesystem::last_write_time(path, error);
+    if (!error && current != time) {
+      time = current;
+      changed.push_back(path);
+    }
+  }
+
+  return changed;
+}
+#endif
+} // namespace MyEngine
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+namespace MyEngine {
+// Reports changes to a set of files without blocking. Directories are watched
+// rather than the files themselves so editors that save by replacing the file
+// are picked up as well.
+class FileWatcher {
+public:
+  FileWatcher();
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher &) = delete;
+  FileWatcher &operator=(const FileWatcher &) = delete;
+
+  void Watch(const std::string &filepath);
+
+  // Returns the absolute paths of the watched files that changed since the
+  // last call.
+  std::vector<std::string> Poll();
+
+  static std::string Normalize(const std::string &filepath);
+
+private:
+  struct FileWatcherData;
+  Unique<FileWatcherData> m_Data;
+};
+} // namespace MyEngine
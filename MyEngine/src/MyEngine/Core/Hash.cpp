@@ -0,0 +1,111 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Hash.h"
+
+#include <cstring>
+
+namespace MyEngine {
+namespace Hash {
+static constexpr uint64_t s_Prime1 = 0x9E3779B185EBCA87ULL;
+static constexpr uint64_t s_Prime2 = 0xC2B2AE3D27D4EB4FULL;
+static constexpr uint64_t s_Prime3 = 0x165667B19E3779F9ULL;
+static constexpr uint64_t s_Prime4 = 0x85EBCA77C2B2AE63ULL;
+static constexpr uint64_t s_Prime5 = 0x27D4EB2F165667C5ULL;
+
+static uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// Reads are little endian, which every supported platform is
+static uint64_t Read64(const uint8_t *p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static uint32_t Read32(const uint8_t *p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static uint64_t Round(uint64_t accumulator, uint64_t input) {
+  accumulator += input * s_Prime2;
+  accumulator = RotateLeft(accumulator, 31);
+  return accumulator * s_Prime1;
+}
+
+static uint64_t MergeRound(uint64_t accumulator, uint64_t value) {
+  accumulator ^= Round(0, value);
+  return accumulator * s_Prime1 + s_Prime4;
+}
+
+uint64_t XXH64(const void *data, size_t size, uint64_t seed) {
+  const uint8_t *p = static_cast<const uint8_t *>(data);
+  const uint8_t *end = p + size;
+  uint64_t hash;
+
+  if (size >= 32) {
+    const uint8_t *limit = end - 32;
+    uint64_t v1 = seed + s_Prime1 + s_Prime2;
+    uint64_t v2 = seed + s_Prime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - s_Prime1;
+
+    do {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+
+    hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) +
+           RotateLeft(v4, 18);
+    hash = MergeRound(hash, v1);
+    hash = MergeRound(hash, v2);
+    hash = MergeRound(hash, v3);
+    hash = MergeRound(hash, v4);
+  } else {
+    hash = seed + s_Prime5;
+  }
+
+  hash += (uint64_t)size;
+
+  while (p + 8 <= end) {
+    hash ^= Round(0, Read64(p));
+    hash = RotateLeft(hash, 27) * s_Prime1 + s_Prime4;
+    p += 8;
+  }
+
+  if (p + 4 <= end) {
+    hash ^= (uint64_t)Read32(p) * s_Prime1;
+    hash = RotateLeft(hash, 23) * s_Prime2 + s_Prime3;
+    p += 4;
+  }
+
+  while (p < end) {
+    hash ^= (*p) * s_Prime5;
+    hash = RotateLeft(hash, 11) * s_Prime1;
+    p++;
+  }
+
+  hash ^= hash >> 33;
+  hash *= s_Prime2;
+  hash ^= hash >> 29;
+  hash *= s_Prime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+std::string ToHexString(uint64_t hash) {
+  static constexpr char s_Digits[] = "0123456789abcdef";
+  std::string hex(16, '0');
+  for (int i = 15; i >= 0; i--) {
+    hex[i] = s_Digits[hash & 0xF];
+    hash >>= 4;
+  }
+  return hex;
+}
+} // namespace Hash
+} // namespace MyEngine
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MyEngine {
+namespace Hash {
+// 64 bit xxHash (XXH64), fast non cryptographic hash for cache keys.
+uint64_t XXH64(const void *data, size_t size, uint64_t seed = 0);
+
+inline uint64_t XXH64(const std::string &data, uint64_t seed = 0) {
+  return XXH64(data.data(), data.size(), seed);
+}
+
+// Mixes a value into an existing hash, order dependent.
+inline uint64_t Combine(uint64_t hash, uint64_t value) {
+  return XXH64(&value, sizeof(value), hash);
+}
+
+std::string ToHexString(uint64_t hash);
+} // namespace Hash
+} // namespace MyEngine
@@ -0,0 +1,48 @@
+#include "MyEngine/Core/Hash.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace MyEngine {
+// Reference values of the xxHash implementation
+TEST(HashTest, MatchesReferenceXXH64) {
+  using namespace std::string_literals;
+  EXPECT_EQ(Hash::XXH64(""s), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(Hash::XXH64("a"s), 0xD24EC4F1A98C6E5BULL);
+  EXPECT_EQ(Hash::XXH64("abc"s), 0x44BC2CF5AD770999ULL);
+  EXPECT_EQ(Hash::XXH64("xxhash"s), 0x32DD38952C4BC720ULL);
+  EXPECT_EQ(Hash::XXH64("xxhash"s, 20141025), 0xB559B98D844E0635ULL);
+  // Past 32 bytes, hashed in stripes
+  EXPECT_EQ(Hash::XXH64("Nobody inspects the spammish repetition"s),
+            0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(HashTest, EveryTailLengthChangesTheHash) {
+  // Covers the 8, 4 and 1 byte tails after each stripe count
+  std::vector<uint8_t> data(100);
+  std::iota(data.begin(), data.end(), (uint8_t)0);
+
+  std::vector<uint64_t> hashes;
+  for (size_t size = 0; size <= data.size(); size++) {
+    hashes.push_back(Hash::XXH64(data.data(), size));
+  }
+  std::sort(hashes.begin(), hashes.end());
+  EXPECT_EQ(std::unique(hashes.begin(), hashes.end()), hashes.end());
+}
+
+TEST(HashTest, CombineIsOrderDependent) {
+  const uint64_t ab = Hash::Combine(Hash::Combine(0, 1), 2);
+  const uint64_t ba = Hash::Combine(Hash::Combine(0, 2), 1);
+  EXPECT_NE(ab, ba);
+  EXPECT_EQ(ab, Hash::Combine(Hash::Combine(0, 1), 2));
+}
+
+TEST(HashTest, ToHexStringPadsToSixteenDigits) {
+  EXPECT_EQ(Hash::ToHexString(0), "0000000000000000");
+  EXPECT_EQ(Hash::ToHexString(0xEF46DB3751D8E999ULL), "ef46db3751d8e999");
+}
+} // namespace MyEngine
@@ -0,0 +1,287 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/InputRecording.h"
+
+#include "MyEngine/Events/KeyEvent.h"
+#include "MyEngine/Events/MouseEvent.h"
+#include "MyEngine/Filesystem/Filesystem.h"
+
+#include <cstring>
+#include <unordered_set>
+
+namespace MyEngine {
+static constexpr char s_Magic[4] = {'M', 'E', 'I', 'R'};
+static constexpr uint16_t s_Version = 2;
+static constexpr size_t s_HeaderSize = 8;
+static constexpr uint8_t s_FrameTag = 0xFF;
+// Frame delta of frames without a recorded one, unless a fixed timestep is set
+static constexpr uint32_t s_DefaultTimestep = 16;
+
+struct InputRecordingData {
+  std::string RecordPath;
+  std::vector<uint8_t> RecordBuffer;
+  bool FrameRecorded = false;
+
+  std::vector<uint8_t> ReplayBuffer;
+  size_t ReadOffset = 0;
+
+  std::unordered_set<KeyCode> KeysDown;
+  uint32_t MouseButtons = 0;
+  Vector2 MousePosition = {0.0f, 0.0f};
+};
+
+bool InputRecording::s_Recording = false;
+bool InputRecording::s_Replaying = false;
+unsigned long InputRecording::s_FixedTimestep = 0;
+static InputRecordingData s_Data;
+
+template <typename T> static void Write(const T &value) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+  s_Data.RecordBuffer.insert(s_Data.RecordBuffer.end(), bytes,
+                             bytes + sizeof(T));
+}
+
+template <typename T> static T Read() {
+  T value{};
+  if (s_Data.ReadOffset + sizeof(T) > s_Data.ReplayBuffer.size()) {
+    s_Data.ReadOffset = s_Data.ReplayBuffer.size();
+    return value;
+  }
+
+  memcpy(&value, s_Data.ReplayBuffer.data() + s_Data.ReadOffset, sizeof(T));
+  s_Data.ReadOffset += sizeof(T);
+  return value;
+}
+
+static uint32_t GetFixedTimestep(unsigned long fixedTimestep) {
+  return fixedTimestep > 0 ? (uint32_t)fixedTimestep : s_DefaultTimestep;
+}
+
+static void WriteFrame(uint32_t milliseconds) {
+  Write<uint8_t>(s_FrameTag);
+  Write<uint32_t>(milliseconds);
+  s_Data.FrameRecorded = true;
+}
+
+// Buttons past the bits of the mask are passed on but not tracked
+static uint32_t GetButtonBit(MouseCode button) {
+  return button < 32 ? 1u << button : 0;
+}
+
+static bool PeekFrameTag() {
+  return s_Data.ReadOffset < s_Data.ReplayBuffer.size() &&
+         s_Data.ReplayBuffer[s_Data.ReadOffset] == s_FrameTag;
+}
+
+bool InputRecording::StartRecording(const std::string &path) {
+  s_Data.RecordPath = path;
+  s_Data.RecordBuffer.clear();
+  s_Data.FrameRecorded = false;
+  s_Data.RecordBuffer.insert(s_Data.RecordBuffer.end(), s_Magic, s_Magic + 4);
+  Write<uint16_t>(s_Version);
+  Write<uint16_t>(0);
+
+  s_Recording = true;
+  ME_CORE_INFO("Recording input to {0}", path);
+  return true;
+}
+
+bool InputRecording::StartReplay(const std::string &path) {
+  std::string contents;
+  Filesystem::FsReadStatus status = Filesystem::ReadFile(path, &contents);
+  if (status != Filesystem::READ_SUCCESS) {
+    ME_CORE_ERROR("Unable to read input recording {0}: {1}", path,
+                  Filesystem::FsReadStatusToString(status));
+    return false;
+  }
+
+  if (contents.size() < s_HeaderSize ||
+      memcmp(contents.data(), s_Magic, 4) != 0) {
+    ME_CORE_ERROR("{0} is not an input recording", path);
+    return false;
+  }
+
+  uint16_t version;
+  memcpy(&version, contents.data() + 4, sizeof(version));
+  if (version != s_Version) {
+    ME_CORE_ERROR("Input recording {0} has version {1}, expected {2}", path,
+                  version, s_Version);
+    return false;
+  }
+
+  s_Data.ReplayBuffer.assign(contents.begin(), contents.end());
+  s_Data.ReadOffset = s_HeaderSize;
+  s_Data.KeysDown.clear();
+  s_Data.MouseButtons = 0;
+  s_Data.MousePosition = {0.0f, 0.0f};
+
+  s_Replaying = true;
+  ME_CORE_INFO("Replaying input from {0}", path);
+  return true;
+}
+
+void InputRecording::Stop() {
+  if (s_Recording) {
+    std::ofstream out(s_Data.RecordPath, std::ios::out | std::ios::binary);
+    if (out.is_open()) {
+      out.write((const char *)s_Data.RecordBuffer.data(),
+                s_Data.RecordBuffer.size());
+      out.close();
+      ME_CORE_INFO("Input recording written to {0} ({1} bytes)",
+                   s_Data.RecordPath, s_Data.RecordBuffer.size());
+    } else {
+      ME_CORE_ERROR("Unable to write input recording to {0}",
+                    s_Data.RecordPath);
+    }
+  }
+
+  s_Recording = false;
+  s_Replaying = false;
+  s_Data = InputRecordingData();
+}
+
+bool InputRecording::IsReplayFinished() {
+  return s_Replaying && s_Data.ReadOffset >= s_Data.ReplayBuffer.size();
+}
+
+Timestep InputRecording::BeginFrame(Timestep measured) {
+  unsigned long milliseconds = measured.GetMilliseconds();
+
+  // Replays never use measured time, recordings start with a frame marker
+  if (s_Replaying) {
+    milliseconds = GetFixedTimestep(s_FixedTimestep);
+    if (PeekFrameTag()) {
+      s_Data.ReadOffset++;
+      milliseconds = Read<uint32_t>();
+    }
+  }
+
+  if (s_FixedTimestep > 0) {
+    milliseconds = s_FixedTimestep;
+  }
+
+  if (s_Recording) {
+    WriteFrame((uint32_t)milliseconds);
+  }
+
+  return Timestep(milliseconds);
+}
+
+void InputRecording::RecordEvent(const Event &event) {
+  if (!s_Recording || !(event.GetCategoryFlags() & EventCategoryInput)) {
+    return;
+  }
+
+  // Events before the first frame get a frame of their own, replayed with the
+  // fixed timestep, so every later frame keeps its own delta
+  if (!s_Data.FrameRecorded) {
+    WriteFrame(GetFixedTimestep(s_FixedTimestep));
+  }
+
+  EventType type = event.GetEventType();
+  switch (type) {
+  case EventType::KeyPressed: {
+    const KeyPressedEvent &e = static_cast<const KeyPressedEvent &>(event);
+    Write<uint8_t>((uint8_t)type);
+    Write<int32_t>(e.GetKeyCode());
+    Write<uint8_t>(e.IsRepeat());
+  } break;
+  case EventType::KeyReleased:
+  case EventType::KeyTyped: {
+    const KeyEvent &e = static_cast<const KeyEvent &>(event);
+    Write<uint8_t>((uint8_t)type);
+    Write<int32_t>(e.GetKeyCode());
+  } break;
+  case EventType::MouseButtonPressed:
+  case EventType::MouseButtonReleased: {
+    const MouseButtonEvent &e = static_cast<const MouseButtonEvent &>(event);
+    Write<uint8_t>((uint8_t)type);
+    Write<uint8_t>(e.GetMouseButton());
+  } break;
+  case EventType::MouseMoved: {
+    const MouseMovedEvent &e = static_cast<const MouseMovedEvent &>(event);
+    Write<uint8_t>((uint8_t)type);
+    Write<float>(e.GetX());
+    Write<float>(e.GetY());
+  } break;
+  case EventType::MouseScrolled: {
+    const MouseScrolledEvent &e =
+        static_cast<const MouseScrolledEvent &>(event);
+    Write<uint8_t>((uint8_t)type);
+    Write<float>(e.GetX());
+    Write<float>(e.GetY());
+  } break;
+  default:
+    break;
+  }
+}
+
+void InputRecording::DispatchFrameEvents(const EventHandlerFn &handler) {
+  if (!s_Replaying) {
+    return;
+  }
+
+  while (s_Data.ReadOffset < s_Data.ReplayBuffer.size() && !PeekFrameTag()) {
+    EventType type = (EventType)Read<uint8_t>();
+    switch (type) {
+    case EventType::KeyPressed: {
+      KeyCode key = Read<int32_t>();
+      bool repeat = Read<uint8_t>() != 0;
+      s_Data.KeysDown.insert(key);
+      KeyPressedEvent e(key, repeat);
+      handler(e);
+    } break;
+    case EventType::KeyReleased: {
+      KeyCode key = Read<int32_t>();
+      s_Data.KeysDown.erase(key);
+      KeyReleasedEvent e(key);
+      handler(e);
+    } break;
+    case EventType::KeyTyped: {
+      KeyTypedEvent e(Read<int32_t>());
+      handler(e);
+    } break;
+    case EventType::MouseButtonPressed: {
+      MouseCode button = Read<uint8_t>();
+      s_Data.MouseButtons |= GetButtonBit(button);
+      MouseButtonPressedEvent e(button);
+      handler(e);
+    } break;
+    case EventType::MouseButtonReleased: {
+      MouseCode button = Read<uint8_t>();
+      s_Data.MouseButtons &= ~GetButtonBit(button);
+      MouseButtonReleasedEvent e(button);
+      handler(e);
+    } break;
+    case EventType::MouseMoved: {
+      float x = Read<float>();
+      float y = Read<float>();
+      s_Data.MousePosition = {x, y};
+      MouseMovedEvent e(x, y);
+      handler(e);
+    } break;
+    case EventType::MouseScrolled: {
+      float x = Read<float>();
+      float y = Read<float>();
+      MouseScrolledEvent e(x, y);
+      handler(e);
+    } break;
+    default: {
+      ME_CORE_ERROR("Corrupted input recording, unknown record {0} at {1}",
+                    (int)type, s_Data.ReadOffset - 1);
+      s_Data.ReadOffset = s_Data.ReplayBuffer.size();
+    } break;
+    }
+  }
+}
+
+bool InputRecording::IsKeyPressed(KeyCode key) {
+  return s_Data.KeysDown.find(key) != s_Data.KeysDown.end();
+}
+
+bool InputRecording::IsMouseButtonPressed(MouseCode button) {
+  return s_Data.MouseButtons & GetButtonBit(button);
+}
+
+Vector2 InputRecording::GetMousePosition() { return s_Data.MousePosition; }
+} // namespace MyEngine
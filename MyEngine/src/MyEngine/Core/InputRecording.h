@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Core/KeyCodes.h"
+#include "MyEngine/Core/MouseCodes.h"
+#include "MyEngine/Core/Timestep.h"
+#include "MyEngine/Events/Event.h"
+#include "MyEngine/Math/Math.h"
+
+namespace MyEngine {
+// Records input events and frame deltas to a compact binary file and replays
+// them in place of the platform input so perf captures are repeatable.
+//
+// File layout: an 8 byte header ("MEIR", u16 version, u16 reserved) followed by
+// a stream of records. Each record starts with a one byte tag, either a frame
+// marker carrying the u32 frame delta in milliseconds or an EventType followed
+// by the event payload. Recordings always start with a frame marker.
+class InputRecording {
+public:
+  using EventHandlerFn = std::function<void(Event &)>;
+
+  static bool StartRecording(const std::string &path);
+  static bool StartReplay(const std::string &path);
+  static void Stop();
+
+  static bool IsRecording() { return s_Recording; }
+  static bool IsReplaying() { return s_Replaying; }
+  static bool IsReplayFinished();
+
+  // Overrides every frame delta, 0 keeps the measured or recorded delta.
+  static void SetFixedTimestep(unsigned long milliseconds) {
+    s_FixedTimestep = milliseconds;
+  }
+
+  // Called once at the start of every frame with the measured delta, returns
+  // the delta the frame should use.
+  static Timestep BeginFrame(Timestep measured);
+
+  static void RecordEvent(const Event &event);
+
+  // Injects every recorded event of the current frame.
+  static void DispatchFrameEvents(const EventHandlerFn &handler);
+
+  // Input state reconstructed from the replayed events
+  static bool IsKeyPressed(KeyCode key);
+  static bool IsMouseButtonPressed(MouseCode button);
+  static Vector2 GetMousePosition();
+
+private:
+  static bool s_Recording;
+  static bool s_Replaying;
+  static unsigned long s_FixedTimestep;
+};
+} // namespace MyEngine
@@ -0,0 +1,79 @@
+#include "MyEngine/Core/InputRecording.h"
+#include "MyEngine/Events/KeyEvent.h"
+#include "MyEngine/Events/MouseEvent.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace MyEngine {
+static std::string GetRecordingPath() {
+  return (std::filesystem::temp_directory_path() / "InputRecordingTest.meir")
+      .string();
+}
+
+static std::vector<EventType> DispatchFrame() {
+  std::vector<EventType> types;
+  InputRecording::DispatchFrameEvents(
+      [&types](Event &e) { types.push_back(e.GetEventType()); });
+  return types;
+}
+
+TEST(InputRecordingTest, ReplaysRecordedFramesAndEvents) {
+  const std::string path = GetRecordingPath();
+  ASSERT_TRUE(InputRecording::StartRecording(path));
+  InputRecording::BeginFrame(Timestep(10));
+  InputRecording::RecordEvent(KeyPressedEvent(65));
+  InputRecording::RecordEvent(MouseMovedEvent(1.5f, 2.5f));
+  InputRecording::BeginFrame(Timestep(20));
+  InputRecording::RecordEvent(KeyReleasedEvent(65));
+  InputRecording::RecordEvent(MouseButtonPressedEvent(Mouse::ButtonLeft));
+  InputRecording::Stop();
+
+  ASSERT_TRUE(InputRecording::StartReplay(path));
+  EXPECT_EQ(InputRecording::BeginFrame(Timestep(999)).GetMilliseconds(), 10);
+  EXPECT_EQ(DispatchFrame(),
+            (std::vector<EventType>{EventType::KeyPressed,
+                                    EventType::MouseMoved}));
+  EXPECT_TRUE(InputRecording::IsKeyPressed(65));
+  EXPECT_EQ(InputRecording::GetMousePosition().x, 1.5f);
+  EXPECT_EQ(InputRecording::GetMousePosition().y, 2.5f);
+  EXPECT_FALSE(InputRecording::IsReplayFinished());
+
+  EXPECT_EQ(InputRecording::BeginFrame(Timestep(999)).GetMilliseconds(), 20);
+  EXPECT_EQ(DispatchFrame(),
+            (std::vector<EventType>{EventType::KeyReleased,
+                                    EventType::MouseButtonPressed}));
+  EXPECT_FALSE(InputRecording::IsKeyPressed(65));
+  EXPECT_TRUE(InputRecording::IsMouseButtonPressed(Mouse::ButtonLeft));
+  EXPECT_TRUE(InputRecording::IsReplayFinished());
+
+  InputRecording::Stop();
+  std::filesystem::remove(path);
+}
+
+TEST(InputRecordingTest, FixedTimestepOverridesRecordedDeltas) {
+  const std::string path = GetRecordingPath();
+  ASSERT_TRUE(InputRecording::StartRecording(path));
+  InputRecording::BeginFrame(Timestep(10));
+  InputRecording::Stop();
+
+  ASSERT_TRUE(InputRecording::StartReplay(path));
+  InputRecording::SetFixedTimestep(16);
+  EXPECT_EQ(InputRecording::BeginFrame(Timestep(999)).GetMilliseconds(), 16);
+  InputRecording::SetFixedTimestep(0);
+
+  InputRecording::Stop();
+  std::filesystem::remove(path);
+}
+
+TEST(InputRecordingTest, RejectsFilesThatAreNotRecordings) {
+  const std::string path = GetRecordingPath();
+  std::ofstream(path, std::ios::binary) << "not a recording";
+
+  EXPECT_FALSE(InputRecording::StartReplay(path));
+  EXPECT_FALSE(InputRecording::IsReplaying());
+  std::filesystem::remove(path);
+}
+} // namespace MyEngine
@@ -0,0 +1,269 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/PerfStats.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#ifdef ME_PLATFORM_WINDOWS
+#include <malloc.h>
+#endif
+
+// Count every heap allocation made by the process. The counter is a relaxed
+// atomic so the overhead stays negligible when no capture is running.
+#ifndef ME_DISABLE_ALLOCATION_TRACKING
+static std::atomic<uint64_t> s_AllocationCount{0};
+
+void *operator new(std::size_t size) {
+  s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+// Over-aligned types go through their own overloads, which have to match the
+// ones above so every allocation is counted and freed by the same allocator
+static void *AlignedAllocate(std::size_t size, std::align_val_t alignment) {
+  s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef ME_PLATFORM_WINDOWS
+  void *ptr = _aligned_malloc(size ? size : 1, align);
+#else
+  // aligned_alloc wants a multiple of the alignment
+  void *ptr = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+  if (ptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+static void AlignedFree(void *ptr) {
+#ifdef ME_PLATFORM_WINDOWS
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return AlignedAllocate(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return AlignedAllocate(size, alignment);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept { AlignedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+#endif
+
+namespace MyEngine {
+using PerfClock = std::chrono::steady_clock;
+
+// Initialized during static construction, which is as close to process start
+// as we can get without platform specific calls.
+static const PerfClock::time_point s_ProcessStart = PerfClock::now();
+
+struct PerfData {
+  uint32_t FrameIndex = 0;
+  double StartupMilliseconds = 0.0;
+  uint64_t StartupAllocations = 0;
+
+  PerfClock::time_point FrameStart;
+  uint64_t FrameStartAllocations = 0;
+  std::array<PerfClock::time_point, (size_t)PerfStage::Count> StageStart;
+  std::array<double, (size_t)PerfStage::Count> StageAccum{};
+
+  std::vector<double> FrameTimes;
+  std::vector<uint64_t> FrameAllocations;
+  std::array<std::vector<double>, (size_t)PerfStage::Count> StageTimes;
+};
+
+PerfConfig PerfStats::s_Config;
+static PerfData s_Data;
+
+static const char *PerfStageToString(PerfStage stage) {
+  switch (stage) {
+  case PerfStage::Events:
+    return "events";
+  case PerfStage::Update:
+    return "update";
+  case PerfStage::ImGui:
+    return "imgui";
+  case PerfStage::Render:
+    return "render";
+  case PerfStage::Present:
+    return "present";
+  default:
+    return "unknown";
+  }
+}
+
+static double ToMilliseconds(PerfClock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+static double Median(std::vector<double> values) {
+  if (values.empty()) {
+    return 0.0;
+  }
+
+  size_t mid = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + mid, values.end());
+  double median = values[mid];
+  if (values.size() % 2 == 0) {
+    median =
+        (median + *std::max_element(values.begin(), values.begin() + mid)) *
+        0.5;
+  }
+
+  return median;
+}
+
+void PerfStats::Init(const PerfConfig &config) {
+  s_Config = config;
+  s_Data = PerfData();
+
+  if (IsEnabled()) {
+    ME_CORE_INFO("Perf capture enabled: {0} frames ({1} warmup) -> {2}",
+                 s_Config.Frames, s_Config.WarmupFrames, s_Config.OutputPath);
+    s_Data.FrameTimes.reserve(s_Config.Frames);
+    s_Data.FrameAllocations.reserve(s_Config.Frames);
+    for (std::vector<double> &stage : s_Data.StageTimes) {
+      stage.reserve(s_Config.Frames);
+    }
+  }
+}
+
+bool PerfStats::IsComplete() {
+  return IsEnabled() &&
+         s_Data.FrameIndex >= s_Config.WarmupFrames + s_Config.Frames;
+}
+
+void PerfStats::MarkStartupComplete() {
+  s_Data.StartupMilliseconds = ToMilliseconds(PerfClock::now() - s_ProcessStart);
+  s_Data.StartupAllocations = GetAllocationCount();
+}
+
+void PerfStats::BeginFrame() {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  s_Data.StageAccum.fill(0.0);
+  s_Data.FrameStartAllocations = GetAllocationCount();
+  s_Data.FrameStart = PerfClock::now();
+}
+
+void PerfStats::EndFrame() {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  PerfClock::time_point now = PerfClock::now();
+  uint64_t allocations = GetAllocationCount() - s_Data.FrameStartAllocations;
+
+  uint32_t frame = s_Data.FrameIndex++;
+  if (frame < s_Config.WarmupFrames ||
+      s_Data.FrameTimes.size() >= s_Config.Frames) {
+    return;
+  }
+
+  s_Data.FrameTimes.push_back(ToMilliseconds(now - s_Data.FrameStart));
+  s_Data.FrameAllocations.push_back(allocations);
+  for (size_t i = 0; i < (size_t)PerfStage::Count; i++) {
+    s_Data.StageTimes[i].push_back(s_Data.StageAccum[i]);
+  }
+}
+
+void PerfStats::BeginStage(PerfStage stage) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  s_Data.StageStart[(size_t)stage] = PerfClock::now();
+}
+
+void PerfStats::EndStage(PerfStage stage) {
+  if (!IsEnabled()) {
+    return;
+  }
+
+  s_Data.StageAccum[(size_t)stage] +=
+      ToMilliseconds(PerfClock::now() - s_Data.StageStart[(size_t)stage]);
+}
+
+uint64_t PerfStats::GetAllocationCount() {
+#ifndef ME_DISABLE_ALLOCATION_TRACKING
+  return s_AllocationCount.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif
+}
+
+bool PerfStats::WriteReport() {
+  if (!IsEnabled()) {
+    return false;
+  }
+
+  std::ofstream out(s_Config.OutputPath, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    ME_CORE_ERROR("Unable to write perf report to {0}", s_Config.OutputPath);
+    return false;
+  }
+
+  double allocationsPerFrame = 0.0;
+  for (uint64_t allocations : s_Data.FrameAllocations) {
+    allocationsPerFrame += (double)allocations;
+  }
+  if (!s_Data.FrameAllocations.empty()) {
+    allocationsPerFrame /= (double)s_Data.FrameAllocations.size();
+  }
+
+  // Every value is a per run summary, the harness aggregates across runs.
+  out << "{\n";
+  out << "  \"frames\": " << s_Data.FrameTimes.size() << ",\n";
+  out << "  \"metrics\": {\n";
+  out << "    \"startup_ms\": " << s_Data.StartupMilliseconds << ",\n";
+  out << "    \"startup_allocs\": " << s_Data.StartupAllocations << ",\n";
+  out << "    \"frame_ms\": " << Median(s_Data.FrameTimes) << ",\n";
+  for (size_t i = 0; i < (size_t)PerfStage::Count; i++) {
+    out << "    \"stage_" << PerfStageToString((PerfStage)i)
+        << "_ms\": " << Median(s_Data.StageTimes[i]) << ",\n";
+  }
+  out << "    \"allocs_per_frame\": " << allocationsPerFrame << "\n";
+  out << "  }\n";
+  out << "}\n";
+  out.close();
+
+  ME_CORE_INFO("Perf report written to {0}", s_Config.OutputPath);
+  return true;
+}
+} // namespace MyEngine
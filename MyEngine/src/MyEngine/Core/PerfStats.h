@@ -0,0 +1,61 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+namespace MyEngine {
+enum class PerfStage {
+  Events = 0,
+  Update,
+  ImGui,
+  Render,
+  Present,
+
+  Count
+};
+
+struct PerfConfig {
+  // Number of measured frames, 0 disables the capture.
+  uint32_t Frames = 0;
+  // Frames run before measuring starts, excluded from the report.
+  uint32_t WarmupFrames = 30;
+  std::string OutputPath = "perf.json";
+};
+
+// Collects startup time, per frame cpu time per stage and allocation counts
+// for the perf regression harness (scripts/perf.sh). When enabled the
+// application exits after the configured number of frames and writes a json
+// report.
+class PerfStats {
+public:
+  static void Init(const PerfConfig &config);
+
+  static bool IsEnabled() { return s_Config.Frames > 0; }
+  static bool IsComplete();
+
+  static void MarkStartupComplete();
+
+  static void BeginFrame();
+  static void EndFrame();
+
+  static void BeginStage(PerfStage stage);
+  static void EndStage(PerfStage stage);
+
+  static uint64_t GetAllocationCount();
+
+  static bool WriteReport();
+
+private:
+  static PerfConfig s_Config;
+};
+
+class PerfStageScope {
+public:
+  PerfStageScope(PerfStage stage) : m_Stage(stage) {
+    PerfStats::BeginStage(stage);
+  }
+  ~PerfStageScope() { PerfStats::EndStage(m_Stage); }
+
+private:
+  PerfStage m_Stage;
+};
+} // namespace MyEngine
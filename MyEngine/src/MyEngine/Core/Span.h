@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+namespace MyEngine {
+// Non owning view of count contiguous elements, for writing into memory owned
+// elsewhere like a mapped buffer without going through a temporary copy
+template <typename T> class Span {
+public:
+  Span() = default;
+  Span(T *data, size_t count) : m_Data(data), m_Count(count) {}
+
+  T *data() const { return m_Data; }
+  size_t size() const { return m_Count; }
+  size_t size_bytes() const { return m_Count * sizeof(T); }
+  bool empty() const { return m_Count == 0; }
+
+  T &operator[](size_t index) const { return m_Data[index]; }
+
+  T *begin() const { return m_Data; }
+  T *end() const { return m_Data + m_Count; }
+
+private:
+  T *m_Data = nullptr;
+  size_t m_Count = 0;
+};
+} // namespace MyEngine
@@ -0,0 +1,10 @@
+#include "MyEngine/Core/Log.h"
+
+#include <gtest/gtest.h>
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  // Engine code logs through the core logger
+  MyEngine::Log::Init();
+  return RUN_ALL_TESTS();
+}
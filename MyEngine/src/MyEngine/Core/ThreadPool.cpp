@@ -0,0 +1,112 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/ThreadPool.h"
+
+#include <atomic>
+
+namespace MyEngine {
+ThreadPool::ThreadPool(uint32_t threadCount) {
+  if (threadCount == 0) {
+    uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  m_Workers.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; i++) {
+    m_Workers.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stopping = true;
+  }
+  m_Condition.notify_all();
+
+  for (std::thread &worker : m_Workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Enqueue(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Jobs.push_back(std::move(job));
+  }
+  m_Condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Condition.wait(lock,
+                       [this]() { return m_Stopping || !m_Jobs.empty(); });
+      if (m_Stopping && m_Jobs.empty()) {
+        return;
+      }
+
+      job = std::move(m_Jobs.front());
+      m_Jobs.pop_front();
+    }
+
+    job();
+  }
+}
+
+void ThreadPool::ParallelFor(uint32_t count,
+                             const std::function<void(uint32_t)> &function) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1 || m_Workers.empty()) {
+    for (uint32_t i = 0; i < count; i++) {
+      function(i);
+    }
+    return;
+  }
+
+  // Shared with the helper jobs, which may only start after this call
+  // returned and then find no work left.
+  struct ParallelForState {
+    std::atomic<uint32_t> Next{0};
+    std::atomic<uint32_t> Completed{0};
+    uint32_t Count;
+    const std::function<void(uint32_t)> *Function;
+    std::mutex Mutex;
+    std::condition_variable Done;
+  };
+  auto state = std::make_shared<ParallelForState>();
+  state->Count = count;
+  state->Function = &function;
+
+  auto work = [state]() {
+    uint32_t index;
+    while ((index = state->Next.fetch_add(1)) < state->Count) {
+      (*state->Function)(index);
+      if (state->Completed.fetch_add(1) + 1 == state->Count) {
+        std::lock_guard<std::mutex> lock(state->Mutex);
+        state->Done.notify_all();
+      }
+    }
+  };
+
+  uint32_t helpers = std::min(count - 1, GetThreadCount());
+  for (uint32_t i = 0; i < helpers; i++) {
+    Enqueue(work);
+  }
+  work();
+
+  std::unique_lock<std::mutex> lock(state->Mutex);
+  state->Done.wait(lock, [&state]() {
+    return state->Completed.load() == state->Count;
+  });
+}
+
+ThreadPool &ThreadPool::Get() {
+  static ThreadPool s_Pool;
+  return s_Pool;
+}
+} // namespace MyEngine
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace MyEngine {
+// A fixed set of worker threads pulling jobs from a shared queue.
+class ThreadPool {
+public:
+  // 0 uses one worker less than the hardware threads, the thread calling
+  // ParallelFor makes up for the missing one.
+  explicit ThreadPool(uint32_t threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  template <typename F>
+  std::future<std::invoke_result_t<F>> Submit(F &&function) {
+    using Result = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<F>(function));
+    std::future<Result> future = task->get_future();
+    Enqueue([task]() { (*task)(); });
+    return future;
+  }
+
+  // Calls function(i) for every i in [0, count) on the workers and the calling
+  // thread, returns once every call finished. Safe to nest.
+  void ParallelFor(uint32_t count,
+                   const std::function<void(uint32_t)> &function);
+
+  uint32_t GetThreadCount() const { return (uint32_t)m_Workers.size(); }
+
+  // Engine wide pool, created on first use.
+  static ThreadPool &Get();
+
+private:
+  void Enqueue(std::function<void()> job);
+  void WorkerLoop();
+
+  std::vector<std::thread> m_Workers;
+  std::deque<std::function<void()>> m_Jobs;
+  std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  bool m_Stopping = false;
+};
+} // namespace MyEngine
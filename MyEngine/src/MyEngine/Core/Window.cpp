@@ -2,6 +2,7 @@
 
 #include "MyEngine/Core/Window.h"
 #include "MyEngine/Renderer/RendererAPI.h"
+#include "Platform/Null/NullWindow.h"
 #include "Platform/SDL/SDLWindow.h"
 
 namespace MyEngine {
@@ -10,6 +11,15 @@ Unique<Window> Window::Create(const WindowProperties &properties) {
   case RendererAPI::API::Vulkan:
     return CreateUnique<SDLWindow>(properties);
     break;
+  case RendererAPI::API::Null:
+    return CreateUnique<NullWindow>(properties);
+    break;
+  case RendererAPI::API::Software:
+    if (properties.Headless) {
+      return CreateUnique<NullWindow>(properties);
+    }
+    return CreateUnique<SDLWindow>(properties);
+    break;
   default:
     ME_CORE_ASSERT(false, "Unknown platform!");
     return nullptr;
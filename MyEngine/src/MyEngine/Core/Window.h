@@ -9,6 +9,10 @@ struct WindowProperties {
   std::string Title;
   uint32_t Width;
   uint32_t Height;
+  // Renders offscreen on backends that support it
+  bool Headless = false;
+  // Without it frames are presented as soon as they are done, when supported
+  bool VSync = true;
 
   WindowProperties(const std::string &title = "My Engine",
                    uint32_t width = 1600, uint32_t height = 900)
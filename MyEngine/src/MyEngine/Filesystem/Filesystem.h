@@ -122,6 +122,32 @@ static FsReadStatus ReadSpvFile(const std::string &path,
   return READ_SUCCESS;
 }
 
+static FsReadStatus ReadBinaryFile(const std::string &path,
+                                   std::vector<uint8_t> *pContents) {
+  std::filesystem::path filePath{path};
+  filePath = MakeAbsolutePath(filePath);
+  if (!std::filesystem::is_regular_file(filePath)) {
+    pContents->clear();
+    return ERR_NOT_REGULAR_FILE;
+  }
+
+  std::ifstream in(filePath, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    pContents->clear();
+    return ERR_NOT_OPEN;
+  }
+
+  in.seekg(0, std::ios::end);
+  auto size = in.tellg();
+  in.seekg(0, std::ios::beg);
+
+  pContents->resize(size);
+  in.read((char *)pContents->data(), size);
+  in.close();
+
+  return READ_SUCCESS;
+}
+
 static bool Exists(const std::string &path) {
   return std::filesystem::exists(path);
 }
@@ -148,6 +174,27 @@ static FsWriteStatus WriteSpvFile(const std::string &path,
   return WRITE_SUCCESS;
 }
 
+static FsWriteStatus WriteBinaryFile(const std::string &path, const void *data,
+                                     size_t size) {
+  std::filesystem::path filepath{path};
+  filepath = MakeAbsolutePath(filepath);
+
+  if (!Filesystem::Exists(filepath.parent_path())) {
+    std::filesystem::create_directories(filepath.parent_path());
+  }
+
+  std::ofstream out(filepath, std::ios::out | std::ios::binary);
+  if (!out.is_open()) {
+    return ERR_WRITE_STATUS_UNREACHABLE_FILE;
+  }
+
+  out.write((const char *)data, size);
+  out.flush();
+  out.close();
+
+  return WRITE_SUCCESS;
+}
+
 static std::string GetCacheDirectory() {
   std::string path =
       MakeAbsolutePath(GetWorkingDirectory()).string() + "/assets/cache";
@@ -0,0 +1,36 @@
+#include "mepch.h"
+
+#include "MyEngine/Filesystem/Filesystem.h"
+#include "MyEngine/Filesystem/MappedFile.h"
+
+namespace MyEngine {
+#ifndef ME_PLATFORM_LINUX
+// Fallback for platforms without a native mapping, reads the whole file
+struct MappedFile::MappedFileData {
+  std::vector<uint8_t> Contents;
+};
+
+MappedFile::MappedFile() : m_Data(CreateUnique<MappedFileData>()) {}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string &filepath) {
+  Close();
+  if (Filesystem::ReadBinaryFile(filepath, &m_Data->Contents) !=
+          Filesystem::READ_SUCCESS ||
+      m_Data->Contents.empty()) {
+    return false;
+  }
+
+  m_Pointer = m_Data->Contents.data();
+  m_Size = m_Data->Contents.size();
+  return true;
+}
+
+void MappedFile::Close() {
+  m_Data->Contents = std::vector<uint8_t>();
+  m_Pointer = nullptr;
+  m_Size = 0;
+}
+#endif
+} // namespace MyEngine
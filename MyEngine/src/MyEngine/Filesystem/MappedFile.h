@@ -0,0 +1,29 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+namespace MyEngine {
+// Read only view of a whole file. Pages are mapped from the file and loaded by
+// the OS on first access, so reading from the view costs no copies.
+class MappedFile {
+public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool Open(const std::string &filepath);
+  void Close();
+
+  bool IsOpen() const { return m_Pointer != nullptr; }
+  const uint8_t *GetData() const { return m_Pointer; }
+  size_t GetSize() const { return m_Size; }
+
+private:
+  struct MappedFileData;
+  Unique<MappedFileData> m_Data;
+  const uint8_t *m_Pointer = nullptr;
+  size_t m_Size = 0;
+};
+} // namespace MyEngine
@@ -14,8 +14,12 @@
 #include <vulkan/vulkan_core.h>
 
 #include "MyEngine/Core/Application.h"
+#include "MyEngine/Core/InputRecording.h"
 #include "MyEngine/Events/Event.h"
+#include "MyEngine/Events/KeyEvent.h"
+#include "MyEngine/Events/MouseEvent.h"
 #include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanVertexArray.h"
 
 namespace MyEngine {
 static void check_vk_result(VkResult err) {
@@ -25,6 +29,44 @@ static void check_vk_result(VkResult err) {
   ME_CORE_ASSERT(false);
 }
 
+static int SDLButtonToImGui(MouseCode button) {
+  switch (button) {
+  case Mouse::ButtonLeft:
+    return ImGuiMouseButton_Left;
+  case Mouse::ButtonRight:
+    return ImGuiMouseButton_Right;
+  case Mouse::ButtonMiddle:
+    return ImGuiMouseButton_Middle;
+  default:
+    return button - 1;
+  }
+}
+
+// Replayed keys go through the SDL backend like live ones, as the SDL event
+// they were recorded from. Modifiers come from the replayed keys held down.
+static void ProcessReplayedKey(KeyCode key, bool pressed, bool repeat) {
+  static const std::pair<SDL_Keycode, Uint16> s_Modifiers[] = {
+      {SDLK_LCTRL, KMOD_LCTRL},   {SDLK_RCTRL, KMOD_RCTRL},
+      {SDLK_LSHIFT, KMOD_LSHIFT}, {SDLK_RSHIFT, KMOD_RSHIFT},
+      {SDLK_LALT, KMOD_LALT},     {SDLK_RALT, KMOD_RALT},
+      {SDLK_LGUI, KMOD_LGUI},     {SDLK_RGUI, KMOD_RGUI}};
+
+  SDL_Event event{};
+  event.type = pressed ? SDL_KEYDOWN : SDL_KEYUP;
+  event.key.windowID = SDL_GetWindowID(
+      (SDL_Window *)Application::Get().GetWindow().GetNativeWindow());
+  event.key.state = pressed ? SDL_PRESSED : SDL_RELEASED;
+  event.key.repeat = repeat;
+  event.key.keysym.sym = (SDL_Keycode)key;
+  event.key.keysym.scancode = SDL_GetScancodeFromKey((SDL_Keycode)key);
+  for (const auto &[modifierKey, modifier] : s_Modifiers) {
+    if (InputRecording::IsKeyPressed(modifierKey)) {
+      event.key.keysym.mod |= modifier;
+    }
+  }
+  ImGui_ImplSDL2_ProcessEvent(&event);
+}
+
 ImGuiLayer::ImGuiLayer() : Layer("ImGuiLayer") {}
 
 ImGuiLayer::~ImGuiLayer() {}
@@ -94,7 +136,15 @@ void ImGuiLayer::Begin() {
 
   ImGui_ImplVulkan_SetMinImageCount(context->MinImageCount);
   ImGui_ImplVulkan_NewFrame();
-  ImGui_ImplSDL2_NewFrame();
+  if (InputRecording::IsReplaying()) {
+    // The SDL backend would poll the real mouse and clock, replays only see
+    // the injected events and the replayed frame delta
+    ImGuiIO &io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(window.GetWidth(), window.GetHeight());
+    io.DeltaTime = m_DeltaTime > 0.0f ? m_DeltaTime : 1.0f / 60.0f;
+  } else {
+    ImGui_ImplSDL2_NewFrame();
+  }
   ImGui::NewFrame();
 }
 
@@ -112,6 +162,8 @@ void ImGuiLayer::End() {
   const bool isMinimized =
       (drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f);
   if (!isMinimized) {
+    // ImGui binds its own vertex and index buffers
+    VulkanVertexArray::InvalidateBinding();
     ImGui_ImplVulkan_RenderDrawData(
         drawData, context->Window.GetCurrentFrame()->CommandBuffer);
   }
@@ -122,15 +174,59 @@ void ImGuiLayer::End() {
   }
 }
 
+void ImGuiLayer::OnUpdate(Timestep ts) {
+  m_DeltaTime = ts.GetMilliseconds() / 1000.0f;
+}
+
 void ImGuiLayer::OnEvent(Event &event, void *pData) {
   ImGuiIO &io = ImGui::GetIO();
   event.Handled |= event.IsInCategory(EventCategoryMouse) & io.WantCaptureMouse;
   event.Handled |=
       event.IsInCategory(EventCategoryKeyboard) & io.WantCaptureKeyboard;
 
-  if (event.Handled) {
-    ImGui_ImplSDL2_ProcessEvent((SDL_Event *)pData);
+  if (pData != nullptr) {
+    if (event.Handled) {
+      ImGui_ImplSDL2_ProcessEvent((SDL_Event *)pData);
+    }
+    return;
   }
+
+  // Replayed events carry no SDL event. ImGui sees all of them, like it sees
+  // the live mouse through the SDL backend, or it would never know the mouse
+  // moved over one of its windows. Whether the layers below see them is left
+  // to WantCaptureMouse and WantCaptureKeyboard above.
+  EventDispatcher dispatcher(event);
+  dispatcher.Dispatch<MouseMovedEvent>([&io](MouseMovedEvent &e) {
+    io.AddMousePosEvent(e.GetX(), e.GetY());
+    return false;
+  });
+  dispatcher.Dispatch<MouseScrolledEvent>([&io](MouseScrolledEvent &e) {
+    io.AddMouseWheelEvent(e.GetX(), e.GetY());
+    return false;
+  });
+  dispatcher.Dispatch<MouseButtonPressedEvent>(
+      [&io](MouseButtonPressedEvent &e) {
+        io.AddMouseButtonEvent(SDLButtonToImGui(e.GetMouseButton()), true);
+        return false;
+      });
+  dispatcher.Dispatch<MouseButtonReleasedEvent>(
+      [&io](MouseButtonReleasedEvent &e) {
+        io.AddMouseButtonEvent(SDLButtonToImGui(e.GetMouseButton()), false);
+        return false;
+      });
+  dispatcher.Dispatch<KeyPressedEvent>([](KeyPressedEvent &e) {
+    ProcessReplayedKey(e.GetKeyCode(), true, e.IsRepeat());
+    return false;
+  });
+  dispatcher.Dispatch<KeyReleasedEvent>([](KeyReleasedEvent &e) {
+    ProcessReplayedKey(e.GetKeyCode(), false, false);
+    return false;
+  });
+  // Typed key codes are the characters themselves
+  dispatcher.Dispatch<KeyTypedEvent>([&io](KeyTypedEvent &e) {
+    io.AddInputCharacter((unsigned int)e.GetKeyCode());
+    return false;
+  });
 }
 
 } // namespace MyEngine
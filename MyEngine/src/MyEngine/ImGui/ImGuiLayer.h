@@ -11,6 +11,7 @@ public:
 
   virtual void OnAttach() override;
   virtual void OnDetach() override;
+  virtual void OnUpdate(Timestep ts) override;
   virtual void OnEvent(Event &event, void *pData) override;
 
   void Begin();
@@ -18,5 +19,7 @@ public:
 
 private:
   float m_Time = 0.0f;
+  // Seconds, only used while input is replayed
+  float m_DeltaTime = 0.0f;
 };
 } // namespace MyEngine
@@ -2,46 +2,180 @@
 
 #include "MyEngine/Renderer/Buffer.h"
 
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/Renderer.h"
+#include "Platform/Null/NullBuffer.h"
+#include "Platform/Software/SoftwareBuffer.h"
 #include "Platform/Vulkan/VulkanBuffer.h"
 
 namespace MyEngine {
 Ref<VertexBuffer> VertexBuffer::Create(uint32_t size) {
+  Ref<VertexBuffer> buffer;
   switch (Renderer::GetAPI()) {
   case RendererAPI::API::Vulkan: {
-    return CreateRef<VulkanVertexBuffer>(size);
-  }
+    buffer = CreateRef<VulkanVertexBuffer>(size);
+  } break;
+  case RendererAPI::API::Null: {
+    buffer = CreateRef<NullVertexBuffer>(size);
+  } break;
+  case RendererAPI::API::Software: {
+    buffer = CreateRef<SoftwareVertexBuffer>(size);
+  } break;
 
   default: {
     ME_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
   }
   }
+
+  RenderCapture::OnCreateVertexBuffer(buffer.get(), nullptr, size, 0);
+  return buffer;
 }
 
 Ref<VertexBuffer> VertexBuffer::Create(Vertex *vertices, uint32_t size) {
+  Ref<VertexBuffer> buffer;
   switch (Renderer::GetAPI()) {
   case RendererAPI::API::Vulkan: {
-    return CreateRef<VulkanVertexBuffer>(vertices, size);
+    buffer = CreateRef<VulkanVertexBuffer>(vertices, size);
+  } break;
+  case RendererAPI::API::Null: {
+    buffer = CreateRef<NullVertexBuffer>(vertices, size);
+  } break;
+  case RendererAPI::API::Software: {
+    buffer = CreateRef<SoftwareVertexBuffer>(vertices, size);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
   }
 
+  RenderCapture::OnCreateVertexBuffer(buffer.get(), vertices, size,
+                                      sizeof(Vertex) * size);
+  return buffer;
+}
+
+Ref<VertexBuffer> VertexBuffer::Create(const void *data, uint32_t size,
+                                       const BufferLayout &layout) {
+  Ref<VertexBuffer> buffer;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    buffer = CreateRef<VulkanVertexBuffer>(data, size);
+  } break;
+  case RendererAPI::API::Null: {
+    buffer = CreateRef<NullVertexBuffer>(data, size);
+  } break;
+  case RendererAPI::API::Software: {
+    buffer = CreateRef<SoftwareVertexBuffer>(data, size);
+  } break;
+
   default: {
     ME_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
   }
   }
+
+  buffer->SetLayout(layout);
+  // A count of 0 marks the size as bytes
+  RenderCapture::OnCreateVertexBuffer(buffer.get(), data, 0, size);
+  return buffer;
+}
+
+void VertexBuffer::SetData(const void *pData, uint32_t offset,
+                           uint32_t size) {
+  RenderCapture::OnVertexBufferData(this, pData, offset, size);
+  WriteData(pData, offset, size);
+}
+
+void *VertexBuffer::MapRange(uint32_t offset, uint32_t size) {
+  ME_CORE_ASSERT(!m_IsMapped, "Vertex buffer is already mapped!");
+  ME_CORE_ASSERT((uint64_t)offset + size <= GetSize(),
+                 "Mapped range is larger than the buffer!");
+  m_IsMapped = true;
+  m_Mapped = MapData(offset, size);
+  m_MappedOffset = offset;
+  m_MappedSize = size;
+  return m_Mapped;
+}
+
+void VertexBuffer::Unmap() {
+  ME_CORE_ASSERT(m_IsMapped, "Vertex buffer isn't mapped!");
+  RenderCapture::OnVertexBufferData(this, m_Mapped, m_MappedOffset,
+                                    m_MappedSize);
+  UnmapData(m_MappedOffset, m_MappedSize);
+  m_IsMapped = false;
 }
 
 Ref<IndexBuffer> IndexBuffer::Create(uint32_t *indices, uint32_t count) {
+  Ref<IndexBuffer> buffer;
   switch (Renderer::GetAPI()) {
   case RendererAPI::API::Vulkan: {
-    return CreateRef<VulkanIndexBuffer>(indices, count);
+    buffer = CreateRef<VulkanIndexBuffer>(indices, count);
+  } break;
+  case RendererAPI::API::Null: {
+    buffer = CreateRef<NullIndexBuffer>(indices, count);
+  } break;
+  case RendererAPI::API::Software: {
+    buffer = CreateRef<SoftwareIndexBuffer>(indices, count);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
   }
+  }
+
+  RenderCapture::OnCreateIndexBuffer(buffer.get(), indices, count,
+                                     IndexFormat::UInt32);
+  return buffer;
+}
+
+Ref<IndexBuffer> IndexBuffer::Create(uint32_t count, IndexFormat format) {
+  Ref<IndexBuffer> buffer;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    buffer = CreateRef<VulkanIndexBuffer>(count, format);
+  } break;
+  case RendererAPI::API::Null: {
+    buffer = CreateRef<NullIndexBuffer>(count, format);
+  } break;
+  case RendererAPI::API::Software: {
+    buffer = CreateRef<SoftwareIndexBuffer>(count, format);
+  } break;
 
   default: {
     ME_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
   }
   }
+
+  RenderCapture::OnCreateIndexBuffer(buffer.get(), nullptr, count, format);
+  return buffer;
+}
+
+void IndexBuffer::SetData(const uint32_t *indices, uint32_t offset,
+                          uint32_t count) {
+  RenderCapture::OnIndexBufferData(this, indices, offset, count);
+  WriteData(indices, offset, count);
+}
+
+Span<uint32_t> IndexBuffer::Map(uint32_t offset, uint32_t count) {
+  ME_CORE_ASSERT(!m_IsMapped, "Index buffer is already mapped!");
+  ME_CORE_ASSERT((uint64_t)offset + count <= GetCount(),
+                 "Mapped range is larger than the buffer!");
+  m_IsMapped = true;
+  m_Mapped = MapData(offset, count);
+  m_MappedOffset = offset;
+  m_MappedCount = count;
+  return Span<uint32_t>(m_Mapped, count);
+}
+
+void IndexBuffer::Unmap() {
+  ME_CORE_ASSERT(m_IsMapped, "Index buffer isn't mapped!");
+  RenderCapture::OnIndexBufferData(this, m_Mapped, m_MappedOffset,
+                                   m_MappedCount);
+  UnmapData(m_MappedOffset, m_MappedCount);
+  m_IsMapped = false;
 }
 } // namespace MyEngine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MyEngine/Core/Base.h"
+#include "MyEngine/Core/Span.h"
 #include "MyEngine/Renderer/Vertex.h"
 
 namespace MyEngine {
@@ -20,10 +21,20 @@ enum class ShaderDataType {
   Int3,
   Int4,
 
-  Bool
+  Bool,
+
+  // Compact vertex attributes. Integer types are read as floats in [0, 1]
+  // (unsigned) or [-1, 1] (signed) when the element is normalized, as integers
+  // otherwise.
+  UByte4,
+  Byte4,
+  Short2,
+  Short4,
+  Half2,
+  Half4
 };
 
-static uint32_t ShaderDataTypeSize(ShaderDataType type) {
+static constexpr uint32_t ShaderDataTypeSize(ShaderDataType type) {
   switch (type) {
   case ShaderDataType::Float:
     return 4;
@@ -47,6 +58,15 @@ static uint32_t ShaderDataTypeSize(ShaderDataType type) {
     return 4 * 4;
   case ShaderDataType::Bool:
     return 1;
+  case ShaderDataType::UByte4:
+  case ShaderDataType::Byte4:
+    return 4;
+  case ShaderDataType::Short2:
+  case ShaderDataType::Half2:
+    return 2 * 2;
+  case ShaderDataType::Short4:
+  case ShaderDataType::Half4:
+    return 2 * 4;
   default: {
     ME_CORE_ASSERT(false, "Unknown ShaderDataType!");
     return 0;
@@ -97,6 +117,14 @@ struct BufferElement {
       return 4;
     case ShaderDataType::Bool:
       return 1;
+    case ShaderDataType::Short2:
+    case ShaderDataType::Half2:
+      return 2;
+    case ShaderDataType::UByte4:
+    case ShaderDataType::Byte4:
+    case ShaderDataType::Short4:
+    case ShaderDataType::Half4:
+      return 4;
     default: {
       ME_CORE_ASSERT(false, "Unknown ShaderDataType!");
       return 0;
@@ -114,6 +142,11 @@ public:
     CalculateOffsetAndStride();
   }
 
+  BufferLayout(const std::vector<BufferElement> &elements)
+      : m_Elements(elements) {
+    CalculateOffsetAndStride();
+  }
+
   uint32_t GetStride() const { return m_Stride; }
   const std::vector<BufferElement> &GetElements() const { return m_Elements; }
 
@@ -147,15 +180,56 @@ public:
   virtual void Bind() const = 0;
   virtual void Unbind() const = 0;
 
-  virtual void SetData(const Vertex *pData, uint32_t size) = 0;
+  // Replaces size bytes from offset on. GPU backends only upload the bytes
+  // that differ from the previous SetData where both overlap, ahead of the
+  // draws of the frame being recorded.
+  void SetData(const void *pData, uint32_t offset, uint32_t size);
+  void SetData(const Vertex *pData, uint32_t size) {
+    SetData(pData, 0, sizeof(Vertex) * size);
+  }
+  // Count elements from offset on, in bytes, to be written in place instead
+  // of filling an array for SetData. The whole range is uploaded, it has to
+  // be written and unmapped before the frame's draws. Mapped memory may be
+  // write combined, don't read it.
+  template <typename T> Span<T> Map(uint32_t offset, uint32_t count) {
+    return Span<T>(
+        static_cast<T *>(MapRange(offset, (uint32_t)sizeof(T) * count)),
+        count);
+  }
+  void Unmap();
 
   virtual const BufferLayout &GetLayout() const = 0;
   virtual void SetLayout(const BufferLayout &layout) = 0;
+  // In bytes
+  virtual uint32_t GetSize() const = 0;
 
   static Ref<VertexBuffer> Create(uint32_t size);
   static Ref<VertexBuffer> Create(Vertex *vertices, uint32_t size);
+  // Vertices in any format, size is in bytes and layout describes them. Without
+  // data the buffer is filled through SetData.
+  static Ref<VertexBuffer> Create(const void *data, uint32_t size,
+                                  const BufferLayout &layout);
+
+protected:
+  // Backend part of SetData, called once the render capture saw the data
+  virtual void WriteData(const void *pData, uint32_t offset,
+                         uint32_t size) = 0;
+  // Backend part of Map and Unmap
+  virtual void *MapData(uint32_t offset, uint32_t size) = 0;
+  virtual void UnmapData(uint32_t offset, uint32_t size) {}
+
+private:
+  void *MapRange(uint32_t offset, uint32_t size);
+
+  bool m_IsMapped = false;
+  void *m_Mapped = nullptr;
+  uint32_t m_MappedOffset = 0;
+  uint32_t m_MappedSize = 0;
 };
 
+// Width of the indices an index buffer stores on the GPU
+enum class IndexFormat : uint8_t { UInt16, UInt32 };
+
 class IndexBuffer {
 public:
   virtual ~IndexBuffer() = default;
@@ -165,6 +239,43 @@ public:
 
   virtual uint32_t GetCount() const = 0;
 
+  // Replaces count indices from offset on, both counted in indices. Like
+  // VertexBuffer::SetData only the changed indices are uploaded. Buffers
+  // stored as 16 bit can't take indices that don't fit.
+  void SetData(const uint32_t *indices, uint32_t offset, uint32_t count);
+  // Like VertexBuffer::Map, counted in indices
+  Span<uint32_t> Map(uint32_t offset, uint32_t count);
+  void Unmap();
+
+  // GPU backends store the indices as 16 bit when they all fit
   static Ref<IndexBuffer> Create(uint32_t *indices, uint32_t count);
+  // Filled through SetData, for buffers shared by many meshes. SetData can
+  // only write indices that fit the format.
+  static Ref<IndexBuffer> Create(uint32_t count,
+                                 IndexFormat format = IndexFormat::UInt32);
+
+  // 0xFFFF is left out, it restarts primitives in 16 bit index buffers
+  static bool Fits16Bit(const uint32_t *indices, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+      if (indices[i] >= 0xFFFF) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+protected:
+  // Backend part of SetData, called once the render capture saw the indices
+  virtual void WriteData(const uint32_t *indices, uint32_t offset,
+                         uint32_t count) = 0;
+  // Backend part of Map and Unmap
+  virtual uint32_t *MapData(uint32_t offset, uint32_t count) = 0;
+  virtual void UnmapData(uint32_t offset, uint32_t count) {}
+
+private:
+  bool m_IsMapped = false;
+  uint32_t *m_Mapped = nullptr;
+  uint32_t m_MappedOffset = 0;
+  uint32_t m_MappedCount = 0;
 };
 } // namespace MyEngine
@@ -6,6 +6,7 @@
 
 #include <SDL_keycode.h>
 #include <SDL_mouse.h>
+#include <glm/gtc/matrix_clip_space.hpp>
 #include <glm/gtx/quaternion.hpp>
 
 namespace MyEngine {
@@ -13,13 +14,17 @@ EditorCamera::EditorCamera(float fov, float aspectRatio, float nearClip,
                            float farClip)
     : m_FOV(fov), m_AspectRatio(aspectRatio), m_NearClip(nearClip),
       m_FarClip(farClip) {
+  UpdateProjection();
   UpdateView();
 }
 
 void EditorCamera::UpdateProjection() {
   m_AspectRatio = m_ViewportWidth / m_ViewportHeight;
-  m_Projection = glm::perspective(glm::radians(m_FOV), m_AspectRatio,
-                                  m_NearClip, m_FarClip);
+  // The renderer uses the vulkan clip space, depth goes from 0 to 1 and y
+  // points down
+  m_Projection = glm::perspectiveRH_ZO(glm::radians(m_FOV), m_AspectRatio,
+                                       m_NearClip, m_FarClip);
+  m_Projection[1][1] *= -1.0f;
 }
 
 void EditorCamera::UpdateView() {
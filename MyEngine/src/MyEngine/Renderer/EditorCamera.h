@@ -15,11 +15,15 @@ public:
   void OnEvent(Event &e);
 
   inline float GetDistance() const { return m_Distance; }
-  inline void SetDistance(float distance) { m_Distance = distance; }
+  inline void SetDistance(float distance) {
+    m_Distance = distance;
+    UpdateView();
+  }
 
   inline void SetViewportSize(float width, float height) {
     m_ViewportWidth = width;
     m_ViewportHeight = height;
+    UpdateProjection();
   }
 
   const Matrix4 &GetViewMatrix() const { return m_ViewMatrix; }
@@ -0,0 +1,184 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/GeometryPool.h"
+#include "MyEngine/Renderer/Mesh.h"
+#include "MyEngine/Renderer/RangeAllocator.h"
+
+namespace MyEngine {
+// 6MB of vertices and 8MB of indices, larger meshes get a page of their own
+static constexpr uint32_t s_PageVertices = 1 << 19;
+static constexpr uint32_t s_PageIndices = 1 << 21;
+
+// Released pages keep their slot with null buffers, so the page index of
+// every allocation stays valid
+struct GeometryPage {
+  Ref<VertexBuffer> Positions;
+  Ref<VertexBuffer> Colors;
+  Ref<IndexBuffer> Indices;
+  IndexFormat Format = IndexFormat::UInt32;
+  Ref<VertexArray> Array;
+  Ref<VertexArray> PositionArray;
+  RangeAllocator FreeVertices;
+  RangeAllocator FreeIndices;
+};
+
+struct GeometryPoolData {
+  std::vector<GeometryPage> Pages;
+  // Freed during the frame being recorded
+  std::vector<GeometryAllocation> Released;
+};
+
+static Unique<GeometryPoolData> s_Data;
+
+static GeometryPage CreatePage(uint32_t vertexCount, uint32_t indexCount,
+                               IndexFormat format) {
+  GeometryPage page;
+  page.Positions = VertexBuffer::Create(
+      nullptr, MeshPositionLayout::Stride * vertexCount,
+      MeshPositionLayout::Get());
+  page.Colors = VertexBuffer::Create(
+      nullptr, MeshColorLayout::Stride * vertexCount, MeshColorLayout::Get());
+  page.Indices = IndexBuffer::Create(indexCount, format);
+  page.Format = format;
+
+  page.Array = VertexArray::Create();
+  page.Array->AddVertexBuffer(page.Positions);
+  page.Array->AddVertexBuffer(page.Colors);
+  page.Array->SetIndexBuffer(page.Indices);
+
+  page.PositionArray = VertexArray::Create();
+  page.PositionArray->AddVertexBuffer(page.Positions);
+  page.PositionArray->SetIndexBuffer(page.Indices);
+
+  page.FreeVertices = RangeAllocator(vertexCount);
+  page.FreeIndices = RangeAllocator(indexCount);
+  return page;
+}
+
+void GeometryPool::Init() { s_Data = CreateUnique<GeometryPoolData>(); }
+
+void GeometryPool::Shutdown() { s_Data.reset(); }
+
+GeometryAllocation GeometryPool::Allocate(const MeshPosition *positions,
+                                          const uint32_t *colors,
+                                          uint32_t vertexCount,
+                                          const uint32_t *indices,
+                                          uint32_t indexCount) {
+  ME_CORE_ASSERT(s_Data, "Geometry can't be allocated before the renderer!");
+
+  GeometryAllocation allocation;
+  allocation.VertexCount = vertexCount;
+  allocation.IndexCount = indexCount;
+
+  // Indices are relative to the mesh, most meshes fit 16 bit pages
+  const IndexFormat format = IndexBuffer::Fits16Bit(indices, indexCount)
+                                 ? IndexFormat::UInt16
+                                 : IndexFormat::UInt32;
+
+  // Both ranges have to come from the same page. The fullest page that fits
+  // is filled first, so the others can empty out and be released.
+  const uint32_t pageCount = (uint32_t)s_Data->Pages.size();
+  uint32_t page = pageCount;
+  uint32_t released = pageCount;
+  for (uint32_t i = 0; i < pageCount; i++) {
+    const GeometryPage &candidate = s_Data->Pages[i];
+    if (!candidate.Array) {
+      released = std::min(released, i);
+      continue;
+    }
+    const bool fits =
+        candidate.Format == format &&
+        candidate.FreeVertices.GetLargestFreeRange() >= vertexCount &&
+        candidate.FreeIndices.GetLargestFreeRange() >= indexCount;
+    if (fits && (page == pageCount ||
+                 candidate.FreeVertices.GetFreeSize() <
+                     s_Data->Pages[page].FreeVertices.GetFreeSize())) {
+      page = i;
+    }
+  }
+
+  if (page == pageCount) {
+    page = released;
+    if (page == pageCount) {
+      s_Data->Pages.emplace_back();
+    }
+    s_Data->Pages[page] = CreatePage(std::max(vertexCount, s_PageVertices),
+                                     std::max(indexCount, s_PageIndices),
+                                     format);
+    ME_CORE_INFO("Created geometry page {0} for {1} vertices and {2} {3} bit "
+                 "indices",
+                 page, s_Data->Pages[page].FreeVertices.GetCapacity(),
+                 s_Data->Pages[page].FreeIndices.GetCapacity(),
+                 format == IndexFormat::UInt16 ? 16 : 32);
+  }
+  allocation.Page = page;
+
+  GeometryPage &target = s_Data->Pages[page];
+  allocation.FirstVertex = target.FreeVertices.Allocate(vertexCount);
+  allocation.FirstIndex = target.FreeIndices.Allocate(indexCount);
+
+  // Fresh ranges have nothing to diff against, the geometry is copied
+  // straight into the mapped ranges
+  Span<MeshPosition> mappedPositions = target.Positions->Map<MeshPosition>(
+      MeshPositionLayout::Stride * allocation.FirstVertex, vertexCount);
+  std::copy(positions, positions + vertexCount, mappedPositions.begin());
+  target.Positions->Unmap();
+  Span<uint32_t> mappedColors = target.Colors->Map<uint32_t>(
+      MeshColorLayout::Stride * allocation.FirstVertex, vertexCount);
+  std::copy(colors, colors + vertexCount, mappedColors.begin());
+  target.Colors->Unmap();
+  Span<uint32_t> mappedIndices =
+      target.Indices->Map(allocation.FirstIndex, indexCount);
+  std::copy(indices, indices + indexCount, mappedIndices.begin());
+  target.Indices->Unmap();
+  return allocation;
+}
+
+void GeometryPool::Free(const GeometryAllocation &allocation) {
+  // Meshes may outlive the renderer, their pages are already gone then
+  if (!s_Data || allocation.Page >= s_Data->Pages.size()) {
+    return;
+  }
+
+  s_Data->Released.push_back(allocation);
+}
+
+void GeometryPool::EndFrame() {
+  if (!s_Data) {
+    return;
+  }
+
+  // Data set from now on is copied ahead of the next frame's draws
+  for (const GeometryAllocation &allocation : s_Data->Released) {
+    GeometryPage &page = s_Data->Pages[allocation.Page];
+    page.FreeVertices.Free(allocation.FirstVertex, allocation.VertexCount);
+    page.FreeIndices.Free(allocation.FirstIndex, allocation.IndexCount);
+
+    // The last page of each format stays, so loading and unloading a single
+    // mesh doesn't create and destroy buffers over and over. The buffers of
+    // the frames in flight are kept alive by the backends.
+    if (page.FreeVertices.GetFreeSize() == page.FreeVertices.GetCapacity() &&
+        page.FreeIndices.GetFreeSize() == page.FreeIndices.GetCapacity() &&
+        std::count_if(s_Data->Pages.begin(), s_Data->Pages.end(),
+                      [&page](const GeometryPage &other) {
+                        return other.Array && other.Format == page.Format;
+                      }) > 1) {
+      ME_CORE_INFO("Released empty geometry page {0}", allocation.Page);
+      page = GeometryPage();
+    }
+  }
+  s_Data->Released.clear();
+}
+
+const Ref<VertexArray> &GeometryPool::GetVertexArray(uint32_t page) {
+  return s_Data->Pages[page].Array;
+}
+
+const Ref<VertexArray> &GeometryPool::GetPositionArray(uint32_t page) {
+  return s_Data->Pages[page].PositionArray;
+}
+
+uint32_t GeometryPool::GetPageCount() {
+  return s_Data ? (uint32_t)s_Data->Pages.size() : 0;
+}
+} // namespace MyEngine
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Renderer/VertexArray.h"
+
+namespace MyEngine {
+struct MeshPosition;
+
+// Where a mesh lives in the pool. Its indices stay relative to the mesh, the
+// draw adds FirstVertex to them as the vertex offset.
+struct GeometryAllocation {
+  uint32_t Page = 0;
+  uint32_t FirstVertex = 0;
+  uint32_t VertexCount = 0;
+  uint32_t FirstIndex = 0;
+  uint32_t IndexCount = 0;
+
+  DrawRange GetDrawRange() const {
+    return {FirstIndex, IndexCount, (int32_t)FirstVertex};
+  }
+};
+
+// Vertex and index buffers shared by all meshes, so drawing many meshes binds
+// the same buffers over and over and only the draw range changes. Meshes are
+// sub-allocated out of large pages, each with a position stream and a color
+// stream in the formats of Mesh. Pages hold 16 or 32 bit indices, meshes whose
+// indices fit go to 16 bit pages. Freed ranges are merged with their free
+// neighbours and reused. New geometry goes into the fullest page with room, a
+// page is created when none has room and released once everything in it was
+// freed. Allocations never move, live geometry is not compacted.
+class GeometryPool {
+public:
+  static void Init();
+  static void Shutdown();
+
+  // Copies the geometry into the fullest page of its index width. Like
+  // VertexBuffer::SetData the data reaches the GPU before the frame's draws.
+  static GeometryAllocation Allocate(const MeshPosition *positions,
+                                     const uint32_t *colors,
+                                     uint32_t vertexCount,
+                                     const uint32_t *indices,
+                                     uint32_t indexCount);
+  // Draws of the frame being recorded may still use the ranges, they are
+  // reused once the frame ended
+  static void Free(const GeometryAllocation &allocation);
+  static void EndFrame();
+
+  static const Ref<VertexArray> &GetVertexArray(uint32_t page);
+  // Same indices with only the a_position stream
+  static const Ref<VertexArray> &GetPositionArray(uint32_t page);
+  // Released pages count as well, their vertex arrays are null
+  static uint32_t GetPageCount();
+};
+} // namespace MyEngine
@@ -0,0 +1,95 @@
+#include "MyEngine/Renderer/GeometryPool.h"
+#include "MyEngine/Renderer/Mesh.h"
+#include "MyEngine/Renderer/Renderer.h"
+
+#include <gtest/gtest.h>
+
+namespace MyEngine {
+// Vertices of a page, anything larger gets a page of its own
+static constexpr uint32_t s_PageVertices = 1 << 19;
+
+class GeometryPoolTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RendererAPI::SetAPI(RendererAPI::API::Null);
+    Renderer::Init();
+  }
+
+  void TearDown() override {
+    Renderer::Shutdown();
+    RendererAPI::SetAPI(RendererAPI::API::Vulkan);
+  }
+
+  // Geometry is left zeroed, only its last index is set
+  static GeometryAllocation Allocate(uint32_t vertexCount,
+                                     uint32_t lastIndex = 0) {
+    std::vector<MeshPosition> positions(vertexCount);
+    std::vector<uint32_t> colors(vertexCount);
+    std::vector<uint32_t> indices(3);
+    indices.back() = lastIndex;
+    return GeometryPool::Allocate(positions.data(), colors.data(),
+                                  vertexCount, indices.data(),
+                                  (uint32_t)indices.size());
+  }
+};
+
+TEST_F(GeometryPoolTest, SharesOnePage) {
+  const GeometryAllocation a = Allocate(10);
+  const GeometryAllocation b = Allocate(20);
+  EXPECT_EQ(GeometryPool::GetPageCount(), 1);
+  EXPECT_EQ(a.Page, b.Page);
+  EXPECT_EQ(a.FirstVertex, 0);
+  EXPECT_EQ(b.FirstVertex, 10);
+  EXPECT_EQ(b.FirstIndex, 3);
+  EXPECT_EQ(b.GetDrawRange().VertexOffset, 10);
+}
+
+TEST_F(GeometryPoolTest, MergesFreedRangesAtTheEndOfTheFrame) {
+  const GeometryAllocation a = Allocate(10);
+  const GeometryAllocation b = Allocate(10);
+  Allocate(10);
+  GeometryPool::Free(a);
+  GeometryPool::Free(b);
+
+  // Draws of this frame may still use them
+  EXPECT_EQ(Allocate(20).FirstVertex, 30);
+
+  GeometryPool::EndFrame();
+  const GeometryAllocation merged = Allocate(20);
+  EXPECT_EQ(merged.FirstVertex, 0);
+  EXPECT_EQ(merged.FirstIndex, 0);
+}
+
+TEST_F(GeometryPoolTest, SeparatesIndexWidths) {
+  // 0xFFFF restarts primitives, it needs 32 bit indices
+  const GeometryAllocation narrow = Allocate(10, 9);
+  const GeometryAllocation wide = Allocate(0x10000, 0xFFFF);
+  EXPECT_NE(narrow.Page, wide.Page);
+  EXPECT_EQ(GeometryPool::GetPageCount(), 2);
+  EXPECT_EQ(Allocate(10, 9).Page, narrow.Page);
+  EXPECT_EQ(Allocate(10, 0x10000).Page, wide.Page);
+}
+
+TEST_F(GeometryPoolTest, ReleasesEmptyPages) {
+  const GeometryAllocation small = Allocate(10);
+  const GeometryAllocation large = Allocate(s_PageVertices + 1);
+  ASSERT_NE(small.Page, large.Page);
+  ASSERT_EQ(GeometryPool::GetPageCount(), 2);
+
+  // Released pages keep their slot
+  GeometryPool::Free(large);
+  GeometryPool::EndFrame();
+  EXPECT_EQ(GeometryPool::GetPageCount(), 2);
+  EXPECT_FALSE(GeometryPool::GetVertexArray(large.Page));
+  EXPECT_TRUE(GeometryPool::GetPositionArray(small.Page));
+
+  // The last page of a format stays even when it is empty
+  GeometryPool::Free(small);
+  GeometryPool::EndFrame();
+  EXPECT_TRUE(GeometryPool::GetVertexArray(small.Page));
+
+  // The released slot is reused
+  EXPECT_EQ(Allocate(s_PageVertices + 1).Page, large.Page);
+  EXPECT_EQ(GeometryPool::GetPageCount(), 2);
+}
+} // namespace MyEngine
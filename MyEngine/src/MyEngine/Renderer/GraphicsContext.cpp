@@ -1,10 +1,16 @@
 #include "mepch.h"
 
 #include "MyEngine/Renderer/GraphicsContext.h"
+#include "MyEngine/Renderer/RendererAPI.h"
 #include "Platform/Vulkan/VulkanContext.h"
 
 namespace MyEngine {
 Unique<GraphicsContext> GraphicsContext::Create() {
+  // The other backends present without a graphics context
+  if (RendererAPI::GetAPI() != RendererAPI::API::Vulkan) {
+    return nullptr;
+  }
+
 #ifdef ME_PLATFORM_WINDOWS
   return CreateUnique<VulkanContext>();
 #elif defined(ME_PLATFORM_LINUX)
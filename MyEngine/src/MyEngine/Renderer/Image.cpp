@@ -0,0 +1,384 @@
+#include "mepch.h"
+
+#include "MyEngine/Filesystem/Filesystem.h"
+#include "MyEngine/Renderer/Image.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#ifdef ME_HAS_BASISU
+#include <transcoder/basisu_transcoder.h>
+#include <zstd/zstd.h>
+#endif
+
+#include <cstring>
+
+namespace MyEngine {
+bool ImageDecoder::Decode(const std::string &filepath, ImageData *pImage) {
+  // Which format KTX2 data ends up in depends on the GPU
+  if (IsKTX2(filepath)) {
+    ME_CORE_ERROR("Unable to decode {0}, KTX2 files are read through "
+                  "DecodeKTX2 with the formats the GPU samples",
+                  filepath);
+    return false;
+  }
+
+  int width, height, channels;
+  stbi_uc *pixels =
+      stbi_load(filepath.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+  if (pixels == nullptr) {
+    ME_CORE_ERROR("Unable to decode image {0}: {1}", filepath,
+                  stbi_failure_reason());
+    return false;
+  }
+
+  pImage->Width = (uint32_t)width;
+  pImage->Height = (uint32_t)height;
+  pImage->Pixels.assign(pixels, pixels + (size_t)width * height * 4);
+  stbi_image_free(pixels);
+  return true;
+}
+
+std::vector<ImageData> ImageDecoder::GenerateMips(ImageData &&image) {
+  ME_CORE_ASSERT(TextureFormatBlockSize(image.Format) == 0,
+                 "Mips of compressed images can't be generated!");
+  std::vector<ImageData> mips;
+  mips.push_back(std::move(image));
+  while (mips.back().Width > 1 || mips.back().Height > 1) {
+    const ImageData &src = mips.back();
+    ImageData dst;
+    dst.Width = std::max(src.Width / 2, 1u);
+    dst.Height = std::max(src.Height / 2, 1u);
+    dst.Format = src.Format;
+    dst.Pixels.resize((size_t)dst.Width * dst.Height * 4);
+
+    // Odd sizes clamp the second sample to the last row or column
+    for (uint32_t y = 0; y < dst.Height; y++) {
+      const uint32_t y0 = std::min(y * 2, src.Height - 1);
+      const uint32_t y1 = std::min(y * 2 + 1, src.Height - 1);
+      for (uint32_t x = 0; x < dst.Width; x++) {
+        const uint32_t x0 = std::min(x * 2, src.Width - 1);
+        const uint32_t x1 = std::min(x * 2 + 1, src.Width - 1);
+        const uint8_t *p00 = &src.Pixels[((size_t)y0 * src.Width + x0) * 4];
+        const uint8_t *p01 = &src.Pixels[((size_t)y0 * src.Width + x1) * 4];
+        const uint8_t *p10 = &src.Pixels[((size_t)y1 * src.Width + x0) * 4];
+        const uint8_t *p11 = &src.Pixels[((size_t)y1 * src.Width + x1) * 4];
+        uint8_t *out = &dst.Pixels[((size_t)y * dst.Width + x) * 4];
+        for (uint32_t c = 0; c < 4; c++) {
+          out[c] = (uint8_t)((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+        }
+      }
+    }
+    mips.push_back(std::move(dst));
+  }
+  return mips;
+}
+
+// +======+
+// | KTX2 |
+// +======+
+static const uint8_t s_KTX2Identifier[12] = {0xAB, 'K',  'T',  'X',
+                                             ' ',  '2',  '0',  0xBB,
+                                             '\r', '\n', 0x1A, '\n'};
+
+struct KTX2Header {
+  uint8_t Identifier[12];
+  uint32_t VkFormat;
+  uint32_t TypeSize;
+  uint32_t PixelWidth;
+  uint32_t PixelHeight;
+  uint32_t PixelDepth;
+  uint32_t LayerCount;
+  uint32_t FaceCount;
+  uint32_t LevelCount;
+  uint32_t SupercompressionScheme;
+  uint32_t DfdByteOffset;
+  uint32_t DfdByteLength;
+  uint32_t KvdByteOffset;
+  uint32_t KvdByteLength;
+  uint64_t SgdByteOffset;
+  uint64_t SgdByteLength;
+};
+static_assert(sizeof(KTX2Header) == 80, "KTX2 header must not be padded!");
+
+static constexpr uint32_t s_KTX2MaxSize = 16384;
+
+struct KTX2Level {
+  uint64_t ByteOffset;
+  uint64_t ByteLength;
+  uint64_t UncompressedByteLength;
+};
+
+enum KTX2Supercompression : uint32_t {
+  KTX2_SUPERCOMPRESSION_NONE = 0,
+  KTX2_SUPERCOMPRESSION_BASIS_LZ = 1,
+  KTX2_SUPERCOMPRESSION_ZSTD = 2,
+};
+
+// KTX2 stores the VkFormat of its data, the values are fixed by the Vulkan
+// specification
+struct KTX2Format {
+  uint32_t VkFormat;
+  TextureFormat Format;
+  TextureFormat Linear;
+};
+
+static const KTX2Format s_KTX2Formats[] = {
+    {37, TextureFormat::RGBA8, TextureFormat::RGBA8},
+    {43, TextureFormat::RGBA8_SRGB, TextureFormat::RGBA8},
+    {133, TextureFormat::BC1, TextureFormat::BC1},
+    {134, TextureFormat::BC1_SRGB, TextureFormat::BC1},
+    {137, TextureFormat::BC3, TextureFormat::BC3},
+    {138, TextureFormat::BC3_SRGB, TextureFormat::BC3},
+    {141, TextureFormat::BC5, TextureFormat::BC5},
+    {145, TextureFormat::BC7, TextureFormat::BC7},
+    {146, TextureFormat::BC7_SRGB, TextureFormat::BC7},
+    {151, TextureFormat::ETC2_RGBA8, TextureFormat::ETC2_RGBA8},
+    {152, TextureFormat::ETC2_RGBA8_SRGB, TextureFormat::ETC2_RGBA8},
+    {157, TextureFormat::ASTC_4x4, TextureFormat::ASTC_4x4},
+    {158, TextureFormat::ASTC_4x4_SRGB, TextureFormat::ASTC_4x4},
+};
+
+static const KTX2Format *FindKTX2Format(uint32_t vkFormat) {
+  for (const KTX2Format &entry : s_KTX2Formats) {
+    if (entry.VkFormat == vkFormat) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+#ifdef ME_HAS_BASISU
+static TextureFormat ToSRGB(TextureFormat format) {
+  for (const KTX2Format &entry : s_KTX2Formats) {
+    if (entry.Linear == format && entry.Format != format) {
+      return entry.Format;
+    }
+  }
+  return format;
+}
+
+// cTFTotalTextureFormats when Basis Universal can't transcode to the format
+static basist::transcoder_texture_format ToBasisFormat(TextureFormat format,
+                                                       bool hasAlpha) {
+  switch (format) {
+  case TextureFormat::RGBA8:
+    return basist::transcoder_texture_format::cTFRGBA32;
+  case TextureFormat::BC1:
+    return hasAlpha ? basist::transcoder_texture_format::cTFTotalTextureFormats
+                    : basist::transcoder_texture_format::cTFBC1_RGB;
+  case TextureFormat::BC3:
+    return basist::transcoder_texture_format::cTFBC3_RGBA;
+  case TextureFormat::BC7:
+    return basist::transcoder_texture_format::cTFBC7_RGBA;
+  case TextureFormat::ETC2_RGBA8:
+    return basist::transcoder_texture_format::cTFETC2_RGBA;
+  case TextureFormat::ASTC_4x4:
+    return basist::transcoder_texture_format::cTFASTC_4x4_RGBA;
+  default:
+    return basist::transcoder_texture_format::cTFTotalTextureFormats;
+  }
+}
+
+static bool TranscodeBasis(const std::string &filepath,
+                           const std::vector<uint8_t> &data,
+                           const std::vector<TextureFormat> &formats,
+                           std::vector<ImageData> *pMips) {
+  // Builds the transcoder tables once, thread safe through the static
+  static const bool s_Initialized = []() {
+    basist::basisu_transcoder_init();
+    return true;
+  }();
+  (void)s_Initialized;
+
+  basist::ktx2_transcoder transcoder;
+  if (!transcoder.init(data.data(), (uint32_t)data.size()) ||
+      !transcoder.start_transcoding()) {
+    ME_CORE_ERROR("Unable to read Basis Universal data of {0}", filepath);
+    return false;
+  }
+
+  TextureFormat format = TextureFormat::RGBA8;
+  basist::transcoder_texture_format target =
+      basist::transcoder_texture_format::cTFRGBA32;
+  for (TextureFormat candidate : formats) {
+    basist::transcoder_texture_format candidateTarget =
+        ToBasisFormat(candidate, transcoder.get_has_alpha());
+    if (candidateTarget !=
+        basist::transcoder_texture_format::cTFTotalTextureFormats) {
+      format = candidate;
+      target = candidateTarget;
+      break;
+    }
+  }
+  if (transcoder.get_dfd_transfer_func() ==
+      basist::KTX2_KHR_DF_TRANSFER_SRGB) {
+    format = ToSRGB(format);
+  }
+
+  const uint32_t levelCount = std::max(transcoder.get_levels(), 1u);
+  for (uint32_t level = 0; level < levelCount; level++) {
+    basist::ktx2_image_level_info info;
+    if (!transcoder.get_image_level_info(info, level, 0, 0)) {
+      ME_CORE_ERROR("Unable to read level {0} of {1}", level, filepath);
+      return false;
+    }
+
+    ImageData image;
+    image.Width = info.m_orig_width;
+    image.Height = info.m_orig_height;
+    image.Format = format;
+    image.Pixels.resize(
+        TextureFormatImageSize(format, image.Width, image.Height));
+    // Compressed outputs are sized in blocks, RGBA8 in pixels
+    const uint32_t outputSize = TextureFormatBlockSize(format) == 0
+                                    ? image.Width * image.Height
+                                    : info.m_total_blocks;
+    if (!transcoder.transcode_image_level(level, 0, 0, image.Pixels.data(),
+                                          outputSize, target)) {
+      ME_CORE_ERROR("Unable to transcode level {0} of {1}", level, filepath);
+      return false;
+    }
+    pMips->push_back(std::move(image));
+  }
+  return true;
+}
+#endif
+
+bool ImageDecoder::DecodeKTX2(const std::string &filepath,
+                              const std::vector<TextureFormat> &formats,
+                              std::vector<ImageData> *pMips) {
+  pMips->clear();
+
+  std::vector<uint8_t> data;
+  if (Filesystem::ReadBinaryFile(filepath, &data) !=
+      Filesystem::READ_SUCCESS) {
+    ME_CORE_ERROR("Unable to read image {0}", filepath);
+    return false;
+  }
+
+  KTX2Header header;
+  if (data.size() < sizeof(header)) {
+    ME_CORE_ERROR("{0} is not a KTX2 file", filepath);
+    return false;
+  }
+  memcpy(&header, data.data(), sizeof(header));
+  if (memcmp(header.Identifier, s_KTX2Identifier, sizeof(s_KTX2Identifier)) !=
+      0) {
+    ME_CORE_ERROR("{0} is not a KTX2 file", filepath);
+    return false;
+  }
+  if (header.PixelDepth > 1 || header.LayerCount > 1 ||
+      header.FaceCount != 1) {
+    ME_CORE_ERROR("Unable to read {0}, only 2D KTX2 textures are supported",
+                  filepath);
+    return false;
+  }
+  // Keeps the level sizes within 32 bits
+  if (header.PixelWidth > s_KTX2MaxSize || header.PixelHeight > s_KTX2MaxSize) {
+    ME_CORE_ERROR("Unable to read {0}, {1}x{2} is larger than {3}x{3}",
+                  filepath, header.PixelWidth, header.PixelHeight,
+                  s_KTX2MaxSize);
+    return false;
+  }
+
+  // A level count of 0 asks for mips to be generated, only the image is stored
+  const uint32_t levelCount = std::max(header.LevelCount, 1u);
+  if (sizeof(header) + levelCount * sizeof(KTX2Level) > data.size()) {
+    ME_CORE_ERROR("{0} is truncated", filepath);
+    return false;
+  }
+
+  // Levels past 1x1 would shift the size by 32 bits or more
+  uint32_t maxLevelCount = 1;
+  for (uint32_t size = std::max(header.PixelWidth, header.PixelHeight);
+       size > 1; size >>= 1) {
+    maxLevelCount++;
+  }
+  if (levelCount > maxLevelCount) {
+    ME_CORE_ERROR("Unable to read {0}, {1} levels are more than the {2} of a "
+                  "{3}x{4} image",
+                  filepath, levelCount, maxLevelCount, header.PixelWidth,
+                  header.PixelHeight);
+    return false;
+  }
+
+  // Basis Universal data has no format of its own until it is transcoded
+  if (header.VkFormat == 0) {
+#ifdef ME_HAS_BASISU
+    return TranscodeBasis(filepath, data, formats, pMips);
+#else
+    ME_CORE_ERROR("Unable to read {0}, Basis Universal support is disabled",
+                  filepath);
+    return false;
+#endif
+  }
+
+  const KTX2Format *format = FindKTX2Format(header.VkFormat);
+  if (format == nullptr ||
+      (format->Linear != TextureFormat::RGBA8 &&
+       std::find(formats.begin(), formats.end(), format->Linear) ==
+           formats.end())) {
+    ME_CORE_ERROR("Unable to read {0}, format {1} is not supported", filepath,
+                  header.VkFormat);
+    return false;
+  }
+
+  const uint32_t scheme = header.SupercompressionScheme;
+#ifdef ME_HAS_BASISU
+  const bool supported = scheme == KTX2_SUPERCOMPRESSION_NONE ||
+                         scheme == KTX2_SUPERCOMPRESSION_ZSTD;
+#else
+  const bool supported = scheme == KTX2_SUPERCOMPRESSION_NONE;
+#endif
+  if (!supported) {
+    ME_CORE_ERROR("Unable to read {0}, supercompression {1} is not supported",
+                  filepath, scheme);
+    return false;
+  }
+
+  for (uint32_t level = 0; level < levelCount; level++) {
+    KTX2Level index;
+    memcpy(&index, data.data() + sizeof(header) + level * sizeof(KTX2Level),
+           sizeof(index));
+
+    ImageData image;
+    image.Width = std::max(header.PixelWidth >> level, 1u);
+    image.Height = std::max(header.PixelHeight >> level, 1u);
+    image.Format = format->Format;
+    const size_t size =
+        TextureFormatImageSize(image.Format, image.Width, image.Height);
+    if (index.ByteOffset > data.size() ||
+        index.ByteLength > data.size() - index.ByteOffset) {
+      ME_CORE_ERROR("{0} is truncated", filepath);
+      return false;
+    }
+
+    const uint8_t *levelData = data.data() + index.ByteOffset;
+    if (scheme == KTX2_SUPERCOMPRESSION_NONE) {
+      if (index.ByteLength < size) {
+        ME_CORE_ERROR("Level {0} of {1} is truncated", level, filepath);
+        return false;
+      }
+      image.Pixels.assign(levelData, levelData + size);
+    } else {
+#ifdef ME_HAS_BASISU
+      image.Pixels.resize(size);
+      const size_t result = ZSTD_decompress(image.Pixels.data(), size,
+                                            levelData, index.ByteLength);
+      if (ZSTD_isError(result) || result != size) {
+        ME_CORE_ERROR("Unable to decompress level {0} of {1}", level,
+                      filepath);
+        return false;
+      }
+#endif
+    }
+    pMips->push_back(std::move(image));
+  }
+  return true;
+}
+
+bool ImageDecoder::IsKTX2(const std::string &filepath) {
+  return std::filesystem::path(filepath).extension() == ".ktx2";
+}
+} // namespace MyEngine
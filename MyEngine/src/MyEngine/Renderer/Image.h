@@ -0,0 +1,34 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Renderer/Texture.h"
+
+namespace MyEngine {
+// Decoded image, tightly packed RGBA8 pixels or blocks of a compressed format
+struct ImageData {
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  TextureFormat Format = TextureFormat::RGBA8;
+  std::vector<uint8_t> Pixels;
+};
+
+class ImageDecoder {
+public:
+  // Decodes PNG, JPEG, TGA, BMP and the other formats stb_image reads to RGBA8.
+  // KTX2 files fail, they have to be read through DecodeKTX2. Safe to call
+  // from worker threads, returns false and logs when the file can't be read.
+  static bool Decode(const std::string &filepath, ImageData *pImage);
+  // Reads every mip level of a 2D KTX2 file. formats lists the compressed
+  // formats the GPU samples by their linear variant in order of preference,
+  // the sRGB variant is used for sRGB data. Compressed levels are kept as they
+  // are, Basis Universal data is transcoded to the first format it supports
+  // and to RGBA8 when none of them fit. Safe to call from worker threads.
+  static bool DecodeKTX2(const std::string &filepath,
+                         const std::vector<TextureFormat> &formats,
+                         std::vector<ImageData> *pMips);
+  static bool IsKTX2(const std::string &filepath);
+  // Box filtered mip chain down to 1x1, the first level is the image itself.
+  // Only for RGBA8 images.
+  static std::vector<ImageData> GenerateMips(ImageData &&image);
+};
+} // namespace MyEngine
@@ -0,0 +1,157 @@
+#include "MyEngine/Renderer/Image.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace MyEngine {
+// VkFormat values stored in the files
+static constexpr uint32_t s_R8G8B8A8Unorm = 37;
+static constexpr uint32_t s_BC7Unorm = 145;
+
+// Builds uncompressed KTX2 files with the level data right after the level
+// index, tests then break them
+class KTX2Test : public ::testing::Test {
+protected:
+  struct Level {
+    uint64_t ByteOffset;
+    uint64_t ByteLength;
+    uint64_t UncompressedByteLength;
+  };
+
+  void SetUp() override {
+    m_Path = (std::filesystem::temp_directory_path() / "KTX2Test.ktx2")
+                 .string();
+  }
+
+  void TearDown() override { std::filesystem::remove(m_Path); }
+
+  void Build(uint32_t width, uint32_t height, uint32_t levelCount,
+             uint32_t vkFormat = s_R8G8B8A8Unorm) {
+    static const uint8_t s_Identifier[12] = {0xAB, 'K',  'T',  'X',
+                                             ' ',  '2',  '0',  0xBB,
+                                             '\r', '\n', 0x1A, '\n'};
+    // Format, type size, size, depth, layers, faces, levels, supercompression
+    const uint32_t header[9] = {vkFormat, 1, width, height, 0,
+                                0,        1, levelCount,    0};
+    m_Data.assign(s_Identifier, s_Identifier + sizeof(s_Identifier));
+    m_Data.resize(80);
+    memcpy(m_Data.data() + 12, header, sizeof(header));
+
+    m_Levels.clear();
+    uint64_t offset = 80 + sizeof(Level) * levelCount;
+    for (uint32_t level = 0; level < levelCount; level++) {
+      const uint64_t size = 4ull * std::max(width >> level, 1u) *
+                            std::max(height >> level, 1u);
+      m_Levels.push_back({offset, size, size});
+      offset += size;
+    }
+    WriteLevels();
+    for (uint64_t i = m_Data.size(); i < offset; i++) {
+      m_Data.push_back((uint8_t)i);
+    }
+  }
+
+  void WriteLevels() {
+    const size_t size = sizeof(Level) * m_Levels.size();
+    m_Data.resize(std::max(m_Data.size(), 80 + size));
+    memcpy(m_Data.data() + 80, m_Levels.data(), size);
+  }
+
+  bool Decode(const std::vector<TextureFormat> &formats = {}) {
+    std::ofstream(m_Path, std::ios::binary)
+        .write((const char *)m_Data.data(), m_Data.size());
+    return ImageDecoder::DecodeKTX2(m_Path, formats, &m_Mips);
+  }
+
+  std::string m_Path;
+  std::vector<uint8_t> m_Data;
+  std::vector<Level> m_Levels;
+  std::vector<ImageData> m_Mips;
+};
+
+TEST_F(KTX2Test, ReadsEveryLevel) {
+  Build(4, 2, 3);
+  ASSERT_TRUE(Decode());
+  ASSERT_EQ(m_Mips.size(), 3);
+  EXPECT_EQ(m_Mips[1].Width, 2);
+  EXPECT_EQ(m_Mips[1].Height, 1);
+  EXPECT_EQ(m_Mips[2].Width, 1);
+  EXPECT_EQ(m_Mips[2].Height, 1);
+  for (uint32_t level = 0; level < 3; level++) {
+    EXPECT_EQ(m_Mips[level].Format, TextureFormat::RGBA8);
+    ASSERT_EQ(m_Mips[level].Pixels.size(), m_Levels[level].ByteLength);
+    EXPECT_EQ(memcmp(m_Mips[level].Pixels.data(),
+                     m_Data.data() + m_Levels[level].ByteOffset,
+                     m_Levels[level].ByteLength),
+              0);
+  }
+}
+
+TEST_F(KTX2Test, RejectsTruncatedHeaders) {
+  Build(4, 4, 1);
+  m_Data.resize(79);
+  EXPECT_FALSE(Decode());
+}
+
+TEST_F(KTX2Test, RejectsLevelIndexPastTheEnd) {
+  Build(4, 4, 1);
+  const uint32_t levelCount = 1000;
+  memcpy(m_Data.data() + 40, &levelCount, sizeof(levelCount));
+  EXPECT_FALSE(Decode());
+}
+
+TEST_F(KTX2Test, RejectsMoreLevelsThanTheMipChain) {
+  // 4x4, 2x2 and 1x1
+  Build(4, 4, 3);
+  ASSERT_TRUE(Decode());
+
+  uint32_t levelCount = 4;
+  memcpy(m_Data.data() + 40, &levelCount, sizeof(levelCount));
+  EXPECT_FALSE(Decode());
+
+  // Enough room for the level index, the sizes would shift by 32 and more
+  levelCount = 40;
+  memcpy(m_Data.data() + 40, &levelCount, sizeof(levelCount));
+  m_Data.resize(80 + sizeof(Level) * levelCount + 1024);
+  EXPECT_FALSE(Decode());
+}
+
+TEST_F(KTX2Test, RejectsLevelsPastTheEnd) {
+  Build(4, 4, 1);
+  m_Levels[0].ByteOffset = m_Data.size() + 1;
+  WriteLevels();
+  EXPECT_FALSE(Decode());
+
+  // Offset and length wrap around when added
+  m_Levels[0].ByteOffset = 96;
+  m_Levels[0].ByteLength = UINT64_MAX - 64;
+  WriteLevels();
+  EXPECT_FALSE(Decode());
+}
+
+TEST_F(KTX2Test, RejectsLevelsShorterThanTheirSize) {
+  Build(4, 4, 1);
+  m_Levels[0].ByteLength--;
+  WriteLevels();
+  EXPECT_FALSE(Decode());
+}
+
+TEST_F(KTX2Test, RejectsSizesThatOverflow) {
+  // 65536x65536 RGBA8 wraps to 0 bytes in 32 bits
+  Build(1, 1, 1);
+  const uint32_t size[2] = {65536, 65536};
+  memcpy(m_Data.data() + 20, size, sizeof(size));
+  EXPECT_FALSE(Decode());
+}
+
+TEST_F(KTX2Test, RejectsFormatsTheGPUDoesNotSample) {
+  Build(4, 4, 1, s_BC7Unorm);
+  EXPECT_FALSE(Decode());
+  EXPECT_TRUE(Decode({TextureFormat::BC7}));
+  ASSERT_EQ(m_Mips.size(), 1);
+  EXPECT_EQ(m_Mips[0].Format, TextureFormat::BC7);
+}
+} // namespace MyEngine
@@ -0,0 +1,144 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/Mesh.h"
+#include "MyEngine/Renderer/MeshCache.h"
+#include "MyEngine/Renderer/MeshImporter.h"
+#include "MyEngine/Renderer/MeshOptimizer.h"
+#include "MyEngine/Renderer/Quantize.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace MyEngine {
+// Half the size of the bounds, flat axes keep a non zero scale so their
+// positions quantize to 0
+static Vector3 GetHalfExtent(const MeshBounds &bounds) {
+  return glm::max((bounds.Max - bounds.Min) * 0.5f, Vector3(1e-6f));
+}
+
+Mesh::Mesh(const MeshPosition *positions, const uint32_t *colors,
+           uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount,
+           const Submesh *submeshes, uint32_t submeshCount,
+           const MeshBounds &bounds)
+    : m_Submeshes(submeshes, submeshes + submeshCount), m_Bounds(bounds) {
+  // The pool copies the data right away, so it can point into a read only
+  // mapping
+  m_Geometry = GeometryPool::Allocate(positions, colors, vertexCount, indices,
+                                      indexCount);
+}
+
+Mesh::~Mesh() { GeometryPool::Free(m_Geometry); }
+
+Matrix4 Mesh::GetTransform(const MeshBounds &bounds) {
+  const Vector3 center = (bounds.Min + bounds.Max) * 0.5f;
+  return glm::scale(glm::translate(Matrix4(1.0f), center),
+                    GetHalfExtent(bounds));
+}
+
+MeshVertices Mesh::PackVertices(const std::vector<Vertex> &vertices,
+                                const MeshBounds &bounds) {
+  const Vector3 center = (bounds.Min + bounds.Max) * 0.5f;
+  const Vector3 scale = 1.0f / GetHalfExtent(bounds);
+
+  MeshVertices packed;
+  packed.Positions.resize(vertices.size());
+  packed.Colors.resize(vertices.size());
+  for (size_t i = 0; i < vertices.size(); i++) {
+    const Vector3 position = (vertices[i].Position - center) * scale;
+    packed.Positions[i].X = Quantize::ToSnorm16(position.x);
+    packed.Positions[i].Y = Quantize::ToSnorm16(position.y);
+    packed.Positions[i].Z = Quantize::ToSnorm16(position.z);
+    packed.Positions[i].W = 0;
+    packed.Colors[i] = Quantize::ToUnorm8x4(vertices[i].Color);
+  }
+  return packed;
+}
+
+// Imports and optimizes a mesh file and writes it to the mesh cache
+static bool ImportMesh(const std::string &filepath, MeshData *pData) {
+  if (!MeshImporter::Import(filepath, pData)) {
+    return false;
+  }
+
+  MeshOptimizerStats stats = MeshOptimizer::Optimize(pData);
+  ME_CORE_INFO("Imported mesh {0} with {1} submeshes, vertices {2} -> {3}, "
+               "ACMR {4:.3f} -> {5:.3f}, ATVR {6:.3f} -> {7:.3f}, overdraw "
+               "{8:.3f} -> {9:.3f}, overfetch {10:.3f} -> {11:.3f}",
+               filepath, pData->Submeshes.size(), stats.VerticesBefore,
+               stats.VerticesAfter, stats.AcmrBefore, stats.AcmrAfter,
+               stats.AtvrBefore, stats.AtvrAfter, stats.OverdrawBefore,
+               stats.OverdrawAfter, stats.OverfetchBefore,
+               stats.OverfetchAfter);
+
+  if (!MeshCache::Write(filepath, *pData)) {
+    ME_CORE_WARN("Unable to cache mesh {0}", filepath);
+  }
+  return true;
+}
+
+Ref<Mesh> Mesh::Load(const std::string &filepath) {
+  MeshCacheView view;
+  if (!MeshCache::Open(filepath, &view)) {
+    MeshData data;
+    if (!ImportMesh(filepath, &data)) {
+      return nullptr;
+    }
+
+    if (!MeshCache::Open(filepath, &view)) {
+      ME_CORE_WARN("Unable to open cached mesh {0}", filepath);
+      MeshVertices vertices = PackVertices(data.Vertices, data.Bounds);
+      return CreateRef<Mesh>(vertices.Positions.data(), vertices.Colors.data(),
+                             (uint32_t)data.Vertices.size(),
+                             data.Indices.data(), (uint32_t)data.Indices.size(),
+                             data.Submeshes.data(),
+                             (uint32_t)data.Submeshes.size(), data.Bounds);
+    }
+  }
+
+  // The mapping is released once the pool copied the geometry
+  return CreateRef<Mesh>(view.Positions, view.Colors, view.VertexCount,
+                         view.Indices, view.IndexCount, view.Submeshes,
+                         view.SubmeshCount, view.Bounds);
+}
+
+// Maps quantized vertices back through the mesh transform
+static void UnpackVertices(const MeshPosition *positions,
+                           const uint32_t *colors, uint32_t vertexCount,
+                           const MeshBounds &bounds,
+                           std::vector<Vertex> *pVertices) {
+  const Matrix4 transform = Mesh::GetTransform(bounds);
+  pVertices->clear();
+  pVertices->reserve(vertexCount);
+  for (uint32_t i = 0; i < vertexCount; i++) {
+    const Vector4 quantized(Quantize::FromSnorm16(positions[i].X),
+                            Quantize::FromSnorm16(positions[i].Y),
+                            Quantize::FromSnorm16(positions[i].Z), 1.0f);
+    pVertices->emplace_back(Vector3(transform * quantized),
+                            Quantize::FromUnorm8x4(colors[i]));
+  }
+}
+
+bool Mesh::LoadData(const std::string &filepath, MeshData *pData) {
+  MeshCacheView view;
+  if (!MeshCache::Open(filepath, &view)) {
+    if (!ImportMesh(filepath, pData)) {
+      return false;
+    }
+
+    // Quantized like the cached file, so the data is the same whether the
+    // cache was hit or not
+    const MeshVertices packed = PackVertices(pData->Vertices, pData->Bounds);
+    UnpackVertices(packed.Positions.data(), packed.Colors.data(),
+                   (uint32_t)packed.Positions.size(), pData->Bounds,
+                   &pData->Vertices);
+    return true;
+  }
+
+  UnpackVertices(view.Positions, view.Colors, view.VertexCount, view.Bounds,
+                 &pData->Vertices);
+  pData->Indices.assign(view.Indices, view.Indices + view.IndexCount);
+  pData->Submeshes.assign(view.Submeshes,
+                          view.Submeshes + view.SubmeshCount);
+  pData->Bounds = view.Bounds;
+  return true;
+}
+} // namespace MyEngine
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Renderer/GeometryPool.h"
+#include "MyEngine/Renderer/VertexArray.h"
+#include "MyEngine/Renderer/VertexLayout.h"
+
+namespace MyEngine {
+struct MeshBounds {
+  Vector3 Min = Vector3(0.0f);
+  Vector3 Max = Vector3(0.0f);
+};
+
+// Range of a mesh drawn with one material. Indices index the vertices of the
+// whole mesh.
+struct Submesh {
+  uint32_t FirstIndex = 0;
+  uint32_t IndexCount = 0;
+  uint32_t FirstVertex = 0;
+  uint32_t VertexCount = 0;
+  uint32_t MaterialIndex = 0;
+  MeshBounds Bounds;
+};
+
+// Position of uploaded meshes, SNORM16 relative to the mesh bounds and mapped
+// back by Mesh::GetTransform. W is padding.
+struct MeshPosition {
+  int16_t X, Y, Z, W;
+};
+using MeshPositionLayout = VertexLayout<
+    Attr<ShaderDataType::Short4, VertexAttribute::Position, true>>;
+static_assert(MeshPositionLayout::Matches<MeshPosition>(
+                  {offsetof(MeshPosition, X)}),
+              "MeshPositionLayout does not match MeshPosition");
+
+using MeshColorLayout =
+    VertexLayout<Attr<ShaderDataType::UByte4, VertexAttribute::Color, true>>;
+static_assert(MeshColorLayout::Matches<uint32_t>({0}),
+              "MeshColorLayout does not match a packed color");
+
+// Vertices of uploaded meshes, 12 bytes each instead of the 28 of Vertex. They
+// are split into two streams so passes that only need positions (depth
+// prepass, shadows) fetch the position stream alone.
+struct MeshVertices {
+  std::vector<MeshPosition> Positions;
+  // UNORM8 RGBA
+  std::vector<uint32_t> Colors;
+};
+
+// Imported geometry before it is written to the mesh cache
+struct MeshData {
+  std::vector<Vertex> Vertices;
+  std::vector<uint32_t> Indices;
+  std::vector<Submesh> Submeshes;
+  MeshBounds Bounds;
+};
+
+// Geometry lives in the GeometryPool, so meshes share their buffers and are
+// drawn with a draw range into the arrays of their page
+class Mesh {
+public:
+  Mesh(const MeshPosition *positions, const uint32_t *colors,
+       uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount,
+       const Submesh *submeshes, uint32_t submeshCount,
+       const MeshBounds &bounds);
+  ~Mesh();
+
+  Mesh(const Mesh &) = delete;
+  Mesh &operator=(const Mesh &) = delete;
+
+  const Ref<VertexArray> &GetVertexArray() const {
+    return GeometryPool::GetVertexArray(m_Geometry.Page);
+  }
+  // Same indices with only the a_position stream, for position only passes
+  const Ref<VertexArray> &GetPositionArray() const {
+    return GeometryPool::GetPositionArray(m_Geometry.Page);
+  }
+  // The whole mesh or one submesh within the arrays
+  DrawRange GetDrawRange() const { return m_Geometry.GetDrawRange(); }
+  DrawRange GetDrawRange(const Submesh &submesh) const {
+    return {m_Geometry.FirstIndex + submesh.FirstIndex, submesh.IndexCount,
+            (int32_t)m_Geometry.FirstVertex};
+  }
+  const std::vector<Submesh> &GetSubmeshes() const { return m_Submeshes; }
+  const MeshBounds &GetBounds() const { return m_Bounds; }
+  // Maps the quantized positions back into the space of the mesh, multiply it
+  // into u_Transform
+  Matrix4 GetTransform() const { return GetTransform(m_Bounds); }
+  static Matrix4 GetTransform(const MeshBounds &bounds);
+
+  // Quantizes vertices for a mesh with the given bounds
+  static MeshVertices PackVertices(const std::vector<Vertex> &vertices,
+                                   const MeshBounds &bounds);
+
+  // Loads OBJ and glTF files. The first load imports the file into the mesh
+  // cache, later loads map the cached file and upload from the mapping. Returns
+  // nullptr and logs when the file can't be imported.
+  static Ref<Mesh> Load(const std::string &filepath);
+  // Reads a mesh file like Load but keeps the geometry on the CPU, with the
+  // positions mapped back through the mesh transform. For passes that process
+  // geometry before it is uploaded, like StaticBatch.
+  static bool LoadData(const std::string &filepath, MeshData *pData);
+
+private:
+  GeometryAllocation m_Geometry;
+  std::vector<Submesh> m_Submeshes;
+  MeshBounds m_Bounds;
+};
+} // namespace MyEngine
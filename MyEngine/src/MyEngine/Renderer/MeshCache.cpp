@@ -0,0 +1,200 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/FileWatcher.h"
+#include "MyEngine/Core/Hash.h"
+#include "MyEngine/Filesystem/Filesystem.h"
+#include "MyEngine/Renderer/MeshCache.h"
+
+#include <cstring>
+
+namespace MyEngine {
+static const char s_Magic[4] = {'M', 'E', 'M', 'S'};
+
+struct MeshCacheHeader {
+  char Magic[4];
+  uint32_t Version;
+  // Size and modification time of the source file
+  uint64_t SourceSize;
+  int64_t SourceTime;
+  // Bytes per vertex across the streams
+  uint32_t VertexStride;
+  uint32_t VertexCount;
+  uint32_t IndexCount;
+  uint32_t SubmeshCount;
+  uint64_t PositionOffset;
+  uint64_t ColorOffset;
+  uint64_t IndexOffset;
+  uint64_t SubmeshOffset;
+  MeshBounds Bounds;
+};
+
+static constexpr uint32_t s_VertexStride =
+    sizeof(MeshPosition) + sizeof(uint32_t);
+
+static uint64_t Align(uint64_t offset) {
+  return (offset + MeshCache::BlobAlignment - 1) &
+         ~(MeshCache::BlobAlignment - 1);
+}
+
+// Blobs are used in place, they have to be aligned and lie within the file
+static bool IsBlobInFile(uint64_t offset, uint64_t count, uint64_t elementSize,
+                         uint64_t fileSize) {
+  return offset >= sizeof(MeshCacheHeader) &&
+         offset % MeshCache::BlobAlignment == 0 && offset <= fileSize &&
+         count <= (fileSize - offset) / elementSize;
+}
+
+// Submeshes index the vertices of their own range, like the importer and the
+// optimizer write them. Catches files that would make draws read past the
+// vertex streams.
+// Mesh draws every index, not only those of its submeshes
+static bool IsGeometryValid(const MeshCacheHeader &header,
+                            const uint32_t *indices,
+                            const Submesh *submeshes) {
+  for (uint32_t i = 0; i < header.IndexCount; i++) {
+    if (indices[i] >= header.VertexCount) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < header.SubmeshCount; i++) {
+    const Submesh &submesh = submeshes[i];
+    const uint64_t vertexEnd =
+        (uint64_t)submesh.FirstVertex + submesh.VertexCount;
+    if ((uint64_t)submesh.FirstIndex + submesh.IndexCount >
+            header.IndexCount ||
+        vertexEnd > header.VertexCount) {
+      return false;
+    }
+    for (uint32_t j = 0; j < submesh.IndexCount; j++) {
+      const uint32_t index = indices[submesh.FirstIndex + j];
+      if (index < submesh.FirstVertex || index >= vertexEnd) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static bool GetSourceStamp(const std::string &filepath, uint64_t *pSize,
+                           int64_t *pTime) {
+  std::error_code error;
+  *pSize = std::filesystem::file_size(filepath, error);
+  if (error) {
+    return false;
+  }
+  auto time = std::filesystem::last_write_time(filepath, error);
+  *pTime = time.time_since_epoch().count();
+  return !error;
+}
+
+std::string MeshCache::GetCachePath(const std::string &filepath) {
+  const uint64_t key =
+      Hash::Combine(Hash::XXH64(FileWatcher::Normalize(filepath)), Version);
+  return Filesystem::GetCacheDirectory() + "/meshes/" +
+         Filesystem::GetFilename(filepath) + "." + Hash::ToHexString(key) +
+         ".mesh";
+}
+
+bool MeshCache::Write(const std::string &filepath, const MeshData &data) {
+  MeshCacheHeader header{};
+  memcpy(header.Magic, s_Magic, sizeof(s_Magic));
+  header.Version = Version;
+  if (!GetSourceStamp(filepath, &header.SourceSize, &header.SourceTime)) {
+    return false;
+  }
+  header.VertexStride = s_VertexStride;
+  header.VertexCount = (uint32_t)data.Vertices.size();
+  header.IndexCount = (uint32_t)data.Indices.size();
+  header.SubmeshCount = (uint32_t)data.Submeshes.size();
+  header.PositionOffset = Align(sizeof(header));
+  header.ColorOffset = Align(header.PositionOffset +
+                             sizeof(MeshPosition) * data.Vertices.size());
+  header.IndexOffset =
+      Align(header.ColorOffset + sizeof(uint32_t) * data.Vertices.size());
+  header.SubmeshOffset =
+      Align(header.IndexOffset + sizeof(uint32_t) * data.Indices.size());
+  header.Bounds = data.Bounds;
+
+  std::vector<uint8_t> contents(header.SubmeshOffset +
+                                sizeof(Submesh) * data.Submeshes.size());
+  memcpy(contents.data(), &header, sizeof(header));
+  const MeshVertices vertices = Mesh::PackVertices(data.Vertices, data.Bounds);
+  memcpy(contents.data() + header.PositionOffset, vertices.Positions.data(),
+         sizeof(MeshPosition) * vertices.Positions.size());
+  memcpy(contents.data() + header.ColorOffset, vertices.Colors.data(),
+         sizeof(uint32_t) * vertices.Colors.size());
+  memcpy(contents.data() + header.IndexOffset, data.Indices.data(),
+         sizeof(uint32_t) * data.Indices.size());
+  memcpy(contents.data() + header.SubmeshOffset, data.Submeshes.data(),
+         sizeof(Submesh) * data.Submeshes.size());
+
+  // Written next to the cached file and moved over it, so a file that is
+  // still mapped or a crash halfway never leaves a broken cache behind
+  const std::string path = GetCachePath(filepath);
+  const std::string tempPath = path + ".tmp";
+  if (Filesystem::WriteBinaryFile(tempPath, contents.data(),
+                                  contents.size()) !=
+      Filesystem::WRITE_SUCCESS) {
+    return false;
+  }
+  std::error_code error;
+  std::filesystem::rename(tempPath, path, error);
+  return !error;
+}
+
+bool MeshCache::Open(const std::string &filepath, MeshCacheView *pView) {
+  MappedFile &file = pView->File;
+  if (!file.Open(GetCachePath(filepath))) {
+    return false;
+  }
+
+  MeshCacheHeader header;
+  uint64_t sourceSize;
+  int64_t sourceTime;
+  if (file.GetSize() < sizeof(header) ||
+      !GetSourceStamp(filepath, &sourceSize, &sourceTime)) {
+    file.Close();
+    return false;
+  }
+  memcpy(&header, file.GetData(), sizeof(header));
+  if (memcmp(header.Magic, s_Magic, sizeof(s_Magic)) != 0 ||
+      header.Version != Version ||
+      header.VertexStride != s_VertexStride ||
+      header.SourceSize != sourceSize || header.SourceTime != sourceTime) {
+    file.Close();
+    return false;
+  }
+
+  // Up to date but broken, Mesh imports the source again
+  const uint8_t *data = file.GetData();
+  const uint64_t size = file.GetSize();
+  if (!IsBlobInFile(header.PositionOffset, header.VertexCount,
+                    sizeof(MeshPosition), size) ||
+      !IsBlobInFile(header.ColorOffset, header.VertexCount, sizeof(uint32_t),
+                    size) ||
+      !IsBlobInFile(header.IndexOffset, header.IndexCount, sizeof(uint32_t),
+                    size) ||
+      !IsBlobInFile(header.SubmeshOffset, header.SubmeshCount,
+                    sizeof(Submesh), size) ||
+      !IsGeometryValid(
+          header, reinterpret_cast<const uint32_t *>(data + header.IndexOffset),
+          reinterpret_cast<const Submesh *>(data + header.SubmeshOffset))) {
+    ME_CORE_WARN("Cached mesh {0} is corrupt", GetCachePath(filepath));
+    file.Close();
+    return false;
+  }
+
+  pView->Positions =
+      reinterpret_cast<const MeshPosition *>(data + header.PositionOffset);
+  pView->Colors = reinterpret_cast<const uint32_t *>(data + header.ColorOffset);
+  pView->VertexCount = header.VertexCount;
+  pView->Indices =
+      reinterpret_cast<const uint32_t *>(data + header.IndexOffset);
+  pView->IndexCount = header.IndexCount;
+  pView->Submeshes =
+      reinterpret_cast<const Submesh *>(data + header.SubmeshOffset);
+  pView->SubmeshCount = header.SubmeshCount;
+  pView->Bounds = header.Bounds;
+  return true;
+}
+} // namespace MyEngine
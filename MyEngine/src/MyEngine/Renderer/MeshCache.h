@@ -0,0 +1,36 @@
+#pragma once
+
+#include "MyEngine/Filesystem/MappedFile.h"
+#include "MyEngine/Renderer/Mesh.h"
+
+namespace MyEngine {
+// Mesh file in the cache directory, pointing into its mapping
+struct MeshCacheView {
+  MappedFile File;
+  const MeshPosition *Positions = nullptr;
+  const uint32_t *Colors = nullptr;
+  uint32_t VertexCount = 0;
+  const uint32_t *Indices = nullptr;
+  uint32_t IndexCount = 0;
+  const Submesh *Submeshes = nullptr;
+  uint32_t SubmeshCount = 0;
+  MeshBounds Bounds;
+};
+
+// Binary mesh format: a header followed by the position, color, index and
+// submesh blobs, each aligned to BlobAlignment so they can be used in place.
+// Cached files remember the size and modification time of their source and
+// are rewritten once it changes.
+class MeshCache {
+public:
+  static constexpr uint32_t Version = 4;
+  static constexpr uint64_t BlobAlignment = 64;
+
+  static std::string GetCachePath(const std::string &filepath);
+
+  static bool Write(const std::string &filepath, const MeshData &data);
+  // Fails when there is no cached file, it is out of date or any of its blobs
+  // or submeshes point outside of the file
+  static bool Open(const std::string &filepath, MeshCacheView *pView);
+};
+} // namespace MyEngine
@@ -0,0 +1,145 @@
+#include "MyEngine/Renderer/MeshCache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace MyEngine {
+// Header fields the tests break, by their offset in the file
+static constexpr size_t s_VersionOffset = 4;
+static constexpr size_t s_VertexCountOffset = 28;
+static constexpr size_t s_IndexCountOffset = 32;
+static constexpr size_t s_SubmeshCountOffset = 36;
+static constexpr size_t s_PositionOffsetOffset = 40;
+static constexpr size_t s_IndexOffsetOffset = 56;
+
+class MeshCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_Source =
+        (std::filesystem::temp_directory_path() / "MeshCacheTest.obj").string();
+    std::ofstream(m_Source) << "o MeshCacheTest\n";
+
+    // A quad and a triangle indexing the vertices after it
+    for (uint32_t i = 0; i < 7; i++) {
+      m_Data.Vertices.emplace_back(Vector3((float)i, 0.0f, 0.0f),
+                                   Vector4(1.0f));
+    }
+    m_Data.Indices = {0, 1, 2, 2, 3, 0, 4, 5, 6};
+    m_Data.Submeshes.resize(2);
+    m_Data.Submeshes[0] = {0, 6, 0, 4, 0, {}};
+    m_Data.Submeshes[1] = {6, 3, 4, 3, 1, {}};
+    m_Data.Bounds.Max = Vector3(6.0f, 0.0f, 0.0f);
+    ASSERT_TRUE(MeshCache::Write(m_Source, m_Data));
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(MeshCache::GetCachePath(m_Source));
+    std::filesystem::remove(m_Source);
+  }
+
+  std::vector<uint8_t> ReadCache() {
+    std::ifstream in(MeshCache::GetCachePath(m_Source), std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), {});
+  }
+
+  void WriteCache(const std::vector<uint8_t> &contents) {
+    std::ofstream(MeshCache::GetCachePath(m_Source),
+                  std::ios::binary | std::ios::trunc)
+        .write((const char *)contents.data(), contents.size());
+  }
+
+  template <typename T> void Patch(size_t offset, T value) {
+    std::vector<uint8_t> contents = ReadCache();
+    memcpy(contents.data() + offset, &value, sizeof(value));
+    WriteCache(contents);
+  }
+
+  bool Open() {
+    MeshCacheView view;
+    return MeshCache::Open(m_Source, &view);
+  }
+
+  std::string m_Source;
+  MeshData m_Data;
+};
+
+TEST_F(MeshCacheTest, OpensWhatWasWritten) {
+  MeshCacheView view;
+  ASSERT_TRUE(MeshCache::Open(m_Source, &view));
+  EXPECT_EQ(view.VertexCount, 7);
+  ASSERT_EQ(view.IndexCount, 9);
+  EXPECT_TRUE(std::equal(m_Data.Indices.begin(), m_Data.Indices.end(),
+                         view.Indices));
+  ASSERT_EQ(view.SubmeshCount, 2);
+  EXPECT_EQ(view.Submeshes[1].FirstIndex, 6);
+  EXPECT_EQ(view.Submeshes[1].FirstVertex, 4);
+  EXPECT_EQ(view.Submeshes[1].MaterialIndex, 1);
+  EXPECT_EQ(view.Bounds.Max.x, 6.0f);
+  // Blobs are used in place
+  EXPECT_EQ((uintptr_t)view.Positions % MeshCache::BlobAlignment, 0);
+  EXPECT_EQ((uintptr_t)view.Indices % MeshCache::BlobAlignment, 0);
+}
+
+TEST_F(MeshCacheTest, RejectsChangedSources) {
+  std::ofstream(m_Source, std::ios::app) << "v 0 0 0\n";
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsOtherVersions) {
+  Patch<uint32_t>(s_VersionOffset, MeshCache::Version + 1);
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsTruncatedFiles) {
+  std::vector<uint8_t> contents = ReadCache();
+  contents.resize(contents.size() - 1);
+  WriteCache(contents);
+  EXPECT_FALSE(Open());
+
+  contents.resize(16);
+  WriteCache(contents);
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsBlobsOutsideOfTheFile) {
+  Patch<uint32_t>(s_VertexCountOffset, UINT32_MAX);
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsMisalignedBlobs) {
+  std::vector<uint8_t> contents = ReadCache();
+  uint64_t offset;
+  memcpy(&offset, contents.data() + s_PositionOffsetOffset, sizeof(offset));
+  Patch<uint64_t>(s_PositionOffsetOffset, offset + 4);
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsSubmeshesPastTheIndices) {
+  Patch<uint32_t>(s_IndexCountOffset, 6);
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsIndicesOutsideOfTheirSubmesh) {
+  std::vector<uint8_t> contents = ReadCache();
+  uint64_t offset;
+  memcpy(&offset, contents.data() + s_IndexOffsetOffset, sizeof(offset));
+  // The triangle indexes a vertex of the quad
+  Patch<uint32_t>(offset + 6 * sizeof(uint32_t), 3);
+  EXPECT_FALSE(Open());
+}
+
+TEST_F(MeshCacheTest, RejectsIndicesOutsideOfTheVertices) {
+  // The triangle is still drawn without its submesh
+  Patch<uint32_t>(s_SubmeshCountOffset, 1);
+  ASSERT_TRUE(Open());
+
+  std::vector<uint8_t> contents = ReadCache();
+  uint64_t offset;
+  memcpy(&offset, contents.data() + s_IndexOffsetOffset, sizeof(offset));
+  Patch<uint32_t>(offset + 8 * sizeof(uint32_t), 7);
+  EXPECT_FALSE(Open());
+}
+} // namespace MyEngine
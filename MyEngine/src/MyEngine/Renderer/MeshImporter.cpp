@@ -0,0 +1,327 @@
+#include "mepch.h"
+
+#include "MyEngine/Filesystem/Filesystem.h"
+#include "MyEngine/Renderer/MeshImporter.h"
+
+#define CGLTF_IMPLEMENTATION
+#include <cgltf.h>
+
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+#include <unordered_map>
+
+namespace MyEngine {
+// Fills in the vertex ranges and bounds of the submeshes, their vertices are
+// stored one after another
+static void FinishSubmeshes(MeshData *pData) {
+  for (size_t i = 0; i < pData->Submeshes.size(); i++) {
+    Submesh &submesh = pData->Submeshes[i];
+    const uint32_t end = i + 1 < pData->Submeshes.size()
+                             ? pData->Submeshes[i + 1].FirstVertex
+                             : (uint32_t)pData->Vertices.size();
+    submesh.VertexCount = end - submesh.FirstVertex;
+
+    MeshBounds &bounds = submesh.Bounds;
+    bounds.Min = Vector3(std::numeric_limits<float>::max());
+    bounds.Max = Vector3(std::numeric_limits<float>::lowest());
+    for (uint32_t v = submesh.FirstVertex; v < end; v++) {
+      bounds.Min = glm::min(bounds.Min, pData->Vertices[v].Position);
+      bounds.Max = glm::max(bounds.Max, pData->Vertices[v].Position);
+    }
+
+    if (i == 0) {
+      pData->Bounds = bounds;
+    } else {
+      pData->Bounds.Min = glm::min(pData->Bounds.Min, bounds.Min);
+      pData->Bounds.Max = glm::max(pData->Bounds.Max, bounds.Max);
+    }
+  }
+}
+
+// +=====+
+// | OBJ |
+// +=====+
+// Diffuse colors of the materials in a .mtl file
+static void
+ReadMaterialColors(const std::filesystem::path &path,
+                   std::unordered_map<std::string, Vector4> *pColors) {
+  std::string contents;
+  if (Filesystem::ReadFile(path.string(), &contents) !=
+      Filesystem::READ_SUCCESS) {
+    ME_CORE_WARN("Unable to read material library {0}", path.string());
+    return;
+  }
+
+  std::istringstream stream(contents);
+  std::string line;
+  Vector4 *pColor = nullptr;
+  while (std::getline(stream, line)) {
+    std::istringstream tokens(line);
+    std::string keyword;
+    tokens >> keyword;
+    if (keyword == "newmtl") {
+      std::string name;
+      tokens >> name;
+      pColor = &(*pColors)[name];
+      *pColor = Vector4(1.0f);
+    } else if (keyword == "Kd" && pColor != nullptr) {
+      tokens >> pColor->r >> pColor->g >> pColor->b;
+    } else if (keyword == "d" && pColor != nullptr) {
+      tokens >> pColor->a;
+    }
+  }
+}
+
+static bool ImportOBJ(const std::string &filepath, MeshData *pData) {
+  std::string contents;
+  if (Filesystem::ReadFile(filepath, &contents) != Filesystem::READ_SUCCESS) {
+    ME_CORE_ERROR("Unable to read mesh {0}", filepath);
+    return false;
+  }
+
+  std::vector<Vector3> positions;
+  // Colors some exporters append to the positions
+  std::vector<Vector4> positionColors;
+  std::vector<bool> hasPositionColor;
+
+  std::unordered_map<std::string, Vector4> materialColors;
+  std::unordered_map<std::string, uint32_t> materialIndices;
+  Vector4 materialColor(1.0f);
+  uint32_t materialIndex = 0;
+
+  // Vertices are shared within a submesh, keyed by their position index
+  std::unordered_map<int64_t, uint32_t> submeshVertices;
+  auto beginSubmesh = [&]() {
+    if (!pData->Submeshes.empty() &&
+        pData->Submeshes.back().IndexCount == 0) {
+      pData->Submeshes.back().MaterialIndex = materialIndex;
+      return;
+    }
+    Submesh submesh;
+    submesh.FirstIndex = (uint32_t)pData->Indices.size();
+    submesh.FirstVertex = (uint32_t)pData->Vertices.size();
+    submesh.MaterialIndex = materialIndex;
+    pData->Submeshes.push_back(submesh);
+    submeshVertices.clear();
+  };
+  beginSubmesh();
+
+  std::istringstream stream(contents);
+  std::string line;
+  std::vector<uint32_t> face;
+  while (std::getline(stream, line)) {
+    std::istringstream tokens(line);
+    std::string keyword;
+    tokens >> keyword;
+    if (keyword == "v") {
+      Vector3 position(0.0f);
+      Vector4 color(1.0f);
+      tokens >> position.x >> position.y >> position.z;
+      positions.push_back(position);
+      hasPositionColor.push_back((bool)(tokens >> color.r >> color.g >>
+                                        color.b));
+      positionColors.push_back(color);
+    } else if (keyword == "f") {
+      face.clear();
+      std::string corner;
+      while (tokens >> corner) {
+        // Only the position of v/vt/vn is used, negative indices count back
+        // from the last position
+        int64_t index = std::stoll(corner.substr(0, corner.find('/')));
+        index = index < 0 ? (int64_t)positions.size() + index : index - 1;
+        if (index < 0 || index >= (int64_t)positions.size()) {
+          ME_CORE_ERROR("Face of {0} references a missing position",
+                        filepath);
+          return false;
+        }
+
+        auto it = submeshVertices.find(index);
+        if (it == submeshVertices.end()) {
+          const Vector4 color = hasPositionColor[index]
+                                    ? positionColors[index]
+                                    : materialColor;
+          it = submeshVertices
+                   .emplace(index, (uint32_t)pData->Vertices.size())
+                   .first;
+          pData->Vertices.emplace_back(positions[index], color);
+        }
+        face.push_back(it->second);
+      }
+
+      // Polygons are triangulated as fans
+      for (size_t i = 2; i < face.size(); i++) {
+        pData->Indices.push_back(face[0]);
+        pData->Indices.push_back(face[i - 1]);
+        pData->Indices.push_back(face[i]);
+        pData->Submeshes.back().IndexCount += 3;
+      }
+    } else if (keyword == "usemtl") {
+      std::string name;
+      tokens >> name;
+      materialIndex =
+          materialIndices.emplace(name, (uint32_t)materialIndices.size())
+              .first->second;
+      auto color = materialColors.find(name);
+      materialColor =
+          color != materialColors.end() ? color->second : Vector4(1.0f);
+      beginSubmesh();
+    } else if (keyword == "o" || keyword == "g") {
+      beginSubmesh();
+    } else if (keyword == "mtllib") {
+      std::string name;
+      tokens >> name;
+      ReadMaterialColors(std::filesystem::path(filepath).parent_path() / name,
+                         &materialColors);
+    }
+  }
+
+  if (pData->Submeshes.back().IndexCount == 0) {
+    pData->Submeshes.pop_back();
+  }
+  return true;
+}
+
+// +======+
+// | GLTF |
+// +======+
+static bool ImportGLTF(const std::string &filepath, MeshData *pData) {
+  cgltf_options options{};
+  cgltf_data *gltf = nullptr;
+  if (cgltf_parse_file(&options, filepath.c_str(), &gltf) !=
+      cgltf_result_success) {
+    ME_CORE_ERROR("Unable to parse glTF file {0}", filepath);
+    return false;
+  }
+  if (cgltf_load_buffers(&options, gltf, filepath.c_str()) !=
+      cgltf_result_success) {
+    ME_CORE_ERROR("Unable to load the buffers of {0}", filepath);
+    cgltf_free(gltf);
+    return false;
+  }
+  // Accessors and views have to stay inside their buffers before any of
+  // them is read
+  if (cgltf_validate(gltf) != cgltf_result_success) {
+    ME_CORE_ERROR("glTF file {0} is invalid", filepath);
+    cgltf_free(gltf);
+    return false;
+  }
+
+  for (size_t n = 0; n < gltf->nodes_count; n++) {
+    const cgltf_node &node = gltf->nodes[n];
+    if (node.mesh == nullptr) {
+      continue;
+    }
+
+    Matrix4 transform;
+    cgltf_node_transform_world(&node, glm::value_ptr(transform));
+    // Mirroring transforms flip the winding of the triangles
+    const bool flipWinding = glm::determinant(transform) < 0.0f;
+
+    for (size_t p = 0; p < node.mesh->primitives_count; p++) {
+      const cgltf_primitive &primitive = node.mesh->primitives[p];
+      if (primitive.type != cgltf_primitive_type_triangles) {
+        continue;
+      }
+
+      const cgltf_accessor *positions = nullptr;
+      const cgltf_accessor *colors = nullptr;
+      for (size_t a = 0; a < primitive.attributes_count; a++) {
+        const cgltf_attribute &attribute = primitive.attributes[a];
+        if (attribute.type == cgltf_attribute_type_position) {
+          positions = attribute.data;
+        } else if (attribute.type == cgltf_attribute_type_color &&
+                   attribute.index == 0) {
+          colors = attribute.data;
+        }
+      }
+      if (positions == nullptr) {
+        continue;
+      }
+
+      Submesh submesh;
+      submesh.FirstIndex = (uint32_t)pData->Indices.size();
+      submesh.FirstVertex = (uint32_t)pData->Vertices.size();
+      Vector4 materialColor(1.0f);
+      if (primitive.material != nullptr) {
+        submesh.MaterialIndex =
+            (uint32_t)(primitive.material - gltf->materials);
+        if (primitive.material->has_pbr_metallic_roughness) {
+          materialColor = glm::make_vec4(
+              primitive.material->pbr_metallic_roughness.base_color_factor);
+        }
+      }
+
+      for (size_t v = 0; v < positions->count; v++) {
+        Vector3 position(0.0f);
+        cgltf_accessor_read_float(positions, v, glm::value_ptr(position), 3);
+        Vector4 color(1.0f);
+        if (colors != nullptr) {
+          cgltf_accessor_read_float(colors, v, glm::value_ptr(color),
+                                    cgltf_num_components(colors->type));
+        }
+        pData->Vertices.emplace_back(
+            Vector3(transform * Vector4(position, 1.0f)),
+            color * materialColor);
+      }
+
+      const size_t indexCount = primitive.indices != nullptr
+                                    ? primitive.indices->count
+                                    : positions->count;
+      for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        uint32_t triangle[3];
+        for (size_t c = 0; c < 3; c++) {
+          const size_t index =
+              primitive.indices != nullptr
+                  ? cgltf_accessor_read_index(primitive.indices, i + c)
+                  : i + c;
+          if (index >= positions->count) {
+            ME_CORE_ERROR("Primitive of {0} references a missing position",
+                          filepath);
+            cgltf_free(gltf);
+            return false;
+          }
+          triangle[c] = (uint32_t)index;
+        }
+        if (flipWinding) {
+          std::swap(triangle[1], triangle[2]);
+        }
+        for (uint32_t index : triangle) {
+          pData->Indices.push_back(submesh.FirstVertex + index);
+        }
+      }
+      submesh.IndexCount =
+          (uint32_t)pData->Indices.size() - submesh.FirstIndex;
+      pData->Submeshes.push_back(submesh);
+    }
+  }
+
+  cgltf_free(gltf);
+  return true;
+}
+
+bool MeshImporter::Import(const std::string &filepath, MeshData *pData) {
+  *pData = MeshData();
+
+  const std::string extension =
+      std::filesystem::path(filepath).extension().string();
+  bool imported;
+  if (extension == ".obj") {
+    imported = ImportOBJ(filepath, pData);
+  } else if (extension == ".gltf" || extension == ".glb") {
+    imported = ImportGLTF(filepath, pData);
+  } else {
+    ME_CORE_ERROR("Unable to import {0}, unknown mesh format", filepath);
+    return false;
+  }
+  if (!imported) {
+    return false;
+  }
+  if (pData->Indices.empty()) {
+    ME_CORE_ERROR("{0} has no triangles", filepath);
+    return false;
+  }
+
+  FinishSubmeshes(pData);
+  return true;
+}
+} // namespace MyEngine
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "MyEngine/Renderer/Mesh.h"
+
+namespace MyEngine {
+class MeshImporter {
+public:
+  // Reads Wavefront OBJ (.obj) and glTF 2.0 (.gltf and .glb) files into one
+  // vertex and index list with a submesh per OBJ object and material or glTF
+  // primitive. Node transforms of glTF scenes are applied to the vertices.
+  // Vertex colors are kept, otherwise the material color is used. Returns
+  // false and logs when the file can't be read.
+  static bool Import(const std::string &filepath, MeshData *pData);
+};
+} // namespace MyEngine
@@ -0,0 +1,118 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/MeshOptimizer.h"
+
+#include <meshoptimizer.h>
+
+namespace MyEngine {
+static void Analyze(const std::vector<Vertex> &vertices,
+                    const std::vector<uint32_t> &indices, float *pAcmr,
+                    float *pAtvr, float *pOverdraw, float *pOverfetch) {
+  if (indices.empty()) {
+    return;
+  }
+
+  meshopt_VertexCacheStatistics cache = meshopt_analyzeVertexCache(
+      indices.data(), indices.size(), vertices.size(),
+      MeshOptimizer::CacheSize, 0, 0);
+  meshopt_OverdrawStatistics overdraw = meshopt_analyzeOverdraw(
+      indices.data(), indices.size(), &vertices[0].Position.x,
+      vertices.size(), sizeof(Vertex));
+  meshopt_VertexFetchStatistics fetch = meshopt_analyzeVertexFetch(
+      indices.data(), indices.size(), vertices.size(), sizeof(Vertex));
+  *pAcmr = cache.acmr;
+  *pAtvr = cache.atvr;
+  *pOverdraw = overdraw.overdraw;
+  *pOverfetch = fetch.overfetch;
+}
+
+static void OptimizeRange(std::vector<Vertex> *pVertices,
+                          std::vector<uint32_t> *pIndices) {
+  std::vector<uint32_t> &indices = *pIndices;
+  const size_t indexCount = indices.size();
+  if (indexCount == 0) {
+    return;
+  }
+
+  // Bitwise identical vertices are merged
+  std::vector<uint32_t> remap(pVertices->size());
+  const size_t vertexCount = meshopt_generateVertexRemap(
+      remap.data(), indices.data(), indexCount, pVertices->data(),
+      pVertices->size(), sizeof(Vertex));
+  std::vector<Vertex> vertices(vertexCount,
+                               Vertex(Vector3(0.0f), Vector4(0.0f)));
+  meshopt_remapIndexBuffer(indices.data(), indices.data(), indexCount,
+                           remap.data());
+  meshopt_remapVertexBuffer(vertices.data(), pVertices->data(),
+                            pVertices->size(), sizeof(Vertex), remap.data());
+
+  meshopt_optimizeVertexCache(indices.data(), indices.data(), indexCount,
+                              vertexCount);
+  meshopt_optimizeOverdraw(indices.data(), indices.data(), indexCount,
+                           &vertices[0].Position.x, vertexCount,
+                           sizeof(Vertex), MeshOptimizer::OverdrawThreshold);
+  // Vertices no triangle references are dropped at the end
+  const size_t fetchedCount = meshopt_optimizeVertexFetch(
+      vertices.data(), indices.data(), indexCount, vertices.data(),
+      vertexCount, sizeof(Vertex));
+  vertices.erase(vertices.begin() + fetchedCount, vertices.end());
+
+  *pVertices = std::move(vertices);
+}
+
+MeshOptimizerStats MeshOptimizer::Optimize(std::vector<Vertex> *pVertices,
+                                           std::vector<uint32_t> *pIndices) {
+  MeshOptimizerStats stats;
+  stats.VerticesBefore = (uint32_t)pVertices->size();
+  Analyze(*pVertices, *pIndices, &stats.AcmrBefore, &stats.AtvrBefore,
+          &stats.OverdrawBefore, &stats.OverfetchBefore);
+
+  OptimizeRange(pVertices, pIndices);
+
+  stats.VerticesAfter = (uint32_t)pVertices->size();
+  Analyze(*pVertices, *pIndices, &stats.AcmrAfter, &stats.AtvrAfter,
+          &stats.OverdrawAfter, &stats.OverfetchAfter);
+  return stats;
+}
+
+MeshOptimizerStats MeshOptimizer::Optimize(MeshData *pData) {
+  MeshOptimizerStats stats;
+  stats.VerticesBefore = (uint32_t)pData->Vertices.size();
+  Analyze(pData->Vertices, pData->Indices, &stats.AcmrBefore,
+          &stats.AtvrBefore, &stats.OverdrawBefore, &stats.OverfetchBefore);
+
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  vertices.reserve(pData->Vertices.size());
+  indices.reserve(pData->Indices.size());
+  for (Submesh &submesh : pData->Submeshes) {
+    auto firstVertex = pData->Vertices.begin() + submesh.FirstVertex;
+    std::vector<Vertex> submeshVertices(firstVertex,
+                                        firstVertex + submesh.VertexCount);
+    std::vector<uint32_t> submeshIndices;
+    submeshIndices.reserve(submesh.IndexCount);
+    for (uint32_t i = 0; i < submesh.IndexCount; i++) {
+      submeshIndices.push_back(pData->Indices[submesh.FirstIndex + i] -
+                               submesh.FirstVertex);
+    }
+
+    OptimizeRange(&submeshVertices, &submeshIndices);
+
+    submesh.FirstIndex = (uint32_t)indices.size();
+    submesh.FirstVertex = (uint32_t)vertices.size();
+    submesh.VertexCount = (uint32_t)submeshVertices.size();
+    for (uint32_t index : submeshIndices) {
+      indices.push_back(submesh.FirstVertex + index);
+    }
+    vertices.insert(vertices.end(), submeshVertices.begin(),
+                    submeshVertices.end());
+  }
+  pData->Vertices = std::move(vertices);
+  pData->Indices = std::move(indices);
+
+  stats.VerticesAfter = (uint32_t)pData->Vertices.size();
+  Analyze(pData->Vertices, pData->Indices, &stats.AcmrAfter, &stats.AtvrAfter,
+          &stats.OverdrawAfter, &stats.OverfetchAfter);
+  return stats;
+}
+} // namespace MyEngine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "MyEngine/Renderer/Mesh.h"
+
+namespace MyEngine {
+struct MeshOptimizerStats {
+  uint32_t VerticesBefore = 0;
+  uint32_t VerticesAfter = 0;
+  // Average vertex shader invocations per triangle
+  float AcmrBefore = 0.0f;
+  float AcmrAfter = 0.0f;
+  // Average vertex shader invocations per vertex, 1 is optimal
+  float AtvrBefore = 0.0f;
+  float AtvrAfter = 0.0f;
+  // Fragments shaded per covered pixel
+  float OverdrawBefore = 0.0f;
+  float OverdrawAfter = 0.0f;
+  // Vertex bytes fetched per vertex byte, 1 is optimal
+  float OverfetchBefore = 0.0f;
+  float OverfetchAfter = 0.0f;
+};
+
+// Reorders geometry for the GPU before it is uploaded, see meshoptimizer:
+// duplicate vertices are merged, triangles are ordered for the post transform
+// vertex cache and then to reduce overdraw, and vertices are reordered in the
+// order the indices fetch them. The rendered result is unchanged.
+class MeshOptimizer {
+public:
+  // Vertex cache size the triangle order is tuned for
+  static constexpr uint32_t CacheSize = 16;
+  // How much worse the vertex cache may get to reduce overdraw
+  static constexpr float OverdrawThreshold = 1.05f;
+
+  // Optimizes one vertex and index list in place
+  static MeshOptimizerStats Optimize(std::vector<Vertex> *pVertices,
+                                     std::vector<uint32_t> *pIndices);
+  // Optimizes every submesh on its own, so they keep their own vertex ranges
+  static MeshOptimizerStats Optimize(MeshData *pData);
+};
+} // namespace MyEngine
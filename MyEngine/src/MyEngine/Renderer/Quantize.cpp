@@ -0,0 +1,135 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/Quantize.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace MyEngine {
+namespace Quantize {
+uint16_t FloatToHalf(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+  const uint32_t mantissa = bits & 0x007FFFFF;
+  const int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 127 + 15;
+
+  // NaN stays NaN, infinity and overflow become infinity
+  if (((bits >> 23) & 0xFF) == 0xFF) {
+    return sign | 0x7C00 | (mantissa != 0 ? 0x0200 : 0);
+  }
+  if (exponent >= 31) {
+    return sign | 0x7C00;
+  }
+
+  // Denormal halves, or zero when even those are too small
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    const uint32_t full = mantissa | 0x00800000;
+    const uint32_t shift = (uint32_t)(14 - exponent);
+    uint32_t half = full >> shift;
+    const uint32_t rest = full & ((1u << shift) - 1);
+    const uint32_t midpoint = 1u << (shift - 1);
+    if (rest > midpoint || (rest == midpoint && (half & 1))) {
+      half++;
+    }
+    return sign | (uint16_t)half;
+  }
+
+  // Round to nearest even, a carry out of the mantissa raises the exponent
+  uint32_t half = ((uint32_t)exponent << 10) | (mantissa >> 13);
+  const uint32_t rest = mantissa & 0x1FFF;
+  if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+    half++;
+  }
+  return sign | (uint16_t)half;
+}
+
+float HalfToFloat(uint16_t value) {
+  const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1F;
+  uint32_t mantissa = value & 0x03FF;
+
+  uint32_t bits;
+  if (exponent == 0x1F) {
+    bits = sign | 0x7F800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Denormal half, normalize it for the float
+    int32_t shift = 0;
+    while ((mantissa & 0x0400) == 0) {
+      mantissa <<= 1;
+      shift++;
+    }
+    bits = sign | ((uint32_t)(127 - 14 - shift) << 23) |
+           ((mantissa & 0x03FF) << 13);
+  }
+
+  float result;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+int8_t ToSnorm8(float value) {
+  return (int8_t)std::lround(glm::clamp(value, -1.0f, 1.0f) * 127.0f);
+}
+
+int16_t ToSnorm16(float value) {
+  return (int16_t)std::lround(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+uint8_t ToUnorm8(float value) {
+  return (uint8_t)std::lround(glm::clamp(value, 0.0f, 1.0f) * 255.0f);
+}
+
+uint32_t ToUnorm8x4(const Vector4 &color) {
+  return (uint32_t)ToUnorm8(color.r) | ((uint32_t)ToUnorm8(color.g) << 8) |
+         ((uint32_t)ToUnorm8(color.b) << 16) |
+         ((uint32_t)ToUnorm8(color.a) << 24);
+}
+
+Vector4 FromUnorm8x4(uint32_t color) {
+  return Vector4(FromUnorm8(color & 0xFF), FromUnorm8((color >> 8) & 0xFF),
+                 FromUnorm8((color >> 16) & 0xFF), FromUnorm8(color >> 24));
+}
+
+static Vector2 SignNotZero(const Vector2 &v) {
+  return Vector2(v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f);
+}
+
+Vector2 OctahedralEncode(const Vector3 &normal) {
+  const float length =
+      std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+  if (length == 0.0f) {
+    return Vector2(0.0f);
+  }
+
+  Vector2 encoded = Vector2(normal.x, normal.y) / length;
+  // The lower half is folded over the diagonals
+  if (normal.z < 0.0f) {
+    encoded = (1.0f - Vector2(std::abs(encoded.y), std::abs(encoded.x))) *
+              SignNotZero(encoded);
+  }
+  return encoded;
+}
+
+Vector3 OctahedralDecode(const Vector2 &encoded) {
+  Vector3 normal(encoded.x, encoded.y,
+                 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+  if (normal.z < 0.0f) {
+    const Vector2 folded =
+        (1.0f - Vector2(std::abs(normal.y), std::abs(normal.x))) *
+        SignNotZero(Vector2(normal.x, normal.y));
+    normal.x = folded.x;
+    normal.y = folded.y;
+  }
+  return glm::normalize(normal);
+}
+} // namespace Quantize
+} // namespace MyEngine
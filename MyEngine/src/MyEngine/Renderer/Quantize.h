@@ -0,0 +1,38 @@
+#pragma once
+
+#include "MyEngine/Math/Math.h"
+
+#include <cstdint>
+
+namespace MyEngine {
+// Conversions between floats and the compact vertex attribute types of
+// ShaderDataType. Normalized integers map [-1, 1] (signed) or [0, 1]
+// (unsigned) to their whole range, the GPU converts them back on fetch.
+namespace Quantize {
+// IEEE half float, rounded to nearest. Values too large for a half become
+// infinity, values too small become zero.
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+
+int8_t ToSnorm8(float value);
+int16_t ToSnorm16(float value);
+uint8_t ToUnorm8(float value);
+inline float FromSnorm8(int8_t value) {
+  return value < -127 ? -1.0f : value / 127.0f;
+}
+inline float FromSnorm16(int16_t value) {
+  return value < -32767 ? -1.0f : value / 32767.0f;
+}
+inline float FromUnorm8(uint8_t value) { return value / 255.0f; }
+
+// RGBA color in one UByte4, red in the lowest byte
+uint32_t ToUnorm8x4(const Vector4 &color);
+Vector4 FromUnorm8x4(uint32_t color);
+
+// Maps a unit vector onto the octahedron unfolded into [-1, 1]^2, so normals
+// fit two components. Store the result as a normalized Short2 (or two bytes of
+// a Byte4) and decode it in the shader with OctahedralDecode.
+Vector2 OctahedralEncode(const Vector3 &normal);
+Vector3 OctahedralDecode(const Vector2 &encoded);
+} // namespace Quantize
+} // namespace MyEngine
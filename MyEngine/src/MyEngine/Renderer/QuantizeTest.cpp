@@ -0,0 +1,81 @@
+#include "MyEngine/Renderer/Quantize.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+#include <limits>
+
+namespace MyEngine {
+TEST(QuantizeTest, HalvesRoundTrip) {
+  for (uint32_t half = 0; half <= 0xFFFF; half++) {
+    const float value = Quantize::HalfToFloat((uint16_t)half);
+    if (std::isnan(value)) {
+      EXPECT_TRUE(std::isnan(
+          Quantize::HalfToFloat(Quantize::FloatToHalf(value))));
+      continue;
+    }
+    EXPECT_EQ(Quantize::FloatToHalf(value), half) << value;
+  }
+}
+
+TEST(QuantizeTest, HalvesOfFloats) {
+  EXPECT_EQ(Quantize::FloatToHalf(1.0f), 0x3C00);
+  EXPECT_EQ(Quantize::FloatToHalf(-2.0f), 0xC000);
+  EXPECT_EQ(Quantize::FloatToHalf(-0.0f), 0x8000);
+  // Largest half, and the first value rounding past it
+  EXPECT_EQ(Quantize::FloatToHalf(65504.0f), 0x7BFF);
+  EXPECT_EQ(Quantize::FloatToHalf(65520.0f), 0x7C00);
+  EXPECT_EQ(Quantize::FloatToHalf(1e10f), 0x7C00);
+  EXPECT_EQ(Quantize::FloatToHalf(-std::numeric_limits<float>::infinity()),
+            0xFC00);
+  // Smallest denormal half, and values below half of it
+  EXPECT_EQ(Quantize::FloatToHalf(std::ldexp(1.0f, -24)), 0x0001);
+  EXPECT_EQ(Quantize::FloatToHalf(std::ldexp(1.0f, -26)), 0x0000);
+  EXPECT_EQ(Quantize::FloatToHalf(-1e-10f), 0x8000);
+}
+
+TEST(QuantizeTest, HalvesRoundToNearestEven) {
+  // Ties go to the even mantissa
+  EXPECT_EQ(Quantize::FloatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);
+  EXPECT_EQ(Quantize::FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)),
+            0x3C02);
+  EXPECT_EQ(Quantize::FloatToHalf(1.0f + std::ldexp(1.0f, -11) +
+                                  std::ldexp(1.0f, -20)),
+            0x3C01);
+  // Rounding up out of the mantissa raises the exponent
+  EXPECT_EQ(Quantize::FloatToHalf(2.0f - std::ldexp(1.0f, -12)), 0x4000);
+  // Same for denormals, up into the normal range
+  EXPECT_EQ(Quantize::FloatToHalf(std::ldexp(1.5f, -24)), 0x0002);
+  EXPECT_EQ(Quantize::FloatToHalf(std::ldexp(1.0f, -14) -
+                                  std::ldexp(1.0f, -26)),
+            0x0400);
+}
+
+TEST(QuantizeTest, OctahedralNormalsRoundTrip) {
+  // Every octant and the axes, where the folding changes sides
+  const int steps = 16;
+  for (int i = 0; i <= steps; i++) {
+    for (int j = 0; j < 2 * steps; j++) {
+      const float theta = glm::pi<float>() * i / steps;
+      const float phi = glm::pi<float>() * j / steps;
+      const Vector3 normal(std::sin(theta) * std::cos(phi),
+                           std::sin(theta) * std::sin(phi), std::cos(theta));
+
+      const Vector2 encoded = Quantize::OctahedralEncode(normal);
+      EXPECT_LE(std::abs(encoded.x), 1.0f);
+      EXPECT_LE(std::abs(encoded.y), 1.0f);
+      EXPECT_GT(glm::dot(Quantize::OctahedralDecode(encoded), normal),
+                0.99999f);
+
+      // As stored in a normalized Short2
+      const Vector2 stored(
+          Quantize::FromSnorm16(Quantize::ToSnorm16(encoded.x)),
+          Quantize::FromSnorm16(Quantize::ToSnorm16(encoded.y)));
+      EXPECT_GT(glm::dot(Quantize::OctahedralDecode(stored), normal),
+                0.9999f);
+    }
+  }
+}
+} // namespace MyEngine
@@ -0,0 +1,76 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/RangeAllocator.h"
+
+namespace MyEngine {
+RangeAllocator::RangeAllocator(uint32_t capacity) : m_Capacity(capacity) {
+  if (capacity > 0) {
+    AddFreeRange(0, capacity);
+  }
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t size) {
+  if (size == 0) {
+    return 0;
+  }
+
+  auto best = m_FreeBySize.lower_bound(size);
+  if (best == m_FreeBySize.end()) {
+    return InvalidOffset;
+  }
+
+  // The rest of the range stays free
+  const uint32_t offset = best->second;
+  const uint32_t freeSize = best->first;
+  RemoveFreeRange(m_FreeByOffset.find(offset));
+  if (freeSize > size) {
+    AddFreeRange(offset + size, freeSize - size);
+  }
+  return offset;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size) {
+  if (size == 0) {
+    return;
+  }
+
+  // Merged with the free ranges ending at offset and starting at its end
+  auto next = m_FreeByOffset.lower_bound(offset);
+  if (next != m_FreeByOffset.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset) {
+      offset = previous->first;
+      size += previous->second;
+      RemoveFreeRange(previous);
+    }
+  }
+  if (next != m_FreeByOffset.end() && offset + size == next->first) {
+    size += next->second;
+    RemoveFreeRange(next);
+  }
+  AddFreeRange(offset, size);
+}
+
+uint32_t RangeAllocator::GetLargestFreeRange() const {
+  return m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+}
+
+void RangeAllocator::AddFreeRange(uint32_t offset, uint32_t size) {
+  m_FreeByOffset.emplace(offset, size);
+  m_FreeBySize.emplace(size, offset);
+  m_FreeSize += size;
+}
+
+void RangeAllocator::RemoveFreeRange(
+    std::map<uint32_t, uint32_t>::iterator it) {
+  auto [first, last] = m_FreeBySize.equal_range(it->second);
+  for (auto bySize = first; bySize != last; bySize++) {
+    if (bySize->second == it->first) {
+      m_FreeBySize.erase(bySize);
+      break;
+    }
+  }
+  m_FreeSize -= it->second;
+  m_FreeByOffset.erase(it);
+}
+} // namespace MyEngine
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace MyEngine {
+// Hands out ranges of [0, capacity), like the vertices or indices of a large
+// buffer. Picks the smallest free range that fits, and a freed range is merged
+// with the free ranges next to it, so free space stays in as few pieces as
+// possible.
+class RangeAllocator {
+public:
+  static constexpr uint32_t InvalidOffset = UINT32_MAX;
+
+  RangeAllocator(uint32_t capacity = 0);
+
+  // InvalidOffset when no free range is large enough
+  uint32_t Allocate(uint32_t size);
+  void Free(uint32_t offset, uint32_t size);
+
+  uint32_t GetCapacity() const { return m_Capacity; }
+  uint32_t GetFreeSize() const { return m_FreeSize; }
+  uint32_t GetLargestFreeRange() const;
+
+private:
+  void AddFreeRange(uint32_t offset, uint32_t size);
+  void RemoveFreeRange(std::map<uint32_t, uint32_t>::iterator it);
+
+  uint32_t m_Capacity;
+  uint32_t m_FreeSize = 0;
+  // Free ranges by offset and by size, both hold every free range
+  std::map<uint32_t, uint32_t> m_FreeByOffset;
+  std::multimap<uint32_t, uint32_t> m_FreeBySize;
+};
+} // namespace MyEngine
@@ -0,0 +1,81 @@
+#include "MyEngine/Renderer/RangeAllocator.h"
+
+#include <gtest/gtest.h>
+
+namespace MyEngine {
+TEST(RangeAllocatorTest, AllocatesInOrder) {
+  RangeAllocator allocator(100);
+  EXPECT_EQ(allocator.Allocate(10), 0);
+  EXPECT_EQ(allocator.Allocate(20), 10);
+  EXPECT_EQ(allocator.Allocate(70), 30);
+  EXPECT_EQ(allocator.GetFreeSize(), 0);
+  EXPECT_EQ(allocator.GetLargestFreeRange(), 0);
+  EXPECT_EQ(allocator.Allocate(1), RangeAllocator::InvalidOffset);
+  EXPECT_EQ(allocator.GetCapacity(), 100);
+}
+
+TEST(RangeAllocatorTest, MergesFreedNeighbours) {
+  RangeAllocator allocator(100);
+  const uint32_t a = allocator.Allocate(10);
+  const uint32_t b = allocator.Allocate(10);
+  const uint32_t c = allocator.Allocate(10);
+  allocator.Allocate(70);
+
+  // Apart until the range between them is freed
+  allocator.Free(a, 10);
+  allocator.Free(c, 10);
+  EXPECT_EQ(allocator.GetFreeSize(), 20);
+  EXPECT_EQ(allocator.GetLargestFreeRange(), 10);
+  EXPECT_EQ(allocator.Allocate(20), RangeAllocator::InvalidOffset);
+
+  allocator.Free(b, 10);
+  EXPECT_EQ(allocator.GetFreeSize(), 30);
+  EXPECT_EQ(allocator.GetLargestFreeRange(), 30);
+  EXPECT_EQ(allocator.Allocate(30), a);
+}
+
+TEST(RangeAllocatorTest, MergesBackIntoTheWholeCapacity) {
+  RangeAllocator allocator(100);
+  uint32_t offsets[10];
+  for (uint32_t &offset : offsets) {
+    offset = allocator.Allocate(10);
+  }
+  // Every other range first, then the ones between them
+  for (uint32_t i = 0; i < 10; i += 2) {
+    allocator.Free(offsets[i], 10);
+  }
+  EXPECT_EQ(allocator.GetLargestFreeRange(), 10);
+  for (uint32_t i = 1; i < 10; i += 2) {
+    allocator.Free(offsets[i], 10);
+  }
+  EXPECT_EQ(allocator.GetFreeSize(), 100);
+  EXPECT_EQ(allocator.GetLargestFreeRange(), 100);
+  EXPECT_EQ(allocator.Allocate(100), 0);
+}
+
+TEST(RangeAllocatorTest, PicksTheSmallestRangeThatFits) {
+  RangeAllocator allocator(100);
+  const uint32_t large = allocator.Allocate(30);
+  allocator.Allocate(10);
+  const uint32_t small = allocator.Allocate(15);
+  allocator.Allocate(45);
+  allocator.Free(large, 30);
+  allocator.Free(small, 15);
+
+  // The large range stays whole for larger allocations
+  EXPECT_EQ(allocator.Allocate(12), small);
+  EXPECT_EQ(allocator.Allocate(3), small + 12);
+  EXPECT_EQ(allocator.Allocate(30), large);
+}
+
+TEST(RangeAllocatorTest, EmptyRanges) {
+  RangeAllocator allocator(10);
+  EXPECT_EQ(allocator.Allocate(0), 0);
+  allocator.Free(0, 0);
+  EXPECT_EQ(allocator.GetFreeSize(), 10);
+
+  RangeAllocator none;
+  EXPECT_EQ(none.GetLargestFreeRange(), 0);
+  EXPECT_EQ(none.Allocate(1), RangeAllocator::InvalidOffset);
+}
+} // namespace MyEngine
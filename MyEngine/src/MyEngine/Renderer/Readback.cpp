@@ -0,0 +1,79 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/Readback.h"
+
+#include "MyEngine/Renderer/Renderer.h"
+#include "Platform/Null/NullReadback.h"
+#include "Platform/Software/SoftwareReadback.h"
+#include "Platform/Vulkan/VulkanReadback.h"
+
+namespace MyEngine {
+Ref<Readback> Readback::Create(const Ref<VertexBuffer> &buffer,
+                               uint32_t offset, uint32_t size) {
+  Ref<Readback> readback;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    readback = CreateRef<VulkanReadback>(buffer, offset, size);
+  } break;
+  case RendererAPI::API::Null: {
+    readback = CreateRef<NullReadback>(size);
+  } break;
+  case RendererAPI::API::Software: {
+    readback = CreateRef<SoftwareReadback>(buffer, offset, size);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
+  }
+
+  return readback;
+}
+
+Ref<Readback> Readback::Create(const Ref<IndexBuffer> &buffer, uint32_t offset,
+                               uint32_t count) {
+  Ref<Readback> readback;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    readback = CreateRef<VulkanReadback>(buffer, offset, count);
+  } break;
+  case RendererAPI::API::Null: {
+    readback = CreateRef<NullReadback>(sizeof(uint32_t) * count);
+  } break;
+  case RendererAPI::API::Software: {
+    readback = CreateRef<SoftwareReadback>(buffer, offset, count);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
+  }
+
+  return readback;
+}
+
+Ref<Readback> Readback::Create(const Ref<Texture2D> &texture) {
+  Ref<Readback> readback;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    readback = CreateRef<VulkanReadback>(texture);
+  } break;
+  case RendererAPI::API::Null: {
+    readback = CreateRef<NullReadback>(texture->GetWidth(),
+                                       texture->GetHeight());
+  } break;
+  case RendererAPI::API::Software: {
+    readback = CreateRef<SoftwareReadback>(texture);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
+  }
+
+  return readback;
+}
+} // namespace MyEngine
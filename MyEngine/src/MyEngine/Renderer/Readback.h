@@ -0,0 +1,56 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Core/Span.h"
+#include "MyEngine/Renderer/Buffer.h"
+#include "MyEngine/Renderer/Texture.h"
+
+namespace MyEngine {
+// Copy of GPU memory that arrives a few frames after it was requested. The
+// copy is recorded at the end of the frame, after its draws, and the data can
+// be read once the GPU finished that frame. Nothing ever waits for the GPU,
+// poll IsReady each frame and keep the handle alive until then:
+//
+//   m_Readback = Readback::Create(buffer, 0, size);
+//   ...
+//   if (m_Readback && m_Readback->IsReady()) {
+//     Span<const uint32_t> ids = m_Readback->GetDataAs<uint32_t>();
+//   }
+//
+// Data set on the buffer in the frame of the request reaches the GPU with the
+// next frame, so it isn't part of the copy. Vertex buffers, index buffers and
+// textures can be read back.
+class Readback {
+public:
+  virtual ~Readback() = default;
+
+  // Never blocks
+  virtual bool IsReady() const = 0;
+  // Empty until ready
+  virtual Span<const uint8_t> GetData() const = 0;
+  template <typename T> Span<const T> GetDataAs() const {
+    const Span<const uint8_t> data = GetData();
+    return Span<const T>(reinterpret_cast<const T *>(data.data()),
+                         data.size() / sizeof(T));
+  }
+
+  // Size of texture readbacks once they are ready, 0 for buffers
+  uint32_t GetWidth() const { return m_Width; }
+  uint32_t GetHeight() const { return m_Height; }
+
+  // size bytes of the buffer starting at offset
+  static Ref<Readback> Create(const Ref<VertexBuffer> &buffer, uint32_t offset,
+                              uint32_t size);
+  // count indices starting at offset, read as 32 bit indices whatever the
+  // buffer stores them as
+  static Ref<Readback> Create(const Ref<IndexBuffer> &buffer, uint32_t offset,
+                              uint32_t count);
+  // Largest mip the texture holds on the GPU at the end of the frame, tightly
+  // packed in its format. Empty when the texture isn't loaded by then.
+  static Ref<Readback> Create(const Ref<Texture2D> &texture);
+
+protected:
+  uint32_t m_Width = 0;
+  uint32_t m_Height = 0;
+};
+} // namespace MyEngine
@@ -0,0 +1,790 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/RenderCapture.h"
+
+#include "MyEngine/Filesystem/Filesystem.h"
+#include "MyEngine/Renderer/Renderer.h"
+
+#include <cstring>
+
+namespace MyEngine {
+static constexpr char s_Magic[4] = {'M', 'E', 'R', 'C'};
+static constexpr uint16_t s_Version = 5;
+static constexpr size_t s_HeaderSize = 8;
+
+struct RenderCaptureData {
+  std::ofstream Out;
+  std::vector<uint8_t> Buffer;
+  uint32_t FrameLimit = 0;
+  uint32_t FrameCount = 0;
+
+  uint32_t NextId = 1;
+  std::unordered_map<const void *, uint32_t> Ids;
+  // Buffer ids last written for every vertex array, a vertex array is
+  // re-described when it is submitted with different buffers.
+  std::unordered_map<uint32_t, std::vector<uint32_t>> VertexArrayBuffers;
+};
+
+bool RenderCapture::s_Capturing = false;
+static RenderCaptureData s_Data;
+
+template <typename T> static void Write(const T &value) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+  s_Data.Buffer.insert(s_Data.Buffer.end(), bytes, bytes + sizeof(T));
+}
+
+static void WriteBytes(const void *data, size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  s_Data.Buffer.insert(s_Data.Buffer.end(), bytes, bytes + size);
+}
+
+static void WriteString(const std::string &value) {
+  Write<uint32_t>((uint32_t)value.size());
+  WriteBytes(value.data(), value.size());
+}
+
+static void WriteRecord(RenderCaptureRecord record) {
+  Write<uint8_t>((uint8_t)record);
+}
+
+static uint32_t AssignId(const void *resource) {
+  uint32_t id = s_Data.NextId++;
+  s_Data.Ids[resource] = id;
+  return id;
+}
+
+static uint32_t GetId(const void *resource) {
+  auto it = s_Data.Ids.find(resource);
+  return it != s_Data.Ids.end() ? it->second : 0;
+}
+
+static void Flush() {
+  s_Data.Out.write((const char *)s_Data.Buffer.data(), s_Data.Buffer.size());
+  s_Data.Buffer.clear();
+}
+
+bool RenderCapture::Begin(const std::string &path, uint32_t frameCount) {
+  ME_CORE_ASSERT(!s_Capturing, "A render capture is already running!");
+
+  s_Data.Out.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!s_Data.Out.is_open()) {
+    ME_CORE_ERROR("Unable to open render capture {0}", path);
+    return false;
+  }
+
+  s_Data.FrameLimit = frameCount;
+  s_Data.FrameCount = 0;
+  WriteBytes(s_Magic, sizeof(s_Magic));
+  Write<uint16_t>(s_Version);
+  Write<uint16_t>(0);
+
+  s_Capturing = true;
+  ME_CORE_INFO("Capturing render commands to {0}", path);
+  return true;
+}
+
+void RenderCapture::End() {
+  if (!s_Capturing) {
+    return;
+  }
+
+  Flush();
+  s_Data.Out.close();
+  ME_CORE_INFO("Render capture finished after {0} frames", s_Data.FrameCount);
+
+  s_Capturing = false;
+  s_Data = RenderCaptureData();
+}
+
+void RenderCapture::OnBeginFrame() {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::BeginFrame);
+}
+
+void RenderCapture::OnEndFrame() {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::EndFrame);
+  Flush();
+
+  s_Data.FrameCount++;
+  if (s_Data.FrameLimit > 0 && s_Data.FrameCount >= s_Data.FrameLimit) {
+    End();
+  }
+}
+
+void RenderCapture::OnCreateVertexBuffer(const VertexBuffer *buffer,
+                                         const void *data, uint32_t count,
+                                         uint32_t size) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::CreateVertexBuffer);
+  Write<uint32_t>(AssignId(buffer));
+  Write<uint32_t>(count);
+  Write<uint32_t>(size);
+  Write<uint8_t>(data != nullptr);
+  if (data != nullptr) {
+    WriteBytes(data, size);
+  }
+}
+
+void RenderCapture::OnCreateIndexBuffer(const IndexBuffer *buffer,
+                                        const uint32_t *indices,
+                                        uint32_t count, IndexFormat format) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::CreateIndexBuffer);
+  Write<uint32_t>(AssignId(buffer));
+  Write<uint32_t>(count);
+  Write<uint8_t>((uint8_t)format);
+  Write<uint8_t>(indices != nullptr);
+  if (indices != nullptr) {
+    WriteBytes(indices, sizeof(uint32_t) * count);
+  }
+}
+
+void RenderCapture::OnCreateShaderStage(const ShaderStage *stage,
+                                        const std::string &filepath,
+                                        ShaderStage::StageType type) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::CreateShaderStage);
+  Write<uint32_t>(AssignId(stage));
+  Write<uint8_t>((uint8_t)type);
+  WriteString(filepath);
+}
+
+void RenderCapture::OnCreateShader(
+    const Shader *shader, const std::string &name,
+    const std::vector<Ref<ShaderStage>> &stages) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::CreateShader);
+  Write<uint32_t>(AssignId(shader));
+  WriteString(name);
+  Write<uint32_t>((uint32_t)stages.size());
+  for (const Ref<ShaderStage> &stage : stages) {
+    Write<uint32_t>(GetId(stage.get()));
+  }
+}
+
+void RenderCapture::OnCreateVertexArray(const VertexArray *vertexArray) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::CreateVertexArray);
+  Write<uint32_t>(AssignId(vertexArray));
+}
+
+void RenderCapture::OnVertexBufferData(const VertexBuffer *buffer,
+                                       const void *data, uint32_t offset,
+                                       uint32_t size) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::VertexBufferData);
+  Write<uint32_t>(GetId(buffer));
+  Write<uint32_t>(offset);
+  Write<uint32_t>(size);
+  WriteBytes(data, size);
+}
+
+void RenderCapture::OnIndexBufferData(const IndexBuffer *buffer,
+                                      const uint32_t *indices,
+                                      uint32_t offset, uint32_t count) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::IndexBufferData);
+  Write<uint32_t>(GetId(buffer));
+  Write<uint32_t>(offset);
+  Write<uint32_t>(count);
+  WriteBytes(indices, sizeof(uint32_t) * count);
+}
+
+void RenderCapture::OnSubmit(const Ref<Shader> &shader,
+                             const Ref<VertexArray> &vertexArray,
+                             const DrawRange &range) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  uint32_t vertexArrayId = GetId(vertexArray.get());
+
+  // Vertex arrays are assembled through the backend, describe them lazily
+  // the first time they are drawn or whenever their buffers changed.
+  std::vector<uint32_t> bufferIds;
+  for (const Ref<VertexBuffer> &buffer : vertexArray->GetVertexBuffers()) {
+    bufferIds.push_back(GetId(buffer.get()));
+  }
+  bufferIds.push_back(GetId(vertexArray->GetIndexBuffer().get()));
+
+  auto it = s_Data.VertexArrayBuffers.find(vertexArrayId);
+  if (it == s_Data.VertexArrayBuffers.end() || it->second != bufferIds) {
+    WriteRecord(RenderCaptureRecord::SetVertexArrayBuffers);
+    Write<uint32_t>(vertexArrayId);
+    Write<uint32_t>((uint32_t)vertexArray->GetVertexBuffers().size());
+    for (const Ref<VertexBuffer> &buffer : vertexArray->GetVertexBuffers()) {
+      const BufferLayout &layout = buffer->GetLayout();
+      Write<uint32_t>(GetId(buffer.get()));
+      Write<uint32_t>((uint32_t)layout.GetElements().size());
+      for (const BufferElement &element : layout) {
+        Write<uint8_t>((uint8_t)element.Type);
+        Write<uint8_t>(element.Normalized);
+        WriteString(element.Name);
+      }
+    }
+    Write<uint32_t>(bufferIds.back());
+    s_Data.VertexArrayBuffers[vertexArrayId] = std::move(bufferIds);
+  }
+
+  WriteRecord(RenderCaptureRecord::Submit);
+  Write<uint32_t>(GetId(shader.get()));
+  Write<uint32_t>(vertexArrayId);
+  Write<uint32_t>(range.FirstIndex);
+  Write<uint32_t>(range.IndexCount);
+  Write<int32_t>(range.VertexOffset);
+}
+
+void RenderCapture::OnSetShaderData(const Shader *shader,
+                                    const std::string &name,
+                                    ShaderDataType type, const void *data,
+                                    uint32_t count) {
+  if (!s_Capturing) {
+    return;
+  }
+
+  WriteRecord(RenderCaptureRecord::SetShaderData);
+  Write<uint32_t>(GetId(shader));
+  Write<uint8_t>((uint8_t)type);
+  WriteString(name);
+  Write<uint32_t>(count);
+  WriteBytes(data, ShaderDataTypeSize(type) * count);
+}
+
+// +==========+
+// | REPLAYER |
+// +==========+
+template <typename T> T RenderCaptureReplayer::Read() {
+  T value{};
+  const uint8_t *bytes = ReadBytes(sizeof(T));
+  if (bytes != nullptr) {
+    memcpy(&value, bytes, sizeof(T));
+  }
+  return value;
+}
+
+const uint8_t *RenderCaptureReplayer::ReadBytes(size_t size) {
+  // Compared against the bytes left so huge sizes can't wrap around
+  if (m_Truncated || size > m_Buffer.size() - m_Offset) {
+    m_Truncated = true;
+    return nullptr;
+  }
+
+  const uint8_t *bytes = m_Buffer.data() + m_Offset;
+  m_Offset += size;
+  return bytes;
+}
+
+std::string RenderCaptureReplayer::ReadString() {
+  uint32_t size = Read<uint32_t>();
+  const uint8_t *bytes = ReadBytes(size);
+  return bytes != nullptr ? std::string((const char *)bytes, size) : "";
+}
+
+template <typename T>
+static const Ref<T> *FindResource(std::unordered_map<uint32_t, Ref<T>> &map,
+                                  uint32_t id, const char *kind) {
+  auto it = map.find(id);
+  if (it == map.end()) {
+    ME_CORE_ERROR("Corrupted render capture, unknown {0} {1}", kind, id);
+    return nullptr;
+  }
+  return &it->second;
+}
+
+static bool IsValidDataType(ShaderDataType type) {
+  return type > ShaderDataType::None && type <= ShaderDataType::Half4;
+}
+
+bool RenderCaptureReplayer::Load(const std::string &path) {
+  std::string contents;
+  Filesystem::FsReadStatus status = Filesystem::ReadFile(path, &contents);
+  if (status != Filesystem::READ_SUCCESS) {
+    ME_CORE_ERROR("Unable to read render capture {0}: {1}", path,
+                  Filesystem::FsReadStatusToString(status));
+    return false;
+  }
+
+  if (contents.size() < s_HeaderSize ||
+      memcmp(contents.data(), s_Magic, sizeof(s_Magic)) != 0) {
+    ME_CORE_ERROR("{0} is not a render capture", path);
+    return false;
+  }
+
+  uint16_t version;
+  memcpy(&version, contents.data() + 4, sizeof(version));
+  if (version != s_Version) {
+    ME_CORE_ERROR("Render capture {0} has version {1}, expected {2}", path,
+                  version, s_Version);
+    return false;
+  }
+
+  m_Buffer.assign(contents.begin(), contents.end());
+  m_Offset = s_HeaderSize;
+  m_Truncated = false;
+  m_VertexBuffers.clear();
+  m_IndexBuffers.clear();
+  m_ShaderStages.clear();
+  m_Shaders.clear();
+  m_VertexArrays.clear();
+
+  // Walk every record first, so a truncated capture fails here instead of in
+  // the middle of a replay. Payload bytes may look like any record, frames
+  // are counted by their records only.
+  m_FrameCount = 0;
+  m_FirstFrameOffset = m_Buffer.size();
+  while (m_Offset < m_Buffer.size()) {
+    const size_t recordOffset = m_Offset;
+    RenderCaptureRecord record = (RenderCaptureRecord)Read<uint8_t>();
+    if (!SkipRecord(record)) {
+      ME_CORE_ERROR("Unable to load render capture {0}", path);
+      return false;
+    }
+    if (record == RenderCaptureRecord::BeginFrame &&
+        m_FirstFrameOffset == m_Buffer.size()) {
+      m_FirstFrameOffset = recordOffset;
+    }
+    m_FrameCount += record == RenderCaptureRecord::EndFrame;
+  }
+
+  // Create everything that exists before the first frame
+  m_Offset = s_HeaderSize;
+  while (m_Offset < m_FirstFrameOffset) {
+    RenderCaptureRecord record = (RenderCaptureRecord)Read<uint8_t>();
+    if (!ExecuteRecord(record)) {
+      ME_CORE_ERROR("Unable to load render capture {0}", path);
+      return false;
+    }
+  }
+
+  ME_CORE_INFO("Loaded render capture {0}", path);
+  return true;
+}
+
+bool RenderCaptureReplayer::ReplayFrame() {
+  if (m_Offset >= m_Buffer.size()) {
+    return false;
+  }
+
+  while (m_Offset < m_Buffer.size()) {
+    RenderCaptureRecord record = (RenderCaptureRecord)Read<uint8_t>();
+    if (record == RenderCaptureRecord::EndFrame) {
+      return true;
+    }
+    if (!ExecuteRecord(record)) {
+      m_Offset = m_Buffer.size();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool RenderCaptureReplayer::SkipRecord(RenderCaptureRecord record) {
+  switch (record) {
+  case RenderCaptureRecord::BeginFrame:
+  case RenderCaptureRecord::EndFrame:
+    break;
+  case RenderCaptureRecord::CreateVertexBuffer: {
+    ReadBytes(sizeof(uint32_t) * 2);
+    uint32_t size = Read<uint32_t>();
+    if (Read<uint8_t>()) {
+      ReadBytes(size);
+    }
+  } break;
+  case RenderCaptureRecord::CreateIndexBuffer: {
+    ReadBytes(sizeof(uint32_t));
+    uint32_t count = Read<uint32_t>();
+    ReadBytes(sizeof(uint8_t));
+    if (Read<uint8_t>()) {
+      ReadBytes(sizeof(uint32_t) * (size_t)count);
+    }
+  } break;
+  case RenderCaptureRecord::CreateShaderStage:
+    ReadBytes(sizeof(uint32_t) + sizeof(uint8_t));
+    ReadString();
+    break;
+  case RenderCaptureRecord::CreateShader: {
+    ReadBytes(sizeof(uint32_t));
+    ReadString();
+    uint32_t stageCount = Read<uint32_t>();
+    ReadBytes(sizeof(uint32_t) * (size_t)stageCount);
+  } break;
+  case RenderCaptureRecord::CreateVertexArray:
+    ReadBytes(sizeof(uint32_t));
+    break;
+  case RenderCaptureRecord::SetVertexArrayBuffers: {
+    ReadBytes(sizeof(uint32_t));
+    uint32_t bufferCount = Read<uint32_t>();
+    for (uint32_t i = 0; i < bufferCount && !m_Truncated; i++) {
+      ReadBytes(sizeof(uint32_t));
+      uint32_t elementCount = Read<uint32_t>();
+      for (uint32_t e = 0; e < elementCount && !m_Truncated; e++) {
+        ReadBytes(sizeof(uint8_t) * 2);
+        ReadString();
+      }
+    }
+    ReadBytes(sizeof(uint32_t));
+  } break;
+  case RenderCaptureRecord::VertexBufferData: {
+    ReadBytes(sizeof(uint32_t) * 2);
+    uint32_t size = Read<uint32_t>();
+    ReadBytes(size);
+  } break;
+  case RenderCaptureRecord::IndexBufferData: {
+    ReadBytes(sizeof(uint32_t) * 2);
+    uint32_t count = Read<uint32_t>();
+    ReadBytes(sizeof(uint32_t) * (size_t)count);
+  } break;
+  case RenderCaptureRecord::Submit:
+    ReadBytes(sizeof(uint32_t) * 4 + sizeof(int32_t));
+    break;
+  case RenderCaptureRecord::SetShaderData: {
+    ReadBytes(sizeof(uint32_t));
+    ShaderDataType type = (ShaderDataType)Read<uint8_t>();
+    ReadString();
+    uint32_t count = Read<uint32_t>();
+    if (!m_Truncated && !IsValidDataType(type)) {
+      ME_CORE_ERROR("Corrupted render capture, unknown shader data type {0}",
+                    (int)type);
+      return false;
+    }
+    ReadBytes(ShaderDataTypeSize(type) * (size_t)count);
+  } break;
+  default: {
+    ME_CORE_ERROR("Corrupted render capture, unknown record {0} at {1}",
+                  (int)record, m_Offset - 1);
+    return false;
+  }
+  }
+
+  if (m_Truncated) {
+    ME_CORE_ERROR("Corrupted render capture, record {0} is truncated",
+                  (int)record);
+    return false;
+  }
+  return true;
+}
+
+bool RenderCaptureReplayer::ExecuteRecord(RenderCaptureRecord record) {
+  switch (record) {
+  case RenderCaptureRecord::BeginFrame:
+  case RenderCaptureRecord::EndFrame:
+    break;
+  case RenderCaptureRecord::CreateVertexBuffer: {
+    uint32_t id = Read<uint32_t>();
+    uint32_t count = Read<uint32_t>();
+    uint32_t size = Read<uint32_t>();
+    bool hasData = Read<uint8_t>();
+    if (m_Truncated) {
+      break;
+    }
+    if (!hasData) {
+      // Empty buffers in other formats than Vertex are sized in bytes
+      m_VertexBuffers[id] =
+          count != 0 ? VertexBuffer::Create(count)
+                     : VertexBuffer::Create(nullptr, size, BufferLayout());
+      break;
+    }
+    if (count != 0 && (uint64_t)count * sizeof(Vertex) != size) {
+      ME_CORE_ERROR("Corrupted render capture, vertex buffer {0} holds {1} "
+                    "bytes for {2} vertices",
+                    id, size, count);
+      return false;
+    }
+
+    const uint8_t *bytes = ReadBytes(size);
+    if (bytes == nullptr) {
+      break;
+    }
+    // Copy out of the byte stream to keep the vertex data aligned
+    std::vector<uint32_t> data((size + 3) / 4);
+    memcpy(data.data(), bytes, size);
+    // Buffers in other formats than Vertex are recorded without a count, their
+    // layout is set with the vertex array
+    if (count == 0) {
+      m_VertexBuffers[id] =
+          VertexBuffer::Create(data.data(), size, BufferLayout());
+      break;
+    }
+    m_VertexBuffers[id] =
+        VertexBuffer::Create(reinterpret_cast<Vertex *>(data.data()), count);
+  } break;
+  case RenderCaptureRecord::CreateIndexBuffer: {
+    uint32_t id = Read<uint32_t>();
+    uint32_t count = Read<uint32_t>();
+    IndexFormat format = (IndexFormat)Read<uint8_t>();
+    bool hasData = Read<uint8_t>();
+    if (m_Truncated) {
+      break;
+    }
+    if (format != IndexFormat::UInt16 && format != IndexFormat::UInt32) {
+      ME_CORE_ERROR("Corrupted render capture, unknown index format {0}",
+                    (int)format);
+      return false;
+    }
+    if (!hasData) {
+      m_IndexBuffers[id] = IndexBuffer::Create(count, format);
+      break;
+    }
+    const uint8_t *bytes = ReadBytes(sizeof(uint32_t) * (size_t)count);
+    if (bytes == nullptr) {
+      break;
+    }
+    std::vector<uint32_t> indices(count);
+    memcpy(indices.data(), bytes, sizeof(uint32_t) * count);
+    m_IndexBuffers[id] = IndexBuffer::Create(indices.data(), count);
+  } break;
+  case RenderCaptureRecord::CreateShaderStage: {
+    uint32_t id = Read<uint32_t>();
+    uint8_t type = Read<uint8_t>();
+    std::string filepath = ReadString();
+    if (m_Truncated) {
+      break;
+    }
+    if (type > ShaderStage::Fragment) {
+      ME_CORE_ERROR("Corrupted render capture, unknown shader stage type {0}",
+                    (int)type);
+      return false;
+    }
+    m_ShaderStages[id] =
+        ShaderStage::Create(filepath, (ShaderStage::StageType)type);
+  } break;
+  case RenderCaptureRecord::CreateShader: {
+    uint32_t id = Read<uint32_t>();
+    std::string name = ReadString();
+    uint32_t stageCount = Read<uint32_t>();
+    std::vector<Ref<ShaderStage>> stages;
+    for (uint32_t i = 0; i < stageCount && !m_Truncated; i++) {
+      const Ref<ShaderStage> *stage =
+          FindResource(m_ShaderStages, Read<uint32_t>(), "shader stage");
+      if (m_Truncated) {
+        break;
+      }
+      if (stage == nullptr) {
+        return false;
+      }
+      stages.push_back(*stage);
+    }
+    if (m_Truncated) {
+      break;
+    }
+    m_Shaders[id] = Shader::Create(name, stages);
+  } break;
+  case RenderCaptureRecord::CreateVertexArray: {
+    uint32_t id = Read<uint32_t>();
+    if (m_Truncated) {
+      break;
+    }
+    m_VertexArrays[id] = VertexArray::Create();
+  } break;
+  case RenderCaptureRecord::SetVertexArrayBuffers: {
+    uint32_t id = Read<uint32_t>();
+    uint32_t bufferCount = Read<uint32_t>();
+
+    // Vertex arrays cannot drop buffers, rebuild it from scratch
+    Ref<VertexArray> vertexArray = VertexArray::Create();
+    for (uint32_t i = 0; i < bufferCount && !m_Truncated; i++) {
+      uint32_t bufferId = Read<uint32_t>();
+      uint32_t elementCount = Read<uint32_t>();
+
+      std::vector<BufferElement> elements;
+      for (uint32_t e = 0; e < elementCount && !m_Truncated; e++) {
+        ShaderDataType type = (ShaderDataType)Read<uint8_t>();
+        bool normalized = Read<uint8_t>() != 0;
+        std::string name = ReadString();
+        if (!m_Truncated && !IsValidDataType(type)) {
+          ME_CORE_ERROR("Corrupted render capture, unknown vertex element "
+                        "type {0}",
+                        (int)type);
+          return false;
+        }
+        elements.emplace_back(type, name, normalized);
+      }
+      if (m_Truncated) {
+        break;
+      }
+
+      const Ref<VertexBuffer> *buffer =
+          FindResource(m_VertexBuffers, bufferId, "vertex buffer");
+      if (buffer == nullptr) {
+        return false;
+      }
+      (*buffer)->SetLayout(BufferLayout(elements));
+      vertexArray->AddVertexBuffer(*buffer);
+    }
+    uint32_t indexBufferId = Read<uint32_t>();
+    if (m_Truncated) {
+      break;
+    }
+    const Ref<IndexBuffer> *indexBuffer =
+        FindResource(m_IndexBuffers, indexBufferId, "index buffer");
+    if (indexBuffer == nullptr) {
+      return false;
+    }
+    vertexArray->SetIndexBuffer(*indexBuffer);
+    m_VertexArrays[id] = vertexArray;
+  } break;
+  case RenderCaptureRecord::VertexBufferData: {
+    uint32_t id = Read<uint32_t>();
+    uint32_t offset = Read<uint32_t>();
+    uint32_t size = Read<uint32_t>();
+    const uint8_t *bytes = ReadBytes(size);
+    if (bytes == nullptr) {
+      break;
+    }
+    const Ref<VertexBuffer> *buffer =
+        FindResource(m_VertexBuffers, id, "vertex buffer");
+    if (buffer == nullptr) {
+      return false;
+    }
+    if ((uint64_t)offset + size > (*buffer)->GetSize()) {
+      ME_CORE_ERROR("Corrupted render capture, vertex data past the end of "
+                    "vertex buffer {0}",
+                    id);
+      return false;
+    }
+    std::vector<uint32_t> data((size + 3) / 4);
+    memcpy(data.data(), bytes, size);
+    (*buffer)->SetData(data.data(), offset, size);
+  } break;
+  case RenderCaptureRecord::IndexBufferData: {
+    uint32_t id = Read<uint32_t>();
+    uint32_t offset = Read<uint32_t>();
+    uint32_t count = Read<uint32_t>();
+    const uint8_t *bytes = ReadBytes(sizeof(uint32_t) * (size_t)count);
+    if (bytes == nullptr) {
+      break;
+    }
+    const Ref<IndexBuffer> *buffer =
+        FindResource(m_IndexBuffers, id, "index buffer");
+    if (buffer == nullptr) {
+      return false;
+    }
+    if ((uint64_t)offset + count > (*buffer)->GetCount()) {
+      ME_CORE_ERROR("Corrupted render capture, index data past the end of "
+                    "index buffer {0}",
+                    id);
+      return false;
+    }
+    std::vector<uint32_t> indices(count);
+    memcpy(indices.data(), bytes, sizeof(uint32_t) * count);
+    (*buffer)->SetData(indices.data(), offset, count);
+  } break;
+  case RenderCaptureRecord::Submit: {
+    uint32_t shaderId = Read<uint32_t>();
+    uint32_t vertexArrayId = Read<uint32_t>();
+    DrawRange range;
+    range.FirstIndex = Read<uint32_t>();
+    range.IndexCount = Read<uint32_t>();
+    range.VertexOffset = Read<int32_t>();
+    if (m_Truncated) {
+      break;
+    }
+    const Ref<Shader> *shader = FindResource(m_Shaders, shaderId, "shader");
+    const Ref<VertexArray> *vertexArray =
+        FindResource(m_VertexArrays, vertexArrayId, "vertex array");
+    if (shader == nullptr || vertexArray == nullptr) {
+      return false;
+    }
+    Renderer::Submit(*shader, *vertexArray, range);
+  } break;
+  case RenderCaptureRecord::SetShaderData: {
+    uint32_t shaderId = Read<uint32_t>();
+    ShaderDataType type = (ShaderDataType)Read<uint8_t>();
+    std::string name = ReadString();
+    uint32_t count = Read<uint32_t>();
+    if (m_Truncated) {
+      break;
+    }
+    if (!IsValidDataType(type) || count == 0) {
+      ME_CORE_ERROR("Corrupted render capture, invalid shader data {0}",
+                    name);
+      return false;
+    }
+    const Ref<Shader> *shader = FindResource(m_Shaders, shaderId, "shader");
+    if (shader == nullptr) {
+      return false;
+    }
+
+    const size_t size = ShaderDataTypeSize(type) * (size_t)count;
+    const uint8_t *bytes = ReadBytes(size);
+    if (bytes == nullptr) {
+      break;
+    }
+    // Copy out of the byte stream to keep the values aligned
+    std::vector<uint32_t> data((size + 3) / 4);
+    memcpy(data.data(), bytes, size);
+
+    switch (type) {
+    case ShaderDataType::Int: {
+      if (count == 1) {
+        (*shader)->SetInt(name, *reinterpret_cast<int *>(data.data()));
+      } else {
+        (*shader)->SetIntArray(name, reinterpret_cast<int *>(data.data()),
+                               count);
+      }
+    } break;
+    case ShaderDataType::Float:
+      (*shader)->SetFloat(name, *reinterpret_cast<float *>(data.data()));
+      break;
+    case ShaderDataType::Float2:
+      (*shader)->SetFloat2(name, *reinterpret_cast<Vector2 *>(data.data()));
+      break;
+    case ShaderDataType::Float3:
+      (*shader)->SetFloat3(name, *reinterpret_cast<Vector3 *>(data.data()));
+      break;
+    case ShaderDataType::Float4:
+      (*shader)->SetFloat4(name, *reinterpret_cast<Vector4 *>(data.data()));
+      break;
+    case ShaderDataType::Mat4:
+      (*shader)->SetMat4(name, *reinterpret_cast<Matrix4 *>(data.data()));
+      break;
+    default:
+      ME_CORE_ERROR("Unsupported shader data type {0} in render capture",
+                    (int)type);
+      return false;
+    }
+  } break;
+  default: {
+    ME_CORE_ERROR("Corrupted render capture, unknown record {0} at {1}",
+                  (int)record, m_Offset - 1);
+    return false;
+  }
+  }
+
+  if (m_Truncated) {
+    ME_CORE_ERROR("Corrupted render capture, record {0} is truncated",
+                  (int)record);
+    return false;
+  }
+  return true;
+}
+} // namespace MyEngine
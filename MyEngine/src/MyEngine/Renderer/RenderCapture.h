@@ -0,0 +1,109 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Renderer/Buffer.h"
+#include "MyEngine/Renderer/Shader.h"
+#include "MyEngine/Renderer/ShaderStage.h"
+#include "MyEngine/Renderer/VertexArray.h"
+
+#include <unordered_map>
+
+namespace MyEngine {
+enum class RenderCaptureRecord : uint8_t {
+  None = 0,
+  BeginFrame,
+  EndFrame,
+  CreateVertexBuffer,
+  CreateIndexBuffer,
+  CreateShaderStage,
+  CreateShader,
+  CreateVertexArray,
+  SetVertexArrayBuffers,
+  VertexBufferData,
+  Submit,
+  SetShaderData,
+  IndexBufferData
+};
+
+// Serializes resource creation, buffer updates and submissions into a binary
+// capture file so the backend can be replayed without the game logic.
+//
+// File layout: an 8 byte header ("MERC", u16 version, u16 reserved) followed by
+// records, each one a RenderCaptureRecord tag and its payload. Resources are
+// referenced by ids assigned in creation order.
+class RenderCapture {
+public:
+  // Captures until End is called or frameCount frames were recorded, 0 keeps
+  // capturing until End.
+  static bool Begin(const std::string &path, uint32_t frameCount = 0);
+  static void End();
+
+  static bool IsCapturing() { return s_Capturing; }
+
+  static void OnBeginFrame();
+  static void OnEndFrame();
+
+  static void OnCreateVertexBuffer(const VertexBuffer *buffer, const void *data,
+                                   uint32_t count, uint32_t size);
+  static void OnCreateIndexBuffer(const IndexBuffer *buffer,
+                                  const uint32_t *indices, uint32_t count,
+                                  IndexFormat format);
+  static void OnCreateShaderStage(const ShaderStage *stage,
+                                  const std::string &filepath,
+                                  ShaderStage::StageType type);
+  static void OnCreateShader(const Shader *shader, const std::string &name,
+                             const std::vector<Ref<ShaderStage>> &stages);
+  static void OnCreateVertexArray(const VertexArray *vertexArray);
+  static void OnVertexBufferData(const VertexBuffer *buffer, const void *data,
+                                 uint32_t offset, uint32_t size);
+  static void OnIndexBufferData(const IndexBuffer *buffer,
+                                const uint32_t *indices, uint32_t offset,
+                                uint32_t count);
+  static void OnSubmit(const Ref<Shader> &shader,
+                       const Ref<VertexArray> &vertexArray,
+                       const DrawRange &range);
+  // count is the number of array elements for SetIntArray, 1 otherwise
+  static void OnSetShaderData(const Shader *shader, const std::string &name,
+                              ShaderDataType type, const void *data,
+                              uint32_t count);
+
+private:
+  static bool s_Capturing;
+};
+
+// Re-issues a capture through the renderer. Resources created before the first
+// frame are created by Load, every ReplayFrame call executes one captured
+// frame without any pacing so the backend runs as fast as it can.
+class RenderCaptureReplayer {
+public:
+  bool Load(const std::string &path);
+
+  // Returns false once every captured frame was replayed.
+  bool ReplayFrame();
+  void Rewind() { m_Offset = m_FirstFrameOffset; }
+
+  uint32_t GetFrameCount() const { return m_FrameCount; }
+
+private:
+  bool ExecuteRecord(RenderCaptureRecord record);
+  // Moves past the payload of a record without executing it
+  bool SkipRecord(RenderCaptureRecord record);
+
+  // Reads past the end of the capture return zeroes and set m_Truncated
+  template <typename T> T Read();
+  const uint8_t *ReadBytes(size_t size);
+  std::string ReadString();
+
+  std::vector<uint8_t> m_Buffer;
+  size_t m_Offset = 0;
+  size_t m_FirstFrameOffset = 0;
+  uint32_t m_FrameCount = 0;
+  bool m_Truncated = false;
+
+  std::unordered_map<uint32_t, Ref<VertexBuffer>> m_VertexBuffers;
+  std::unordered_map<uint32_t, Ref<IndexBuffer>> m_IndexBuffers;
+  std::unordered_map<uint32_t, Ref<ShaderStage>> m_ShaderStages;
+  std::unordered_map<uint32_t, Ref<Shader>> m_Shaders;
+  std::unordered_map<uint32_t, Ref<VertexArray>> m_VertexArrays;
+};
+} // namespace MyEngine
@@ -0,0 +1,103 @@
+#include "MyEngine/Renderer/RenderCapture.h"
+#include "MyEngine/Renderer/Renderer.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace MyEngine {
+class RenderCaptureTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RendererAPI::SetAPI(RendererAPI::API::Null);
+    Renderer::Init();
+    m_Path = (std::filesystem::temp_directory_path() / "RenderCaptureTest.merc")
+                 .string();
+  }
+
+  void TearDown() override {
+    Renderer::Shutdown();
+    RendererAPI::SetAPI(RendererAPI::API::Vulkan);
+    std::filesystem::remove(m_Path);
+  }
+
+  // Two frames drawing the same triangle
+  void Capture() {
+    ASSERT_TRUE(RenderCapture::Begin(m_Path));
+    Ref<Shader> shader = Shader::Create(
+        "Test", {ShaderStage::Create("test.vert", ShaderStage::Vertex),
+                 ShaderStage::Create("test.frag", ShaderStage::Fragment)});
+    uint32_t indices[] = {0, 1, 2};
+    Ref<VertexArray> vertexArray = VertexArray::Create();
+    vertexArray->AddVertexBuffer(VertexBuffer::Create(3));
+    vertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 3));
+
+    for (uint32_t frame = 0; frame < 2; frame++) {
+      RenderCapture::OnBeginFrame();
+      shader->SetInt("u_Frame", (int)frame);
+      Renderer::Submit(shader, vertexArray);
+      RenderCapture::OnEndFrame();
+    }
+    RenderCapture::End();
+  }
+
+  std::string m_Path;
+};
+
+TEST_F(RenderCaptureTest, ReplaysCapturedFrames) {
+  Capture();
+  NullRendererAPI::ResetStats();
+
+  RenderCaptureReplayer replayer;
+  ASSERT_TRUE(replayer.Load(m_Path));
+  EXPECT_EQ(replayer.GetFrameCount(), 2);
+  EXPECT_EQ(NullRendererAPI::GetStats().Shaders, 1);
+  EXPECT_EQ(NullRendererAPI::GetStats().VertexBuffers, 1);
+  EXPECT_EQ(NullRendererAPI::GetStats().IndexBuffers, 1);
+
+  EXPECT_TRUE(replayer.ReplayFrame());
+  EXPECT_TRUE(replayer.ReplayFrame());
+  EXPECT_FALSE(replayer.ReplayFrame());
+  EXPECT_EQ(NullRendererAPI::GetStats().DrawCalls, 2);
+  EXPECT_EQ(NullRendererAPI::GetStats().Indices, 6);
+
+  replayer.Rewind();
+  EXPECT_TRUE(replayer.ReplayFrame());
+  EXPECT_EQ(NullRendererAPI::GetStats().DrawCalls, 3);
+}
+
+TEST_F(RenderCaptureTest, RejectsTruncatedCaptures) {
+  Capture();
+  const uintmax_t size = std::filesystem::file_size(m_Path);
+
+  // Cuts into the last frame's submit, the loader walks every record first
+  std::filesystem::resize_file(m_Path, size - 4);
+  RenderCaptureReplayer replayer;
+  EXPECT_FALSE(replayer.Load(m_Path));
+}
+
+TEST_F(RenderCaptureTest, RejectsVertexDataPastTheEndOfItsBuffer) {
+  ASSERT_TRUE(RenderCapture::Begin(m_Path));
+  Ref<VertexBuffer> buffer = VertexBuffer::Create(3);
+  // Recorded as a corrupt capture would hold it
+  const uint32_t data[4] = {};
+  RenderCapture::OnBeginFrame();
+  RenderCapture::OnVertexBufferData(buffer.get(), data, buffer->GetSize() - 4,
+                                    sizeof(data));
+  RenderCapture::OnEndFrame();
+  RenderCapture::End();
+
+  RenderCaptureReplayer replayer;
+  ASSERT_TRUE(replayer.Load(m_Path));
+  EXPECT_FALSE(replayer.ReplayFrame());
+}
+
+TEST_F(RenderCaptureTest, RejectsFilesThatAreNotCaptures) {
+  std::ofstream(m_Path, std::ios::binary) << "not a capture";
+
+  RenderCaptureReplayer replayer;
+  EXPECT_FALSE(replayer.Load(m_Path));
+}
+} // namespace MyEngine
@@ -3,5 +3,5 @@
 #include "MyEngine/Renderer/RenderCommand.h"
 
 namespace MyEngine {
-Unique<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
+Unique<RendererAPI> RenderCommand::s_RendererAPI = nullptr;
 }
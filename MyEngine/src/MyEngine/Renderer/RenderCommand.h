@@ -7,8 +7,16 @@
 namespace MyEngine {
 class RenderCommand {
 public:
-  static void Init() { s_RendererAPI->Init(); }
-  static void Shutdown() { s_RendererAPI->Shutdown(); }
+  // The API is created here rather than at static init so the backend can be
+  // picked at startup.
+  static void Init() {
+    s_RendererAPI = RendererAPI::Create();
+    s_RendererAPI->Init();
+  }
+  static void Shutdown() {
+    s_RendererAPI->Shutdown();
+    s_RendererAPI.reset();
+  }
 
   static void SetViewport(uint32_t x, uint32_t y, uint32_t width,
                           uint32_t height) {
@@ -27,8 +35,9 @@ public:
 
   static void WaitForIdle() { s_RendererAPI->WaitForIdle(); }
 
-  static void DrawIndexed(const Ref<VertexArray> &vertexArray) {
-    s_RendererAPI->DrawIndexed(vertexArray);
+  static void DrawIndexed(const Ref<VertexArray> &vertexArray,
+                          const DrawRange &range) {
+    s_RendererAPI->DrawIndexed(vertexArray, range);
   }
 
 private:
@@ -1,13 +1,22 @@
 #include "mepch.h"
 
 #include "MyEngine/Core/Application.h"
+#include "MyEngine/Renderer/GeometryPool.h"
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/RenderCommand.h"
 #include "MyEngine/Renderer/Renderer.h"
+#include "MyEngine/Renderer/StaticBatch.h"
 
 namespace MyEngine {
-void Renderer::Init() { RenderCommand::Init(); }
+void Renderer::Init() {
+  RenderCommand::Init();
+  GeometryPool::Init();
+}
 
-void Renderer::Shutdown() { RenderCommand::Shutdown(); }
+void Renderer::Shutdown() {
+  GeometryPool::Shutdown();
+  RenderCommand::Shutdown();
+}
 
 void Renderer::Update() {
   Application &app = Application::Get();
@@ -17,12 +26,19 @@ void Renderer::Update() {
 }
 
 bool Renderer::BeginFrame() {
-  return RenderCommand::BeginFrame(
-      Application::Get().GetWindow().GetGraphicsContext());
+  if (!RenderCommand::BeginFrame(
+          Application::Get().GetWindow().GetGraphicsContext())) {
+    return false;
+  }
+
+  RenderCapture::OnBeginFrame();
+  return true;
 }
 
 void Renderer::EndFrame() {
+  RenderCapture::OnEndFrame();
   RenderCommand::EndFrame(Application::Get().GetWindow().GetGraphicsContext());
+  GeometryPool::EndFrame();
 }
 
 void Renderer::PresentFrame() {
@@ -34,9 +50,54 @@ void Renderer::WaitForIdle() { RenderCommand::WaitForIdle(); }
 
 void Renderer::Submit(const Ref<Shader> &shader,
                       const Ref<VertexArray> &vertexArray) {
+  Submit(shader, vertexArray, vertexArray->GetFullRange());
+}
+
+void Renderer::Submit(const Ref<Shader> &shader,
+                      const Ref<VertexArray> &vertexArray,
+                      const DrawRange &range) {
+  RenderCapture::OnSubmit(shader, vertexArray, range);
   shader->Bind();
   vertexArray->Bind();
-  RenderCommand::DrawIndexed(vertexArray);
+  RenderCommand::DrawIndexed(vertexArray, range);
+}
+
+// False when all corners of the bounds are outside the same clip plane, boxes
+// crossing the corner of the view are kept even if they miss it
+static bool IsInView(const MeshBounds &bounds, const Matrix4 &viewProjection) {
+  uint32_t outside[6] = {};
+  for (uint32_t i = 0; i < 8; i++) {
+    const Vector4 corner =
+        viewProjection * Vector4(i & 1 ? bounds.Max.x : bounds.Min.x,
+                                 i & 2 ? bounds.Max.y : bounds.Min.y,
+                                 i & 4 ? bounds.Max.z : bounds.Min.z, 1.0f);
+    outside[0] += corner.x < -corner.w;
+    outside[1] += corner.x > corner.w;
+    outside[2] += corner.y < -corner.w;
+    outside[3] += corner.y > corner.w;
+    outside[4] += corner.z < 0.0f;
+    outside[5] += corner.z > corner.w;
+  }
+  for (uint32_t count : outside) {
+    if (count == 8) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Renderer::Submit(const StaticBatch &batch,
+                      const Matrix4 &viewProjection) {
+  for (const StaticBatch::Chunk &chunk : batch.GetChunks()) {
+    if (!IsInView(chunk.Bounds, viewProjection)) {
+      continue;
+    }
+
+    const Ref<Shader> &shader = batch.GetShader(chunk);
+    shader->SetMat4("u_Transform", Mesh::GetTransform(chunk.Bounds));
+    Submit(shader, GeometryPool::GetVertexArray(chunk.Geometry.Page),
+           chunk.Geometry.GetDrawRange());
+  }
 }
 
 } // namespace MyEngine
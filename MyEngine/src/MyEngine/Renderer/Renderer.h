@@ -5,6 +5,8 @@
 #include "MyEngine/Renderer/VertexArray.h"
 
 namespace MyEngine {
+class StaticBatch;
+
 class Renderer {
 public:
   static void Init();
@@ -17,6 +19,13 @@ public:
 
   static void Submit(const Ref<Shader> &shader,
                      const Ref<VertexArray> &vertexArray);
+  // Draws part of the vertex array, like one mesh of a GeometryPool page
+  static void Submit(const Ref<Shader> &shader,
+                     const Ref<VertexArray> &vertexArray,
+                     const DrawRange &range);
+  // One draw per chunk of the batch that is in view, with u_Transform set to
+  // the chunk's transform. u_ViewProjection has to be set on the shaders.
+  static void Submit(const StaticBatch &batch, const Matrix4 &viewProjection);
 
   static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
 };
@@ -1,6 +1,8 @@
 #include "mepch.h"
 
 #include "MyEngine/Renderer/RendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
 #include "Platform/Vulkan/VulkanRendererAPI.h"
 
 namespace MyEngine {
@@ -15,6 +17,12 @@ Unique<RendererAPI> RendererAPI::Create() {
   case RendererAPI::API::Vulkan: {
     return CreateUnique<VulkanRendererAPI>();
   }
+  case RendererAPI::API::Null: {
+    return CreateUnique<NullRendererAPI>();
+  }
+  case RendererAPI::API::Software: {
+    return CreateUnique<SoftwareRendererAPI>();
+  }
   default:
     ME_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
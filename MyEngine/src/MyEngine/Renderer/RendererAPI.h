@@ -9,7 +9,7 @@
 namespace MyEngine {
 class RendererAPI {
 public:
-  enum class API { None = 0, Vulkan = 1 };
+  enum class API { None = 0, Vulkan = 1, Null = 2, Software = 3 };
 
   virtual ~RendererAPI() = default;
 
@@ -28,11 +28,15 @@ public:
   virtual void EndFrame(GraphicsContext *ctx) = 0;
   virtual void PresentFrame(GraphicsContext *ctx) = 0;
   virtual void WaitForIdle() = 0;
-  virtual void DrawIndexed(const Ref<VertexArray> vertexArray) = 0;
+  // The shader and vertex array are bound by the caller
+  virtual void DrawIndexed(const Ref<VertexArray> vertexArray,
+                           const DrawRange &range) = 0;
 
   virtual void SetLineWidth(float width) = 0;
 
   static API GetAPI() { return s_API; }
+  // Must be called before the window and renderer are created.
+  static void SetAPI(API api) { s_API = api; }
   static Unique<RendererAPI> Create();
 
 private:
@@ -1,21 +1,69 @@
 #include "mepch.h"
 
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/RendererAPI.h"
 #include "MyEngine/Renderer/Shader.h"
+#include "Platform/Null/NullShader.h"
+#include "Platform/Software/SoftwareShader.h"
 #include "Platform/Vulkan/VulkanShader.h"
 
 namespace MyEngine {
 Ref<Shader> Shader::Create(const std::string &name,
                            const std::vector<Ref<ShaderStage>> modules) {
+  Ref<Shader> shader;
   switch (RendererAPI::GetAPI()) {
   case RendererAPI::API::Vulkan: {
-    return CreateRef<VulkanShader>(name, modules);
-  }
+    shader = CreateRef<VulkanShader>(name, modules);
+  } break;
+  case RendererAPI::API::Null: {
+    shader = CreateRef<NullShader>(name, modules);
+  } break;
+  case RendererAPI::API::Software: {
+    shader = CreateRef<SoftwareShader>(name, modules);
+  } break;
 
   default: {
     ME_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
   }
   }
+
+  RenderCapture::OnCreateShader(shader.get(), name, modules);
+  return shader;
+}
+
+void Shader::SetInt(const std::string &name, int value) {
+  Set(name, ShaderDataType::Int, &value, 1);
+}
+
+void Shader::SetIntArray(const std::string &name, int *value,
+                         uint32_t count) {
+  Set(name, ShaderDataType::Int, value, count);
+}
+
+void Shader::SetFloat(const std::string &name, float value) {
+  Set(name, ShaderDataType::Float, &value, 1);
+}
+
+void Shader::SetFloat2(const std::string &name, const Vector2 &value) {
+  Set(name, ShaderDataType::Float2, &value, 1);
+}
+
+void Shader::SetFloat3(const std::string &name, const Vector3 &value) {
+  Set(name, ShaderDataType::Float3, &value, 1);
+}
+
+void Shader::SetFloat4(const std::string &name, const Vector4 &value) {
+  Set(name, ShaderDataType::Float4, &value, 1);
+}
+
+void Shader::SetMat4(const std::string &name, const Matrix4 &value) {
+  Set(name, ShaderDataType::Mat4, &value, 1);
+}
+
+void Shader::Set(const std::string &name, ShaderDataType type,
+                 const void *data, uint32_t count) {
+  RenderCapture::OnSetShaderData(this, name, type, data, count);
+  SetData(name, type, data, count);
 }
 } // namespace MyEngine
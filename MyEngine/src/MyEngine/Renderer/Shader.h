@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MyEngine/Renderer/Buffer.h"
 #include "MyEngine/Renderer/ShaderStage.h"
 
 #include "MyEngine/Math/Math.h"
@@ -10,16 +11,27 @@ public:
   virtual ~Shader() = default;
   virtual void Bind() = 0;
 
-  /* virtual void SetInt(const std::string &name, int value) = 0;
-  virtual void SetIntArray(const std::string &name, int *value,
-                           uint32_t count) = 0;
-  virtual void SetFloat(const std::string &name, float value) = 0;
-  virtual void SetFloat2(const std::string &name, const Vector2 &value) = 0;
-  virtual void SetFloat3(const std::string &name, const Vector3 &value) = 0;
-  virtual void SetFloat4(const std::string &name, const Vector4 &value) = 0;
-  virtual void SetMat4(const std::string &name, const Matrix4 &value) = 0; */
+  // Values are looked up by the name of the uniform block or push constant
+  // member and apply to every following draw with this shader
+  void SetInt(const std::string &name, int value);
+  void SetIntArray(const std::string &name, int *value, uint32_t count);
+  void SetFloat(const std::string &name, float value);
+  void SetFloat2(const std::string &name, const Vector2 &value);
+  void SetFloat3(const std::string &name, const Vector3 &value);
+  void SetFloat4(const std::string &name, const Vector4 &value);
+  void SetMat4(const std::string &name, const Matrix4 &value);
 
   static Ref<Shader> Create(const std::string &name,
                             const std::vector<Ref<ShaderStage>> modules);
+
+protected:
+  // Stores count values of type, every setter ends up here once the render
+  // capture recorded the value
+  virtual void SetData(const std::string &name, ShaderDataType type,
+                       const void *data, uint32_t count) = 0;
+
+private:
+  void Set(const std::string &name, ShaderDataType type, const void *data,
+           uint32_t count);
 };
 } // namespace MyEngine
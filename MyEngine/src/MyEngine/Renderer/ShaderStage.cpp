@@ -1,20 +1,54 @@
 #include "mepch.h"
 
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/RendererAPI.h"
 #include "MyEngine/Renderer/ShaderStage.h"
+#include "Platform/Null/NullShaderStage.h"
+#include "Platform/Software/SoftwareShaderStage.h"
 #include "Platform/Vulkan/VulkanShaderStage.h"
 
 namespace MyEngine {
 Ref<ShaderStage> ShaderStage::Create(const std::string &filepath,
                                      StageType type) {
+  Ref<ShaderStage> stage;
   switch (RendererAPI::GetAPI()) {
   case RendererAPI::API::Vulkan: {
-    return CreateRef<VulkanShaderStage>(filepath, type);
+    stage = CreateRef<VulkanShaderStage>(filepath, type);
+  } break;
+  case RendererAPI::API::Null: {
+    stage = CreateRef<NullShaderStage>(filepath, type);
+  } break;
+  case RendererAPI::API::Software: {
+    stage = CreateRef<SoftwareShaderStage>(filepath, type);
   } break;
   default: {
     ME_CORE_ASSERT(false, "Unknown RendererAPI!");
     return nullptr;
   }
   }
+
+  RenderCapture::OnCreateShaderStage(stage.get(), filepath, type);
+  return stage;
+}
+
+std::vector<Ref<ShaderStage>>
+ShaderStage::CreateBatch(const std::vector<Source> &sources) {
+  std::vector<Ref<ShaderStage>> stages;
+  switch (RendererAPI::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    stages = VulkanShaderStage::CreateBatch(sources);
+    for (size_t i = 0; i < stages.size(); i++) {
+      RenderCapture::OnCreateShaderStage(stages[i].get(), sources[i].Filepath,
+                                         sources[i].Type);
+    }
+  } break;
+  default: {
+    for (const Source &source : sources) {
+      stages.push_back(Create(source.Filepath, source.Type));
+    }
+  } break;
+  }
+
+  return stages;
 }
 } // namespace MyEngine
@@ -7,9 +7,18 @@ class ShaderStage {
 public:
   enum StageType { Vertex, Fragment };
 
+  struct Source {
+    std::string Filepath;
+    StageType Type;
+  };
+
   virtual ~ShaderStage() = default;
   virtual StageType GetType() const = 0;
 
   static Ref<ShaderStage> Create(const std::string &filepath, StageType type);
+  // Compiles every stage concurrently where the backend supports it, the
+  // stages are returned in the order of the sources.
+  static std::vector<Ref<ShaderStage>>
+  CreateBatch(const std::vector<Source> &sources);
 };
 } // namespace MyEngine
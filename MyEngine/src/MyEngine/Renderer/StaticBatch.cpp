@@ -0,0 +1,102 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/StaticBatch.h"
+
+#include <limits>
+
+namespace MyEngine {
+StaticBatch::StaticBatch(float chunkSize) : m_ChunkSize(chunkSize) {
+  ME_CORE_ASSERT(chunkSize > 0.0f, "Static batch chunks need a size!");
+}
+
+StaticBatch::~StaticBatch() {
+  for (const Chunk &chunk : m_Chunks) {
+    GeometryPool::Free(chunk.Geometry);
+  }
+}
+
+void StaticBatch::Add(const Ref<Shader> &shader, const MeshData &mesh,
+                      const Matrix4 &transform) {
+  ME_CORE_ASSERT(!m_Built, "Static batch was already built!");
+
+  auto shaderIt = std::find(m_Shaders.begin(), m_Shaders.end(), shader);
+  const uint32_t shaderIndex = (uint32_t)(shaderIt - m_Shaders.begin());
+  if (shaderIt == m_Shaders.end()) {
+    m_Shaders.push_back(shader);
+  }
+
+  // Mirroring transforms turn the triangles around, their winding is flipped
+  // back so culling keeps the same faces
+  const bool mirrored = glm::determinant(transform) < 0.0f;
+
+  std::vector<Vertex> world;
+  for (const Submesh &submesh : mesh.Submeshes) {
+    world.clear();
+    world.reserve(submesh.VertexCount);
+    Vector3 min(std::numeric_limits<float>::max());
+    Vector3 max(std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < submesh.VertexCount; i++) {
+      const Vertex &vertex = mesh.Vertices[submesh.FirstVertex + i];
+      const Vector3 position =
+          Vector3(transform * Vector4(vertex.Position, 1.0f));
+      world.emplace_back(position, vertex.Color);
+      min = glm::min(min, position);
+      max = glm::max(max, position);
+    }
+    if (world.empty()) {
+      continue;
+    }
+
+    const Vector3 cell = glm::floor((min + max) * 0.5f / m_ChunkSize);
+    PendingChunk &pending = m_Pending[{shaderIndex, submesh.MaterialIndex,
+                                       (int32_t)cell.x, (int32_t)cell.y,
+                                       (int32_t)cell.z}];
+
+    // Submesh indices index the whole mesh
+    const uint32_t base = (uint32_t)pending.Vertices.size();
+    pending.Vertices.insert(pending.Vertices.end(), world.begin(),
+                            world.end());
+    const size_t firstIndex = pending.Indices.size();
+    for (uint32_t i = 0; i < submesh.IndexCount; i++) {
+      pending.Indices.push_back(mesh.Indices[submesh.FirstIndex + i] -
+                                submesh.FirstVertex + base);
+    }
+    if (mirrored) {
+      for (size_t i = firstIndex; i + 2 < pending.Indices.size(); i += 3) {
+        std::swap(pending.Indices[i + 1], pending.Indices[i + 2]);
+      }
+    }
+    m_ObjectCount++;
+  }
+}
+
+void StaticBatch::Build() {
+  ME_CORE_ASSERT(!m_Built, "Static batch was already built!");
+  m_Built = true;
+
+  m_Chunks.reserve(m_Pending.size());
+  for (const auto &[key, pending] : m_Pending) {
+    Chunk chunk;
+    chunk.ShaderIndex = std::get<0>(key);
+    chunk.MaterialIndex = std::get<1>(key);
+    chunk.Bounds.Min = pending.Vertices[0].Position;
+    chunk.Bounds.Max = pending.Vertices[0].Position;
+    for (const Vertex &vertex : pending.Vertices) {
+      chunk.Bounds.Min = glm::min(chunk.Bounds.Min, vertex.Position);
+      chunk.Bounds.Max = glm::max(chunk.Bounds.Max, vertex.Position);
+    }
+
+    // Quantized to the chunk, Mesh::GetTransform of the bounds maps it back
+    MeshVertices packed = Mesh::PackVertices(pending.Vertices, chunk.Bounds);
+    chunk.Geometry = GeometryPool::Allocate(
+        packed.Positions.data(), packed.Colors.data(),
+        (uint32_t)pending.Vertices.size(), pending.Indices.data(),
+        (uint32_t)pending.Indices.size());
+    m_Chunks.push_back(chunk);
+  }
+
+  ME_CORE_INFO("Built a static batch of {0} objects into {1} chunks",
+               m_ObjectCount, m_Chunks.size());
+  m_Pending.clear();
+}
+} // namespace MyEngine
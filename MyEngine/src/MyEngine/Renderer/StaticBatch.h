@@ -0,0 +1,63 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Renderer/GeometryPool.h"
+#include "MyEngine/Renderer/Mesh.h"
+#include "MyEngine/Renderer/Shader.h"
+
+#include <map>
+#include <tuple>
+
+namespace MyEngine {
+// Merges static meshes at load time, so scenes made of many small objects are
+// drawn with one draw per chunk instead of one per object. Submeshes are
+// grouped by shader and material, moved into world space and sorted into
+// cubic cells of the chunk size by the center of their bounds. Every group of
+// a cell becomes one chunk in the GeometryPool, quantized to its own bounds.
+// Chunks are culled against the view when the batch is submitted.
+class StaticBatch {
+public:
+  struct Chunk {
+    uint32_t ShaderIndex = 0;
+    uint32_t MaterialIndex = 0;
+    // World space
+    MeshBounds Bounds;
+    GeometryAllocation Geometry;
+  };
+
+  StaticBatch(float chunkSize = 32.0f);
+  ~StaticBatch();
+
+  StaticBatch(const StaticBatch &) = delete;
+  StaticBatch &operator=(const StaticBatch &) = delete;
+
+  // Copies every submesh of the mesh into the batch. Material indices are
+  // compared as they are, meshes sharing a material need the same index.
+  void Add(const Ref<Shader> &shader, const MeshData &mesh,
+           const Matrix4 &transform);
+  // Uploads the added geometry as chunks, nothing can be added afterwards
+  void Build();
+
+  const std::vector<Chunk> &GetChunks() const { return m_Chunks; }
+  const Ref<Shader> &GetShader(const Chunk &chunk) const {
+    return m_Shaders[chunk.ShaderIndex];
+  }
+
+private:
+  // World space geometry of one chunk until it is built
+  struct PendingChunk {
+    std::vector<Vertex> Vertices;
+    std::vector<uint32_t> Indices;
+  };
+  // Shader, material and cell coordinates. Ordered so chunks of a shader and
+  // material end up next to each other.
+  using ChunkKey = std::tuple<uint32_t, uint32_t, int32_t, int32_t, int32_t>;
+
+  float m_ChunkSize;
+  uint32_t m_ObjectCount = 0;
+  std::vector<Ref<Shader>> m_Shaders;
+  std::map<ChunkKey, PendingChunk> m_Pending;
+  std::vector<Chunk> m_Chunks;
+  bool m_Built = false;
+};
+} // namespace MyEngine
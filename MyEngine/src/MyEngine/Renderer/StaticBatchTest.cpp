@@ -0,0 +1,143 @@
+#include "MyEngine/Renderer/Renderer.h"
+#include "MyEngine/Renderer/StaticBatch.h"
+#include "Platform/Software/SoftwareBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace MyEngine {
+// The same triangle twice, as two submeshes with their own material
+static MeshData CreateMesh() {
+  MeshData mesh;
+  for (uint32_t submesh = 0; submesh < 2; submesh++) {
+    mesh.Vertices.emplace_back(Vector3(0.0f, 0.0f, 0.0f), Vector4(1.0f));
+    mesh.Vertices.emplace_back(Vector3(1.0f, 0.0f, 0.0f), Vector4(1.0f));
+    mesh.Vertices.emplace_back(Vector3(0.0f, 1.0f, 0.0f), Vector4(1.0f));
+    const uint32_t first = 3 * submesh;
+    mesh.Indices.insert(mesh.Indices.end(), {first, first + 1, first + 2});
+    mesh.Submeshes.push_back({first, 3, first, 3, submesh, {}});
+  }
+  mesh.Bounds.Max = Vector3(1.0f, 1.0f, 0.0f);
+  return mesh;
+}
+
+static Matrix4 Translate(float x) {
+  return glm::translate(Matrix4(1.0f), Vector3(x, 0.0f, 0.0f));
+}
+
+class StaticBatchTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RendererAPI::SetAPI(RendererAPI::API::Null);
+    Renderer::Init();
+    m_Shader = Shader::Create(
+        "Test", {ShaderStage::Create("test.vert", ShaderStage::Vertex),
+                 ShaderStage::Create("test.frag", ShaderStage::Fragment)});
+  }
+
+  void TearDown() override {
+    m_Shader.reset();
+    Renderer::Shutdown();
+    RendererAPI::SetAPI(RendererAPI::API::Vulkan);
+  }
+
+  Ref<Shader> m_Shader;
+};
+
+TEST_F(StaticBatchTest, ChunksByCellAndMaterial) {
+  const MeshData mesh = CreateMesh();
+  StaticBatch batch(10.0f);
+  // The first two share a cell, the third is two cells over
+  batch.Add(m_Shader, mesh, Translate(0.0f));
+  batch.Add(m_Shader, mesh, Translate(5.0f));
+  batch.Add(m_Shader, mesh, Translate(25.0f));
+  batch.Build();
+
+  // Ordered by material, then by cell
+  const std::vector<StaticBatch::Chunk> &chunks = batch.GetChunks();
+  ASSERT_EQ(chunks.size(), 4);
+  const uint32_t materials[] = {0, 0, 1, 1};
+  const uint32_t vertexCounts[] = {6, 3, 6, 3};
+  for (size_t i = 0; i < chunks.size(); i++) {
+    EXPECT_EQ(chunks[i].MaterialIndex, materials[i]);
+    EXPECT_EQ(chunks[i].Geometry.VertexCount, vertexCounts[i]);
+    EXPECT_EQ(chunks[i].Geometry.IndexCount, vertexCounts[i]);
+    EXPECT_EQ(batch.GetShader(chunks[i]), m_Shader);
+  }
+}
+
+TEST_F(StaticBatchTest, ChunksByShader) {
+  const MeshData mesh = CreateMesh();
+  Ref<Shader> other = Shader::Create(
+      "Other", {ShaderStage::Create("test.vert", ShaderStage::Vertex),
+                ShaderStage::Create("test.frag", ShaderStage::Fragment)});
+  StaticBatch batch(10.0f);
+  batch.Add(m_Shader, mesh, Translate(0.0f));
+  batch.Add(other, mesh, Translate(0.0f));
+  batch.Build();
+
+  const std::vector<StaticBatch::Chunk> &chunks = batch.GetChunks();
+  ASSERT_EQ(chunks.size(), 4);
+  EXPECT_EQ(batch.GetShader(chunks[0]), m_Shader);
+  EXPECT_EQ(batch.GetShader(chunks[3]), other);
+}
+
+TEST_F(StaticBatchTest, BoundsCoverTheChunkInWorldSpace) {
+  const MeshData mesh = CreateMesh();
+  StaticBatch batch(10.0f);
+  batch.Add(m_Shader, mesh, Translate(0.0f));
+  batch.Add(m_Shader, mesh, Translate(5.0f));
+  batch.Add(m_Shader, mesh,
+            glm::scale(Translate(25.0f), Vector3(2.0f, 3.0f, 1.0f)));
+  batch.Build();
+
+  const std::vector<StaticBatch::Chunk> &chunks = batch.GetChunks();
+  ASSERT_EQ(chunks.size(), 4);
+  EXPECT_EQ(chunks[0].Bounds.Min, Vector3(0.0f, 0.0f, 0.0f));
+  EXPECT_EQ(chunks[0].Bounds.Max, Vector3(6.0f, 1.0f, 0.0f));
+  EXPECT_EQ(chunks[1].Bounds.Min, Vector3(25.0f, 0.0f, 0.0f));
+  EXPECT_EQ(chunks[1].Bounds.Max, Vector3(27.0f, 3.0f, 0.0f));
+}
+
+// Null buffers keep no data, the indices are read back from software ones
+class StaticBatchWindingTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    RendererAPI::SetAPI(RendererAPI::API::Software);
+    GeometryPool::Init();
+  }
+
+  void TearDown() override {
+    GeometryPool::Shutdown();
+    RendererAPI::SetAPI(RendererAPI::API::Vulkan);
+  }
+
+  static std::vector<uint32_t> GetIndices(const StaticBatch::Chunk &chunk) {
+    const Ref<VertexArray> &array =
+        GeometryPool::GetVertexArray(chunk.Geometry.Page);
+    const SoftwareIndexBuffer &buffer =
+        static_cast<const SoftwareIndexBuffer &>(*array->GetIndexBuffer());
+    const uint32_t *indices = buffer.GetIndices() + chunk.Geometry.FirstIndex;
+    return std::vector<uint32_t>(indices,
+                                 indices + chunk.Geometry.IndexCount);
+  }
+};
+
+TEST_F(StaticBatchWindingTest, FlipsMirroredTriangles) {
+  MeshData mesh = CreateMesh();
+  mesh.Submeshes.pop_back();
+  StaticBatch batch(10.0f);
+  batch.Add(nullptr, mesh, Translate(0.0f));
+  // Mirrored into the cell to the left
+  batch.Add(nullptr, mesh,
+            glm::scale(Matrix4(1.0f), Vector3(-1.0f, 1.0f, 1.0f)));
+  batch.Build();
+
+  const std::vector<StaticBatch::Chunk> &chunks = batch.GetChunks();
+  ASSERT_EQ(chunks.size(), 2);
+  EXPECT_EQ(chunks[0].Bounds.Min.x, -1.0f);
+  EXPECT_EQ(GetIndices(chunks[0]), std::vector<uint32_t>({0, 2, 1}));
+  EXPECT_EQ(GetIndices(chunks[1]), std::vector<uint32_t>({0, 1, 2}));
+}
+} // namespace MyEngine
@@ -0,0 +1,55 @@
+#include "mepch.h"
+
+#include "MyEngine/Renderer/Texture.h"
+
+#include "MyEngine/Renderer/Renderer.h"
+#include "Platform/Null/NullTexture.h"
+#include "Platform/Software/SoftwareTexture.h"
+#include "Platform/Vulkan/VulkanTexture.h"
+
+namespace MyEngine {
+Ref<Texture2D> Texture2D::Create(const TextureSpecification &specification) {
+  Ref<Texture2D> texture;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    texture = CreateRef<VulkanTexture2D>(specification);
+  } break;
+  case RendererAPI::API::Null: {
+    texture = CreateRef<NullTexture2D>(specification);
+  } break;
+  case RendererAPI::API::Software: {
+    texture = CreateRef<SoftwareTexture2D>(specification);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
+  }
+
+  return texture;
+}
+
+Ref<Texture2D> Texture2D::Create(const std::string &filepath,
+                                 const TextureSpecification &specification) {
+  Ref<Texture2D> texture;
+  switch (Renderer::GetAPI()) {
+  case RendererAPI::API::Vulkan: {
+    texture = CreateRef<VulkanTexture2D>(filepath, specification);
+  } break;
+  case RendererAPI::API::Null: {
+    texture = CreateRef<NullTexture2D>(filepath, specification);
+  } break;
+  case RendererAPI::API::Software: {
+    texture = CreateRef<SoftwareTexture2D>(filepath, specification);
+  } break;
+
+  default: {
+    ME_CORE_ASSERT(false, "Unknown RendererAPI!");
+    return nullptr;
+  }
+  }
+
+  return texture;
+}
+} // namespace MyEngine
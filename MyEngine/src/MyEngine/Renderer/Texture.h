@@ -0,0 +1,101 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+namespace MyEngine {
+enum class TextureFormat {
+  RGBA8,
+  RGBA8_SRGB,
+  // Block compressed, 4x4 pixels per block
+  BC1,
+  BC1_SRGB,
+  BC3,
+  BC3_SRGB,
+  BC5,
+  BC7,
+  BC7_SRGB,
+  ETC2_RGBA8,
+  ETC2_RGBA8_SRGB,
+  ASTC_4x4,
+  ASTC_4x4_SRGB
+};
+enum class TextureFilter { Nearest, Linear };
+enum class TextureWrap { Repeat, MirroredRepeat, ClampToEdge };
+
+// Bytes of a 4x4 block, 0 for formats that aren't block compressed
+static uint32_t TextureFormatBlockSize(TextureFormat format) {
+  switch (format) {
+  case TextureFormat::RGBA8:
+  case TextureFormat::RGBA8_SRGB:
+    return 0;
+  case TextureFormat::BC1:
+  case TextureFormat::BC1_SRGB:
+    return 8;
+  case TextureFormat::BC3:
+  case TextureFormat::BC3_SRGB:
+  case TextureFormat::BC5:
+  case TextureFormat::BC7:
+  case TextureFormat::BC7_SRGB:
+  case TextureFormat::ETC2_RGBA8:
+  case TextureFormat::ETC2_RGBA8_SRGB:
+  case TextureFormat::ASTC_4x4:
+  case TextureFormat::ASTC_4x4_SRGB:
+    return 16;
+  }
+
+  ME_CORE_ASSERT(false, "Unknown texture format!");
+  return 0;
+}
+
+// Bytes of a tightly packed image of the format
+static uint32_t TextureFormatImageSize(TextureFormat format, uint32_t width,
+                                       uint32_t height) {
+  const uint32_t blockSize = TextureFormatBlockSize(format);
+  if (blockSize == 0) {
+    return width * height * 4;
+  }
+  return ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+}
+
+struct TextureSpecification {
+  uint32_t Width = 1;
+  uint32_t Height = 1;
+  TextureFormat Format = TextureFormat::RGBA8;
+  TextureFilter Filter = TextureFilter::Linear;
+  TextureWrap Wrap = TextureWrap::Repeat;
+  bool GenerateMips = true;
+};
+
+class Texture {
+public:
+  virtual ~Texture() = default;
+
+  virtual uint32_t GetWidth() const = 0;
+  virtual uint32_t GetHeight() const = 0;
+
+  // False until the data is decoded and uploaded, a placeholder is sampled
+  // in the meantime
+  virtual bool IsLoaded() const = 0;
+  // Slot of the texture in the bindless table that materials and vertices
+  // reference it by, the placeholder's slot until the texture is loaded
+  virtual uint32_t GetIndex() const = 0;
+  // Largest size in pixels the texture is shown at on screen this frame.
+  // Streaming backends keep the mips above it out of memory.
+  virtual void RequestSize(uint32_t pixels) = 0;
+
+  // Replaces the whole texture with tightly packed pixels or blocks of its
+  // format, the upload happens asynchronously
+  virtual void SetData(const void *data, uint32_t size) = 0;
+};
+
+class Texture2D : public Texture {
+public:
+  static Ref<Texture2D> Create(const TextureSpecification &specification);
+  // Returns immediately, the image is decoded on the thread pool. The size of
+  // the specification is replaced by the size of the image once it is loaded,
+  // the format as well for KTX2 files which bring their own.
+  static Ref<Texture2D>
+  Create(const std::string &filepath,
+         const TextureSpecification &specification = TextureSpecification());
+};
+} // namespace MyEngine
@@ -2,7 +2,10 @@
 
 #include "MyEngine/Renderer/VertexArray.h"
 
+#include "MyEngine/Renderer/RenderCapture.h"
 #include "MyEngine/Renderer/Renderer.h"
+#include "Platform/Null/NullVertexArray.h"
+#include "Platform/Software/SoftwareVertexArray.h"
 #include "Platform/Vulkan/VulkanVertexArray.h"
 
 namespace MyEngine {
@@ -14,7 +17,19 @@ Ref<VertexArray> VertexArray::Create() {
     return nullptr;
   }
   case RendererAPI::API::Vulkan: {
-    return CreateRef<VulkanVertexArray>();
+    Ref<VertexArray> vertexArray = CreateRef<VulkanVertexArray>();
+    RenderCapture::OnCreateVertexArray(vertexArray.get());
+    return vertexArray;
+  } break;
+  case RendererAPI::API::Null: {
+    Ref<VertexArray> vertexArray = CreateRef<NullVertexArray>();
+    RenderCapture::OnCreateVertexArray(vertexArray.get());
+    return vertexArray;
+  } break;
+  case RendererAPI::API::Software: {
+    Ref<VertexArray> vertexArray = CreateRef<SoftwareVertexArray>();
+    RenderCapture::OnCreateVertexArray(vertexArray.get());
+    return vertexArray;
   } break;
   }
 
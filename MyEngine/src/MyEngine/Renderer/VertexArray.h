@@ -4,19 +4,31 @@
 #include "MyEngine/Renderer/Buffer.h"
 
 namespace MyEngine {
+// Indices drawn by one draw call. VertexOffset is added to every index, so
+// meshes placed anywhere in shared buffers keep their indices.
+struct DrawRange {
+  uint32_t FirstIndex = 0;
+  uint32_t IndexCount = 0;
+  int32_t VertexOffset = 0;
+};
+
 class VertexArray {
 public:
   virtual ~VertexArray() = default;
 
   virtual void Bind() const = 0;
   virtual void Unbind() const = 0;
-  virtual void Draw() const = 0;
+  virtual void Draw(const DrawRange &range) const = 0;
 
   virtual void AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) = 0;
   virtual void SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) = 0;
 
   virtual const std::vector<Ref<VertexBuffer>> &GetVertexBuffers() const = 0;
   virtual const Ref<IndexBuffer> &GetIndexBuffer() const = 0;
+  // Every index of the index buffer
+  DrawRange GetFullRange() const {
+    return {0, GetIndexBuffer()->GetCount(), 0};
+  }
 
   static Ref<VertexArray> Create();
 };
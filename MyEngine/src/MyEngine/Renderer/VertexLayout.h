@@ -0,0 +1,86 @@
+#pragma once
+
+#include "MyEngine/Renderer/Buffer.h"
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+namespace MyEngine {
+// Input names of the engine shaders, usable as Attr names
+namespace VertexAttribute {
+inline constexpr char Position[] = "a_position";
+inline constexpr char Color[] = "a_color";
+} // namespace VertexAttribute
+
+// Element of a VertexLayout. The name has to be a constant with static storage
+// like the ones in VertexAttribute, C++17 has no string template arguments.
+template <ShaderDataType Type, const char *Name, bool Normalized = false>
+struct Attr {
+  static constexpr ShaderDataType DataType = Type;
+  static constexpr const char *AttributeName = Name;
+  static constexpr bool IsNormalized = Normalized;
+  static constexpr uint32_t Size = ShaderDataTypeSize(Type);
+  static_assert(Size > 0, "Attribute type has no size");
+};
+
+// Buffer layout whose stride and offsets are computed at compile time, so they
+// can be checked against the vertex struct they describe:
+//
+//   using Layout = VertexLayout<
+//       Attr<ShaderDataType::Float3, VertexAttribute::Position>,
+//       Attr<ShaderDataType::Float4, VertexAttribute::Color>>;
+//   static_assert(Layout::Matches<Vertex>(
+//       {offsetof(Vertex, Position), offsetof(Vertex, Color)}));
+//
+// Get returns the matching BufferLayout, which is only built once. The Vulkan
+// backend derives the attribute formats with GetVulkanFormats.
+template <typename... Attrs> class VertexLayout {
+public:
+  static constexpr size_t Count = sizeof...(Attrs);
+  static_assert(Count > 0, "Vertex layouts need at least one attribute");
+  static constexpr uint32_t Stride = (Attrs::Size + ... + 0);
+  static constexpr std::array<uint32_t, Count> Offsets = [] {
+    std::array<uint32_t, Count> offsets{};
+    const uint32_t sizes[] = {Attrs::Size...};
+    uint32_t offset = 0;
+    for (size_t i = 0; i < Count; i++) {
+      offsets[i] = offset;
+      offset += sizes[i];
+    }
+    return offsets;
+  }();
+
+  // True when T is exactly one vertex and its members start at the offsets
+  // of the attributes, given in order
+  template <typename T>
+  static constexpr bool Matches(std::initializer_list<size_t> memberOffsets) {
+    if (sizeof(T) != Stride || memberOffsets.size() != Count) {
+      return false;
+    }
+    size_t i = 0;
+    for (size_t offset : memberOffsets) {
+      if (offset != Offsets[i++]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static const BufferLayout &Get() {
+    static const BufferLayout s_Layout = {BufferElement(
+        Attrs::DataType, Attrs::AttributeName, Attrs::IsNormalized)...};
+    return s_Layout;
+  }
+};
+
+// +=================+
+// | ENGINE VERTICES |
+// +=================+
+using DefaultVertexLayout =
+    VertexLayout<Attr<ShaderDataType::Float3, VertexAttribute::Position>,
+                 Attr<ShaderDataType::Float4, VertexAttribute::Color>>;
+static_assert(DefaultVertexLayout::Matches<Vertex>(
+                  {offsetof(Vertex, Position), offsetof(Vertex, Color)}),
+              "DefaultVertexLayout does not match Vertex");
+} // namespace MyEngine
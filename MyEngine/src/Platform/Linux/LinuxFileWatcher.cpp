@@ -0,0 +1,85 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/FileWatcher.h"
+
+#ifdef ME_PLATFORM_LINUX
+#include <filesystem>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace MyEngine {
+struct FileWatcher::FileWatcherData {
+  int Fd = -1;
+  std::unordered_map<std::string, int> DirectoryWatches;
+  std::unordered_map<int, std::string> WatchDirectories;
+  std::unordered_set<std::string> Files;
+};
+
+FileWatcher::FileWatcher() : m_Data(CreateUnique<FileWatcherData>()) {
+  m_Data->Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_Data->Fd < 0) {
+    ME_CORE_ERROR("Unable to initialize inotify, file changes will not be "
+                  "detected");
+  }
+}
+
+FileWatcher::~FileWatcher() {
+  if (m_Data->Fd >= 0) {
+    close(m_Data->Fd);
+  }
+}
+
+void FileWatcher::Watch(const std::string &filepath) {
+  std::string path = Normalize(filepath);
+  if (m_Data->Fd < 0 || !m_Data->Files.insert(path).second) {
+    return;
+  }
+
+  std::string directory = std::filesystem::path(path).parent_path().string();
+  if (m_Data->DirectoryWatches.count(directory) > 0) {
+    return;
+  }
+
+  int watch = inotify_add_watch(m_Data->Fd, directory.c_str(),
+                                IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+  if (watch < 0) {
+    ME_CORE_ERROR("Unable to watch {0} for changes", directory);
+    return;
+  }
+
+  m_Data->DirectoryWatches[directory] = watch;
+  m_Data->WatchDirectories[watch] = directory;
+}
+
+std::vector<std::string> FileWatcher::Poll() {
+  std::vector<std::string> changed;
+  if (m_Data->Fd < 0) {
+    return changed;
+  }
+
+  alignas(inotify_event) char buffer[4096];
+  ssize_t length;
+  while ((length = read(m_Data->Fd, buffer, sizeof(buffer))) > 0) {
+    for (char *p = buffer; p < buffer + length;) {
+      const inotify_event *event = reinterpret_cast<const inotify_event *>(p);
+      p += sizeof(inotify_event) + event->len;
+
+      auto it = m_Data->WatchDirectories.find(event->wd);
+      if (it == m_Data->WatchDirectories.end() || event->len == 0) {
+        continue;
+      }
+
+      std::string path = it->second + "/" + event->name;
+      if (m_Data->Files.count(path) > 0 &&
+          std::find(changed.begin(), changed.end(), path) == changed.end()) {
+        changed.push_back(path);
+      }
+    }
+  }
+
+  return changed;
+}
+} // namespace MyEngine
+#endif
@@ -0,0 +1,63 @@
+#include "mepch.h"
+
+#include "MyEngine/Filesystem/MappedFile.h"
+
+#ifdef ME_PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MyEngine {
+struct MappedFile::MappedFileData {
+  void *Mapping = MAP_FAILED;
+  size_t Length = 0;
+};
+
+MappedFile::MappedFile() : m_Data(CreateUnique<MappedFileData>()) {}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string &filepath) {
+  Close();
+
+  int fd = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  // The mapping keeps the file referenced, the descriptor isn't needed
+  const size_t length = (size_t)info.st_size;
+  void *mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    ME_CORE_ERROR("Unable to map {0}", filepath);
+    return false;
+  }
+  // The whole file is uploaded right away, let the kernel read ahead
+  madvise(mapping, length, MADV_WILLNEED);
+
+  m_Data->Mapping = mapping;
+  m_Data->Length = length;
+  m_Pointer = static_cast<const uint8_t *>(mapping);
+  m_Size = length;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_Data->Mapping != MAP_FAILED) {
+    munmap(m_Data->Mapping, m_Data->Length);
+  }
+  m_Data->Mapping = MAP_FAILED;
+  m_Data->Length = 0;
+  m_Pointer = nullptr;
+  m_Size = 0;
+}
+} // namespace MyEngine
+#endif
@@ -0,0 +1,78 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullBuffer.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace MyEngine {
+// +===============+
+// | VERTEX BUFFER |
+// +===============+
+NullVertexBuffer::NullVertexBuffer(uint32_t size)
+    : m_Size(sizeof(Vertex) * size) {
+  NullRendererAPI::GetStats().VertexBuffers++;
+}
+
+NullVertexBuffer::NullVertexBuffer(Vertex *vertices, uint32_t size)
+    : m_Size(sizeof(Vertex) * size) {
+  NullRenderStats &stats = NullRendererAPI::GetStats();
+  stats.VertexBuffers++;
+  stats.BytesUploaded += sizeof(Vertex) * size;
+}
+
+NullVertexBuffer::NullVertexBuffer(const void *vertices, uint32_t size)
+    : m_Size(size) {
+  NullRenderStats &stats = NullRendererAPI::GetStats();
+  stats.VertexBuffers++;
+  if (vertices != nullptr) {
+    stats.BytesUploaded += size;
+  }
+}
+
+void NullVertexBuffer::WriteData(const void *pData, uint32_t offset,
+                                 uint32_t size) {
+  NullRendererAPI::GetStats().BytesUploaded += size;
+}
+
+void *NullVertexBuffer::MapData(uint32_t offset, uint32_t size) {
+  m_Scratch.resize(size);
+  return m_Scratch.data();
+}
+
+void NullVertexBuffer::UnmapData(uint32_t offset, uint32_t size) {
+  NullRendererAPI::GetStats().BytesUploaded += size;
+}
+
+// +==============+
+// | INDEX BUFFER |
+// +==============+
+// Indices are counted at the size the GPU backends store them with
+NullIndexBuffer::NullIndexBuffer(uint32_t *indices, uint32_t count)
+    : m_Count(count), m_IndexSize(IndexBuffer::Fits16Bit(indices, count)
+                                      ? sizeof(uint16_t)
+                                      : sizeof(uint32_t)) {
+  NullRenderStats &stats = NullRendererAPI::GetStats();
+  stats.IndexBuffers++;
+  stats.BytesUploaded += m_IndexSize * count;
+}
+
+NullIndexBuffer::NullIndexBuffer(uint32_t count, IndexFormat format)
+    : m_Count(count), m_IndexSize(format == IndexFormat::UInt16
+                                      ? sizeof(uint16_t)
+                                      : sizeof(uint32_t)) {
+  NullRendererAPI::GetStats().IndexBuffers++;
+}
+
+void NullIndexBuffer::WriteData(const uint32_t *indices, uint32_t offset,
+                                uint32_t count) {
+  NullRendererAPI::GetStats().BytesUploaded += m_IndexSize * count;
+}
+
+uint32_t *NullIndexBuffer::MapData(uint32_t offset, uint32_t count) {
+  m_Scratch.resize(count);
+  return m_Scratch.data();
+}
+
+void NullIndexBuffer::UnmapData(uint32_t offset, uint32_t count) {
+  NullRendererAPI::GetStats().BytesUploaded += m_IndexSize * count;
+}
+} // namespace MyEngine
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "MyEngine/Renderer/Buffer.h"
+
+namespace MyEngine {
+class NullVertexBuffer : public VertexBuffer {
+public:
+  NullVertexBuffer(uint32_t size);
+  NullVertexBuffer(Vertex *vertices, uint32_t size);
+  NullVertexBuffer(const void *vertices, uint32_t size);
+  virtual ~NullVertexBuffer() = default;
+
+  virtual void Bind() const override {}
+  virtual void Unbind() const override {}
+
+  virtual const BufferLayout &GetLayout() const override { return m_Layout; }
+  virtual void SetLayout(const BufferLayout &layout) override {
+    m_Layout = layout;
+  }
+  virtual uint32_t GetSize() const override { return m_Size; }
+
+protected:
+  virtual void WriteData(const void *pData, uint32_t offset,
+                         uint32_t size) override;
+  virtual void *MapData(uint32_t offset, uint32_t size) override;
+  virtual void UnmapData(uint32_t offset, uint32_t size) override;
+
+private:
+  BufferLayout m_Layout;
+  uint32_t m_Size;
+  // Memory of the mapped range, the buffer has none of its own
+  std::vector<uint8_t> m_Scratch;
+};
+
+class NullIndexBuffer : public IndexBuffer {
+public:
+  NullIndexBuffer(uint32_t *indices, uint32_t count);
+  NullIndexBuffer(uint32_t count, IndexFormat format);
+  virtual ~NullIndexBuffer() = default;
+
+  virtual void Bind() const override {}
+  virtual void Unbind() const override {}
+
+  virtual uint32_t GetCount() const override { return m_Count; }
+
+protected:
+  virtual void WriteData(const uint32_t *indices, uint32_t offset,
+                         uint32_t count) override;
+  virtual uint32_t *MapData(uint32_t offset, uint32_t count) override;
+  virtual void UnmapData(uint32_t offset, uint32_t count) override;
+
+private:
+  uint32_t m_Count;
+  uint32_t m_IndexSize;
+  std::vector<uint32_t> m_Scratch;
+};
+} // namespace MyEngine
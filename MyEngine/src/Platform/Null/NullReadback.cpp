@@ -0,0 +1,16 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullReadback.h"
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace MyEngine {
+NullReadback::NullReadback(uint32_t size) : m_Data(size, 0) {
+  NullRendererAPI::GetStats().BytesReadBack += size;
+}
+
+NullReadback::NullReadback(uint32_t width, uint32_t height)
+    : NullReadback(width * height * 4) {
+  m_Width = width;
+  m_Height = height;
+}
+} // namespace MyEngine
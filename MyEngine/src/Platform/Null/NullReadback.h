@@ -0,0 +1,24 @@
+#pragma once
+
+#include "MyEngine/Renderer/Readback.h"
+
+#include <vector>
+
+namespace MyEngine {
+// Ready right away, reads zeros
+class NullReadback : public Readback {
+public:
+  NullReadback(uint32_t size);
+  // RGBA8 pixels of a texture
+  NullReadback(uint32_t width, uint32_t height);
+  virtual ~NullReadback() = default;
+
+  virtual bool IsReady() const override { return true; }
+  virtual Span<const uint8_t> GetData() const override {
+    return Span<const uint8_t>(m_Data.data(), m_Data.size());
+  }
+
+private:
+  std::vector<uint8_t> m_Data;
+};
+} // namespace MyEngine
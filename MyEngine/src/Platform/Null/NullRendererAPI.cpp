@@ -0,0 +1,35 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+
+namespace MyEngine {
+NullRenderStats NullRendererAPI::s_Stats;
+
+void NullRendererAPI::Init() {
+  ResetStats();
+  ME_CORE_INFO("Using the null renderer, no GPU work will be done");
+}
+
+void NullRendererAPI::Shutdown() {
+  ME_CORE_INFO("Null renderer: {0} frames, {1} draw calls, {2} indices",
+               s_Stats.Frames, s_Stats.DrawCalls, s_Stats.Indices);
+  ME_CORE_INFO("Null renderer: {0} shader binds, {1} vertex array binds, {2} "
+               "of them redundant",
+               s_Stats.ShaderBinds, s_Stats.VertexArrayBinds,
+               s_Stats.RedundantBinds);
+  ME_CORE_INFO("Null renderer: {0} vertex buffers, {1} index buffers, {2} "
+               "shader stages, {3} shaders, {4} vertex arrays, {5} textures, "
+               "{6} bytes uploaded, {7} bytes read back",
+               s_Stats.VertexBuffers, s_Stats.IndexBuffers,
+               s_Stats.ShaderStages, s_Stats.Shaders, s_Stats.VertexArrays,
+               s_Stats.Textures, s_Stats.BytesUploaded, s_Stats.BytesReadBack);
+}
+
+void NullRendererAPI::EndFrame(GraphicsContext *ctx) { s_Stats.Frames++; }
+
+void NullRendererAPI::DrawIndexed(const Ref<VertexArray> vertexArray,
+                                  const DrawRange &range) {
+  s_Stats.DrawCalls++;
+  s_Stats.Indices += range.IndexCount;
+}
+} // namespace MyEngine
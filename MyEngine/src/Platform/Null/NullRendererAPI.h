@@ -0,0 +1,55 @@
+#pragma once
+
+#include "MyEngine/Renderer/RendererAPI.h"
+
+namespace MyEngine {
+// Everything the null backend was asked to do, used to measure the CPU side
+// cost of the engine without any GPU work.
+struct NullRenderStats {
+  uint64_t Frames = 0;
+  uint64_t DrawCalls = 0;
+  uint64_t Indices = 0;
+  uint64_t ShaderBinds = 0;
+  uint64_t VertexArrayBinds = 0;
+  // Binds of the shader or vertex array that was already bound
+  uint64_t RedundantBinds = 0;
+
+  uint64_t VertexBuffers = 0;
+  uint64_t IndexBuffers = 0;
+  uint64_t ShaderStages = 0;
+  uint64_t Shaders = 0;
+  uint64_t VertexArrays = 0;
+  uint64_t Textures = 0;
+
+  uint64_t BytesUploaded = 0;
+  uint64_t BytesReadBack = 0;
+};
+
+class NullRendererAPI : public RendererAPI {
+public:
+  virtual ~NullRendererAPI() = default;
+
+  virtual void Init() override;
+  virtual void Shutdown() override;
+  virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width,
+                           uint32_t height) override {}
+  virtual void SetClearColor(const glm::vec4 &color) override {}
+  virtual void Clear() override {}
+  virtual void WaitForIdle() override {}
+
+  virtual void SetLineWidth(float width) override {}
+
+  virtual bool BeginFrame(GraphicsContext *ctx) override { return true; }
+  virtual void EndFrame(GraphicsContext *ctx) override;
+  virtual void PresentFrame(GraphicsContext *ctx) override {}
+
+  virtual void DrawIndexed(const Ref<VertexArray> vertexArray,
+                           const DrawRange &range) override;
+
+  static NullRenderStats &GetStats() { return s_Stats; }
+  static void ResetStats() { s_Stats = NullRenderStats(); }
+
+private:
+  static NullRenderStats s_Stats;
+};
+} // namespace MyEngine
@@ -0,0 +1,27 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Null/NullShader.h"
+
+namespace MyEngine {
+static const NullShader *s_Bound = nullptr;
+
+NullShader::NullShader(const std::string &name,
+                       const std::vector<Ref<ShaderStage>> stages)
+    : m_Name(name), m_Stages(stages) {
+  NullRendererAPI::GetStats().Shaders++;
+}
+
+NullShader::~NullShader() {
+  if (s_Bound == this) {
+    s_Bound = nullptr;
+  }
+}
+
+void NullShader::Bind() {
+  NullRenderStats &stats = NullRendererAPI::GetStats();
+  stats.ShaderBinds++;
+  stats.RedundantBinds += s_Bound == this;
+  s_Bound = this;
+}
+} // namespace MyEngine
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "MyEngine/Renderer/Buffer.h"
+#include "MyEngine/Renderer/Shader.h"
+
+namespace MyEngine {
+class NullShader : public Shader {
+public:
+  NullShader(const std::string &name,
+             const std::vector<Ref<ShaderStage>> stages);
+  virtual ~NullShader() override;
+  virtual void Bind() override;
+
+private:
+  virtual void SetData(const std::string &name, ShaderDataType type,
+                       const void *data, uint32_t count) override {}
+
+  std::string m_Name;
+  std::vector<Ref<ShaderStage>> m_Stages;
+};
+} // namespace MyEngine
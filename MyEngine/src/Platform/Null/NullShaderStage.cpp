@@ -0,0 +1,11 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Null/NullShaderStage.h"
+
+namespace MyEngine {
+NullShaderStage::NullShaderStage(const std::string &filepath, StageType type)
+    : m_Type(type) {
+  NullRendererAPI::GetStats().ShaderStages++;
+}
+} // namespace MyEngine
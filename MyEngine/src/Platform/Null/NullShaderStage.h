@@ -0,0 +1,16 @@
+#pragma once
+
+#include "MyEngine/Renderer/ShaderStage.h"
+
+namespace MyEngine {
+class NullShaderStage : public ShaderStage {
+public:
+  NullShaderStage(const std::string &filepath, StageType type);
+  virtual ~NullShaderStage() override = default;
+
+  virtual StageType GetType() const override { return m_Type; }
+
+private:
+  StageType m_Type;
+};
+} // namespace MyEngine
@@ -0,0 +1,21 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Null/NullTexture.h"
+
+namespace MyEngine {
+NullTexture2D::NullTexture2D(const TextureSpecification &specification)
+    : m_Specification(specification) {
+  NullRendererAPI::GetStats().Textures++;
+}
+
+NullTexture2D::NullTexture2D(const std::string &filepath,
+                             const TextureSpecification &specification)
+    : m_Specification(specification) {
+  NullRendererAPI::GetStats().Textures++;
+}
+
+void NullTexture2D::SetData(const void *data, uint32_t size) {
+  NullRendererAPI::GetStats().BytesUploaded += size;
+}
+} // namespace MyEngine
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "MyEngine/Renderer/Texture.h"
+
+namespace MyEngine {
+// Never decodes anything, path textures keep the size of their specification
+class NullTexture2D : public Texture2D {
+public:
+  NullTexture2D(const TextureSpecification &specification);
+  NullTexture2D(const std::string &filepath,
+                const TextureSpecification &specification);
+  virtual ~NullTexture2D() = default;
+
+  virtual uint32_t GetWidth() const override { return m_Specification.Width; }
+  virtual uint32_t GetHeight() const override {
+    return m_Specification.Height;
+  }
+
+  virtual bool IsLoaded() const override { return true; }
+  virtual uint32_t GetIndex() const override { return 0; }
+  virtual void RequestSize(uint32_t pixels) override {}
+
+  virtual void SetData(const void *data, uint32_t size) override;
+
+private:
+  TextureSpecification m_Specification;
+};
+} // namespace MyEngine
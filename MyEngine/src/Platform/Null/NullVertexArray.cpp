@@ -0,0 +1,33 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullRendererAPI.h"
+#include "Platform/Null/NullVertexArray.h"
+
+namespace MyEngine {
+static const NullVertexArray *s_Bound = nullptr;
+
+NullVertexArray::NullVertexArray() {
+  NullRendererAPI::GetStats().VertexArrays++;
+}
+
+NullVertexArray::~NullVertexArray() {
+  if (s_Bound == this) {
+    s_Bound = nullptr;
+  }
+}
+
+void NullVertexArray::Bind() const {
+  NullRenderStats &stats = NullRendererAPI::GetStats();
+  stats.VertexArrayBinds++;
+  stats.RedundantBinds += s_Bound == this;
+  s_Bound = this;
+}
+
+void NullVertexArray::AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) {
+  m_VertexBuffers.push_back(vertexBuffer);
+}
+
+void NullVertexArray::SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) {
+  m_IndexBuffer = indexBuffer;
+}
+} // namespace MyEngine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "MyEngine/Renderer/VertexArray.h"
+
+namespace MyEngine {
+class NullVertexArray : public VertexArray {
+public:
+  NullVertexArray();
+  virtual ~NullVertexArray();
+
+  virtual void Bind() const override;
+  virtual void Unbind() const override {}
+  virtual void Draw(const DrawRange &range) const override {}
+
+  virtual void AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) override;
+  virtual void SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) override;
+
+  virtual const std::vector<Ref<VertexBuffer>> &
+  GetVertexBuffers() const override {
+    return m_VertexBuffers;
+  }
+  virtual const Ref<IndexBuffer> &GetIndexBuffer() const override {
+    return m_IndexBuffer;
+  }
+
+private:
+  std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+  Ref<IndexBuffer> m_IndexBuffer;
+};
+} // namespace MyEngine
@@ -0,0 +1,17 @@
+#include "mepch.h"
+
+#include "Platform/Null/NullWindow.h"
+
+namespace MyEngine {
+NullWindow::NullWindow(const WindowProperties &properties) {}
+
+void NullWindow::Init(const WindowProperties &properties) {
+  m_Data.Title = properties.Title;
+  m_Data.Width = properties.Width;
+  m_Data.Height = properties.Height;
+  m_Data.VSync = false;
+
+  ME_CORE_INFO("Creating null window {0} ({1}, {2})", properties.Title,
+               properties.Width, properties.Height);
+}
+} // namespace MyEngine
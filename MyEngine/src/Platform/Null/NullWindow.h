@@ -0,0 +1,44 @@
+#pragma once
+
+#include "MyEngine/Core/Window.h"
+
+namespace MyEngine {
+// A window that never touches the display, used with the null renderer on
+// machines without one. It has no graphics context and emits no events.
+class NullWindow : public Window {
+public:
+  NullWindow(const WindowProperties &properties);
+  virtual ~NullWindow() = default;
+  virtual void Init(const WindowProperties &properties) override;
+
+  virtual void OnUpdate() override {}
+
+  virtual uint32_t GetWidth() const override { return m_Data.Width; }
+  virtual uint32_t GetHeight() const override { return m_Data.Height; }
+
+  virtual bool IsMinimized() const override { return false; }
+
+  void SetEventCallback(const EventCallbackFn &callback) override {
+    m_Data.EventCallback = callback;
+  }
+
+  virtual void SetVSync(bool enabled) override { m_Data.VSync = enabled; }
+  virtual bool IsVsyncEnabled() const override { return m_Data.VSync; }
+
+  virtual void *GetNativeWindow() const override { return nullptr; }
+  virtual GraphicsContext *GetGraphicsContext() const override {
+    return nullptr;
+  }
+
+  struct WindowData {
+    std::string Title;
+    uint32_t Width, Height;
+    bool VSync;
+
+    EventCallbackFn EventCallback;
+  };
+
+private:
+  WindowData m_Data;
+};
+} // namespace MyEngine
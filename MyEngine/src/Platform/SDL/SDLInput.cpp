@@ -1,35 +1,41 @@
 #include "mepch.h"
 
 #include "MyEngine/Core/Input.h"
+#include "MyEngine/Core/InputRecording.h"
 #include <SDL_keyboard.h>
 #include <SDL_mouse.h>
 
 namespace MyEngine {
 bool Input::IsKeyPressed(const KeyCode key) {
+  if (InputRecording::IsReplaying()) {
+    return InputRecording::IsKeyPressed(key);
+  }
+
+  // Key codes are SDL keycodes, the keyboard state is indexed by scancode
   const Uint8 *state = SDL_GetKeyboardState(nullptr);
-  return state[key];
+  return state[SDL_GetScancodeFromKey((SDL_Keycode)key)];
 }
 
 bool Input::IsMouseButtonPressed(const MouseCode button) {
+  if (InputRecording::IsReplaying()) {
+    return InputRecording::IsMouseButtonPressed(button);
+  }
+
   const Uint32 state = SDL_GetMouseState(nullptr, nullptr);
-  return SDL_BUTTON(state) == button;
+  return state & SDL_BUTTON(button);
 }
 
 Vector2 Input::GetMousePosition() {
+  if (InputRecording::IsReplaying()) {
+    return InputRecording::GetMousePosition();
+  }
+
   int x, y;
   const Uint32 state = SDL_GetMouseState(&x, &y);
   return {x, y};
 }
 
-float Input::GetMouseX() {
-  int x;
-  const Uint32 state = SDL_GetMouseState(&x, nullptr);
-  return x;
-}
+float Input::GetMouseX() { return GetMousePosition().x; }
 
-float Input::GetMouseY() {
-  int y;
-  const Uint32 state = SDL_GetMouseState(nullptr, &y);
-  return y;
-}
+float Input::GetMouseY() { return GetMousePosition().y; }
 } // namespace MyEngine
@@ -6,6 +6,7 @@
 #include "MyEngine/Events/KeyEvent.h"
 #include "MyEngine/Events/MouseEvent.h"
 #include "MyEngine/Renderer/GraphicsContext.h"
+#include "MyEngine/Renderer/RendererAPI.h"
 #include <SDL_video.h>
 
 // TODO: Import graphics context
@@ -35,6 +36,7 @@ static int windowEventCallback(void *pData, SDL_Event *e) {
       WindowCloseEvent event;
       data.EventCallback(event, (void *)e);
     }
+    break;
   }
   case SDL_KEYDOWN: {
     KeyCode code = (KeyCode)e->key.keysym.sym;
@@ -82,6 +84,7 @@ void SDLWindow::Init(const WindowProperties &properties) {
   m_Data.Title = properties.Title;
   m_Data.Width = properties.Width;
   m_Data.Height = properties.Height;
+  m_Data.VSync = properties.VSync;
 
   ME_CORE_INFO("Creating window {0} ({1}, {2})", properties.Title,
                properties.Width, properties.Height);
@@ -93,9 +96,10 @@ void SDLWindow::Init(const WindowProperties &properties) {
                        SDL_GetError());
     }
 
-    // TODO: Add api switch
-    SDL_WindowFlags windowFlags =
-        (SDL_WindowFlags)(SDL_WINDOW_VULKAN | SDL_WINDOW_RESIZABLE);
+    SDL_WindowFlags windowFlags = SDL_WINDOW_RESIZABLE;
+    if (RendererAPI::GetAPI() == RendererAPI::API::Vulkan) {
+      windowFlags = (SDL_WindowFlags)(windowFlags | SDL_WINDOW_VULKAN);
+    }
 
     m_Window = SDL_CreateWindow("Vulkan Engine", SDL_WINDOWPOS_UNDEFINED,
                                 SDL_WINDOWPOS_UNDEFINED, (int)m_Data.Width,
@@ -132,7 +136,7 @@ unsigned int SDLWindow::GetWidth() const {
 unsigned int SDLWindow::GetHeight() const {
   int width, height;
   SDL_GetWindowSize(m_Window, &width, &height);
-  return width;
+  return height;
 }
 
 bool SDLWindow::IsMinimized() const {
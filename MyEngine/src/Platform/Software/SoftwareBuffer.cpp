@@ -0,0 +1,47 @@
+#include "mepch.h"
+
+#include "Platform/Software/SoftwareBuffer.h"
+
+#include <cstring>
+
+namespace MyEngine {
+// +===============+
+// | VERTEX BUFFER |
+// +===============+
+SoftwareVertexBuffer::SoftwareVertexBuffer(uint32_t size)
+    : m_Data(sizeof(Vertex) * size) {}
+
+SoftwareVertexBuffer::SoftwareVertexBuffer(Vertex *vertices, uint32_t size)
+    : SoftwareVertexBuffer(static_cast<const void *>(vertices),
+                           sizeof(Vertex) * size) {}
+
+SoftwareVertexBuffer::SoftwareVertexBuffer(const void *vertices, uint32_t size)
+    : m_Data(size) {
+  if (vertices != nullptr) {
+    memcpy(m_Data.data(), vertices, m_Data.size());
+  }
+}
+
+void SoftwareVertexBuffer::WriteData(const void *pData, uint32_t offset,
+                                     uint32_t size) {
+  ME_CORE_ASSERT((uint64_t)offset + size <= m_Data.size(),
+                 "Vertex data is larger than the buffer!");
+  memcpy(m_Data.data() + offset, pData, size);
+}
+
+// +==============+
+// | INDEX BUFFER |
+// +==============+
+SoftwareIndexBuffer::SoftwareIndexBuffer(uint32_t *indices, uint32_t count)
+    : m_Indices(indices, indices + count) {}
+
+SoftwareIndexBuffer::SoftwareIndexBuffer(uint32_t count, IndexFormat format)
+    : m_Indices(count) {}
+
+void SoftwareIndexBuffer::WriteData(const uint32_t *indices, uint32_t offset,
+                                    uint32_t count) {
+  ME_CORE_ASSERT((uint64_t)offset + count <= m_Indices.size(),
+                 "Index data is larger than the buffer!");
+  std::copy(indices, indices + count, m_Indices.begin() + offset);
+}
+} // namespace MyEngine
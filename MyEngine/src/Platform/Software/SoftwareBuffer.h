@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MyEngine/Renderer/Buffer.h"
+
+namespace MyEngine {
+class SoftwareVertexBuffer : public VertexBuffer {
+public:
+  SoftwareVertexBuffer(uint32_t size);
+  SoftwareVertexBuffer(Vertex *vertices, uint32_t size);
+  SoftwareVertexBuffer(const void *vertices, uint32_t size);
+  virtual ~SoftwareVertexBuffer() = default;
+
+  virtual void Bind() const override {}
+  virtual void Unbind() const override {}
+
+  virtual const BufferLayout &GetLayout() const override { return m_Layout; }
+  virtual void SetLayout(const BufferLayout &layout) override {
+    m_Layout = layout;
+  }
+
+  // Vertices in the format of the layout
+  const uint8_t *GetData() const { return m_Data.data(); }
+  virtual uint32_t GetSize() const override { return (uint32_t)m_Data.size(); }
+
+protected:
+  virtual void WriteData(const void *pData, uint32_t offset,
+                         uint32_t size) override;
+  virtual void *MapData(uint32_t offset, uint32_t size) override {
+    return m_Data.data() + offset;
+  }
+
+private:
+  // Raw bytes since vertices may be in any format
+  std::vector<uint8_t> m_Data;
+  BufferLayout m_Layout;
+};
+
+class SoftwareIndexBuffer : public IndexBuffer {
+public:
+  SoftwareIndexBuffer(uint32_t *indices, uint32_t count);
+  // Always stores 32 bit indices, the format only matters to GPU backends
+  SoftwareIndexBuffer(uint32_t count, IndexFormat format);
+  virtual ~SoftwareIndexBuffer() = default;
+
+  virtual void Bind() const override {}
+  virtual void Unbind() const override {}
+
+  virtual uint32_t GetCount() const override {
+    return (uint32_t)m_Indices.size();
+  }
+
+  const uint32_t *GetIndices() const { return m_Indices.data(); }
+
+protected:
+  virtual void WriteData(const uint32_t *indices, uint32_t offset,
+                         uint32_t count) override;
+  virtual uint32_t *MapData(uint32_t offset, uint32_t count) override {
+    return m_Indices.data() + offset;
+  }
+
+private:
+  std::vector<uint32_t> m_Indices;
+};
+} // namespace MyEngine
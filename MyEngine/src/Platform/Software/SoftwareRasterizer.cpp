@@ -0,0 +1,399 @@
+#include "mepch.h"
+
+#include "Platform/Software/SoftwareRasterizer.h"
+
+#include "MyEngine/Core/ThreadPool.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ME_SOFTWARE_SSE2
+#endif
+
+namespace MyEngine {
+// Vertices are snapped to 1/16th of a pixel so the fill rule is stable
+static constexpr float s_SubpixelScale = 16.0f;
+// Clip planes keep w away from zero on top of the near and far planes
+static constexpr float s_MinW = 1e-5f;
+
+// +======+
+// | SIMD |
+// +======+
+// Each variant evaluates Lanes horizontally adjacent pixels at once.
+namespace {
+#if defined(__AVX2__)
+struct Simd {
+  using F = __m256;
+  using M = __m256;
+  static constexpr int32_t Lanes = 8;
+
+  static F Set1(float value) { return _mm256_set1_ps(value); }
+  static F Ramp() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+  static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+  static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+  static F Div(F a, F b) { return _mm256_div_ps(a, b); }
+  static F Clamp01(F a) {
+    return _mm256_min_ps(_mm256_max_ps(a, _mm256_setzero_ps()),
+                         _mm256_set1_ps(1.0f));
+  }
+
+  static M CmpGe(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+  static M CmpGt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  static M And(M a, M b) { return _mm256_and_ps(a, b); }
+  static bool Any(M mask) { return _mm256_movemask_ps(mask) != 0; }
+
+  static __m256i ToByte(F value) {
+    return _mm256_cvttps_epi32(_mm256_add_ps(
+        _mm256_mul_ps(Clamp01(value), _mm256_set1_ps(255.0f)),
+        _mm256_set1_ps(0.5f)));
+  }
+
+  static void StoreColor(uint32_t *dst, F r, F g, F b, F a, M mask) {
+    __m256i color = _mm256_or_si256(
+        _mm256_or_si256(_mm256_slli_epi32(ToByte(a), 24),
+                        _mm256_slli_epi32(ToByte(r), 16)),
+        _mm256_or_si256(_mm256_slli_epi32(ToByte(g), 8), ToByte(b)));
+    _mm256_maskstore_epi32((int *)dst, _mm256_castps_si256(mask), color);
+  }
+};
+#elif defined(ME_SOFTWARE_SSE2)
+struct Simd {
+  using F = __m128;
+  using M = __m128;
+  static constexpr int32_t Lanes = 4;
+
+  static F Set1(float value) { return _mm_set1_ps(value); }
+  static F Ramp() { return _mm_setr_ps(0, 1, 2, 3); }
+  static F Add(F a, F b) { return _mm_add_ps(a, b); }
+  static F Mul(F a, F b) { return _mm_mul_ps(a, b); }
+  static F Div(F a, F b) { return _mm_div_ps(a, b); }
+  static F Clamp01(F a) {
+    return _mm_min_ps(_mm_max_ps(a, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+  }
+
+  static M CmpGe(F a, F b) { return _mm_cmpge_ps(a, b); }
+  static M CmpGt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+  static M And(M a, M b) { return _mm_and_ps(a, b); }
+  static bool Any(M mask) { return _mm_movemask_ps(mask) != 0; }
+
+  static __m128i ToByte(F value) {
+    return _mm_cvttps_epi32(
+        _mm_add_ps(_mm_mul_ps(Clamp01(value), _mm_set1_ps(255.0f)),
+                   _mm_set1_ps(0.5f)));
+  }
+
+  static void StoreColor(uint32_t *dst, F r, F g, F b, F a, M mask) {
+    __m128i color =
+        _mm_or_si128(_mm_or_si128(_mm_slli_epi32(ToByte(a), 24),
+                                  _mm_slli_epi32(ToByte(r), 16)),
+                     _mm_or_si128(_mm_slli_epi32(ToByte(g), 8), ToByte(b)));
+    __m128i select = _mm_castps_si128(mask);
+    __m128i previous = _mm_loadu_si128((const __m128i *)dst);
+    _mm_storeu_si128((__m128i *)dst,
+                     _mm_or_si128(_mm_and_si128(select, color),
+                                  _mm_andnot_si128(select, previous)));
+  }
+};
+#else
+struct Simd {
+  using F = float;
+  using M = bool;
+  static constexpr int32_t Lanes = 1;
+
+  static F Set1(float value) { return value; }
+  static F Ramp() { return 0.0f; }
+  static F Add(F a, F b) { return a + b; }
+  static F Mul(F a, F b) { return a * b; }
+  static F Div(F a, F b) { return a / b; }
+  static F Clamp01(F a) { return std::min(std::max(a, 0.0f), 1.0f); }
+
+  static M CmpGe(F a, F b) { return a >= b; }
+  static M CmpGt(F a, F b) { return a > b; }
+  static M And(M a, M b) { return a && b; }
+  static bool Any(M mask) { return mask; }
+
+  static uint32_t ToByte(F value) {
+    return (uint32_t)(Clamp01(value) * 255.0f + 0.5f);
+  }
+
+  static void StoreColor(uint32_t *dst, F r, F g, F b, F a, M mask) {
+    if (mask) {
+      *dst = (ToByte(a) << 24) | (ToByte(r) << 16) | (ToByte(g) << 8) |
+             ToByte(b);
+    }
+  }
+};
+#endif
+} // namespace
+
+static uint32_t PackColor(const Vector4 &color) {
+  auto toByte = [](float value) {
+    return (uint32_t)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+  };
+  return (toByte(color.a) << 24) | (toByte(color.r) << 16) |
+         (toByte(color.g) << 8) | toByte(color.b);
+}
+
+// +==========+
+// | CLIPPING |
+// +==========+
+static float NearDistance(const Vector4 &p) { return p.z; }
+static float FarDistance(const Vector4 &p) { return p.w - p.z; }
+static float WDistance(const Vector4 &p) { return p.w - s_MinW; }
+
+// Sutherland-Hodgman against a single plane, returns the output vertex count
+static uint32_t ClipPolygon(const SoftwareClipVertex *in, uint32_t count,
+                            SoftwareClipVertex *out,
+                            float (*distance)(const Vector4 &)) {
+  uint32_t outCount = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    const SoftwareClipVertex &a = in[i];
+    const SoftwareClipVertex &b = in[(i + 1) % count];
+    float da = distance(a.Position);
+    float db = distance(b.Position);
+
+    if (da >= 0.0f) {
+      out[outCount++] = a;
+    }
+    if ((da >= 0.0f) != (db >= 0.0f)) {
+      float t = da / (da - db);
+      out[outCount].Position = a.Position + (b.Position - a.Position) * t;
+      out[outCount].Color = a.Color + (b.Color - a.Color) * t;
+      outCount++;
+    }
+  }
+
+  return outCount;
+}
+
+static bool IsInside(const Vector4 &p) {
+  return NearDistance(p) >= 0.0f && FarDistance(p) >= 0.0f &&
+         WDistance(p) >= 0.0f;
+}
+
+// +=============+
+// | RASTERIZER  |
+// +=============+
+void SoftwareRasterizer::Resize(uint32_t width, uint32_t height) {
+  if (width == m_Width && height == m_Height) {
+    return;
+  }
+
+  m_Width = width;
+  m_Height = height;
+  m_TilesX = (width + TileSize - 1) / TileSize;
+  m_TilesY = (height + TileSize - 1) / TileSize;
+  m_Stride = m_TilesX * TileSize;
+
+  m_Pixels.assign((size_t)m_Stride * m_TilesY * TileSize, m_ClearColor);
+  m_Bins.resize((size_t)m_TilesX * m_TilesY);
+}
+
+void SoftwareRasterizer::SetClearColor(const Vector4 &color) {
+  m_ClearColor = PackColor(color);
+}
+
+void SoftwareRasterizer::BeginFrame() {
+  m_Triangles.clear();
+  for (std::vector<uint32_t> &bin : m_Bins) {
+    bin.clear();
+  }
+}
+
+void SoftwareRasterizer::DrawTriangles(const SoftwareClipVertex *vertices,
+                                       const uint32_t *indices,
+                                       uint32_t indexCount) {
+  for (uint32_t i = 0; i + 2 < indexCount; i += 3) {
+    const SoftwareClipVertex &v0 = vertices[indices[i]];
+    const SoftwareClipVertex &v1 = vertices[indices[i + 1]];
+    const SoftwareClipVertex &v2 = vertices[indices[i + 2]];
+
+    if (IsInside(v0.Position) && IsInside(v1.Position) &&
+        IsInside(v2.Position)) {
+      SetupTriangle(v0, v1, v2);
+      continue;
+    }
+
+    // Every plane can add one vertex
+    SoftwareClipVertex a[6] = {v0, v1, v2};
+    SoftwareClipVertex b[6];
+    uint32_t count = ClipPolygon(a, 3, b, NearDistance);
+    count = ClipPolygon(b, count, a, FarDistance);
+    count = ClipPolygon(a, count, b, WDistance);
+
+    for (uint32_t v = 1; v + 1 < count; v++) {
+      SetupTriangle(b[0], b[v], b[v + 1]);
+    }
+  }
+}
+
+void SoftwareRasterizer::SetupTriangle(const SoftwareClipVertex &v0,
+                                       const SoftwareClipVertex &v1,
+                                       const SoftwareClipVertex &v2) {
+  const SoftwareClipVertex *vertices[3] = {&v0, &v1, &v2};
+
+  Triangle triangle;
+  float x[3], y[3];
+  for (int i = 0; i < 3; i++) {
+    const Vector4 &p = vertices[i]->Position;
+    float invW = 1.0f / p.w;
+    float screenX = (p.x * invW * 0.5f + 0.5f) * m_Width;
+    float screenY = (p.y * invW * 0.5f + 0.5f) * m_Height;
+    x[i] = std::round(screenX * s_SubpixelScale) / s_SubpixelScale;
+    y[i] = std::round(screenY * s_SubpixelScale) / s_SubpixelScale;
+
+    triangle.InvW[i] = invW;
+    triangle.ColorOverW[i] = vertices[i]->Color * invW;
+  }
+
+  // Twice the signed area, negative for the front faces. They are flipped
+  // so the edge setup below always sees a positive area.
+  float area2 = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+  if (!(area2 < 0.0f)) {
+    return;
+  }
+  std::swap(x[1], x[2]);
+  std::swap(y[1], y[2]);
+  std::swap(triangle.InvW[1], triangle.InvW[2]);
+  std::swap(triangle.ColorOverW[1], triangle.ColorOverW[2]);
+  area2 = -area2;
+  triangle.InvArea = 1.0f / area2;
+
+  for (int i = 0; i < 3; i++) {
+    int a = (i + 1) % 3;
+    int b = (i + 2) % 3;
+    float dx = x[b] - x[a];
+    float dy = y[b] - y[a];
+    triangle.TopLeft[i] = dy < 0.0f || (dy == 0.0f && dx > 0.0f);
+
+    // Shared edges are always evaluated from the same end point so both
+    // triangles get the exact same value with opposite signs, together with
+    // the fill rule no pixel is drawn twice or skipped.
+    bool flip = x[b] < x[a] || (x[b] == x[a] && y[b] < y[a]);
+    int p = flip ? b : a;
+    int q = flip ? a : b;
+    float px = x[q] - x[p];
+    float py = y[q] - y[p];
+    float sign = flip ? -1.0f : 1.0f;
+    triangle.A[i] = sign * -py;
+    triangle.B[i] = sign * px;
+    triangle.C[i] = sign * (py * x[p] - px * y[p]);
+  }
+
+  float minX = std::min({x[0], x[1], x[2]});
+  float maxX = std::max({x[0], x[1], x[2]});
+  float minY = std::min({y[0], y[1], y[2]});
+  float maxY = std::max({y[0], y[1], y[2]});
+  triangle.MinX = (int32_t)std::max(std::floor(minX), 0.0f);
+  triangle.MinY = (int32_t)std::max(std::floor(minY), 0.0f);
+  triangle.MaxX = (int32_t)std::min(std::ceil(maxX), (float)m_Width - 1.0f);
+  triangle.MaxY = (int32_t)std::min(std::ceil(maxY), (float)m_Height - 1.0f);
+  if (triangle.MinX > triangle.MaxX || triangle.MinY > triangle.MaxY) {
+    return;
+  }
+
+  uint32_t index = (uint32_t)m_Triangles.size();
+  m_Triangles.push_back(triangle);
+
+  for (int32_t tileY = triangle.MinY / TileSize;
+       tileY <= triangle.MaxY / (int32_t)TileSize; tileY++) {
+    for (int32_t tileX = triangle.MinX / TileSize;
+         tileX <= triangle.MaxX / (int32_t)TileSize; tileX++) {
+      m_Bins[tileY * m_TilesX + tileX].push_back(index);
+    }
+  }
+}
+
+void SoftwareRasterizer::Resolve() {
+  ThreadPool::Get().ParallelFor(
+      m_TilesX * m_TilesY, [this](uint32_t tile) { RasterizeTile(tile); });
+}
+
+void SoftwareRasterizer::RasterizeTile(uint32_t tile) {
+  int32_t tileX = (tile % m_TilesX) * TileSize;
+  int32_t tileY = (tile / m_TilesX) * TileSize;
+
+  for (uint32_t y = 0; y < TileSize; y++) {
+    uint32_t *row = m_Pixels.data() + (size_t)(tileY + y) * m_Stride + tileX;
+    std::fill(row, row + TileSize, m_ClearColor);
+  }
+
+  for (uint32_t index : m_Bins[tile]) {
+    RasterizeTriangle(m_Triangles[index], tileX, tileY);
+  }
+}
+
+void SoftwareRasterizer::RasterizeTriangle(const Triangle &triangle,
+                                           int32_t tileX, int32_t tileY) {
+  using F = Simd::F;
+  using M = Simd::M;
+
+  int32_t x0 = std::max(triangle.MinX, tileX);
+  int32_t x1 = std::min(triangle.MaxX, tileX + (int32_t)TileSize - 1);
+  int32_t y0 = std::max(triangle.MinY, tileY);
+  int32_t y1 = std::min(triangle.MaxY, tileY + (int32_t)TileSize - 1);
+  if (x0 > x1 || y0 > y1) {
+    return;
+  }
+  // Tiles are a multiple of the lane count wide, so are the padded rows
+  x0 &= ~(Simd::Lanes - 1);
+
+  const F zero = Simd::Set1(0.0f);
+  const F ramp = Simd::Add(Simd::Ramp(), Simd::Set1(0.5f));
+  const F invArea = Simd::Set1(triangle.InvArea);
+  F a[3], invW[3], r[3], g[3], b[3], alpha[3];
+  for (int i = 0; i < 3; i++) {
+    a[i] = Simd::Set1(triangle.A[i]);
+    invW[i] = Simd::Set1(triangle.InvW[i]);
+    r[i] = Simd::Set1(triangle.ColorOverW[i].r);
+    g[i] = Simd::Set1(triangle.ColorOverW[i].g);
+    b[i] = Simd::Set1(triangle.ColorOverW[i].b);
+    alpha[i] = Simd::Set1(triangle.ColorOverW[i].a);
+  }
+
+  auto interpolate = [](const F *values, const F &l0, const F &l1,
+                        const F &l2) {
+    return Simd::Add(Simd::Add(Simd::Mul(values[0], l0),
+                               Simd::Mul(values[1], l1)),
+                     Simd::Mul(values[2], l2));
+  };
+
+  for (int32_t y = y0; y <= y1; y++) {
+    float centerY = (float)y + 0.5f;
+    F row[3];
+    for (int i = 0; i < 3; i++) {
+      row[i] = Simd::Set1(triangle.B[i] * centerY + triangle.C[i]);
+    }
+
+    uint32_t *pixels = m_Pixels.data() + (size_t)y * m_Stride;
+    for (int32_t x = x0; x <= x1; x += Simd::Lanes) {
+      F centerX = Simd::Add(Simd::Set1((float)x), ramp);
+
+      F e[3];
+      M mask;
+      for (int i = 0; i < 3; i++) {
+        e[i] = Simd::Add(Simd::Mul(a[i], centerX), row[i]);
+        M inside = triangle.TopLeft[i] ? Simd::CmpGe(e[i], zero)
+                                       : Simd::CmpGt(e[i], zero);
+        mask = i == 0 ? inside : Simd::And(mask, inside);
+      }
+      if (!Simd::Any(mask)) {
+        continue;
+      }
+
+      F l0 = Simd::Mul(e[0], invArea);
+      F l1 = Simd::Mul(e[1], invArea);
+      F l2 = Simd::Mul(e[2], invArea);
+      F w = Simd::Div(Simd::Set1(1.0f), interpolate(invW, l0, l1, l2));
+
+      Simd::StoreColor(pixels + x, Simd::Mul(interpolate(r, l0, l1, l2), w),
+                       Simd::Mul(interpolate(g, l0, l1, l2), w),
+                       Simd::Mul(interpolate(b, l0, l1, l2), w),
+                       Simd::Mul(interpolate(alpha, l0, l1, l2), w), mask);
+    }
+  }
+}
+} // namespace MyEngine
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Math/Math.h"
+
+namespace MyEngine {
+// Output of the vertex stage, the position is in vulkan clip space.
+struct SoftwareClipVertex {
+  Vector4 Position;
+  Vector4 Color;
+};
+
+// Tile based triangle rasterizer writing ARGB8888 pixels.
+//
+// Triangles are clipped against the near and far planes, culled and set up
+// when they are drawn, then binned into TileSize square tiles. Resolve clears
+// and rasterizes every tile in parallel, each tile draws its triangles in
+// submission order so the output does not depend on the thread count. Edge
+// functions are evaluated several pixels at a time with SSE2 (AVX2 when built
+// with -DME_WITH_AVX2=ON), colors are interpolated perspective correct.
+//
+// The pipeline state matches the vulkan backend: counter clockwise triangles
+// (in vulkan's y down framebuffer convention) are front faces, top left fill
+// rule, no blending.
+class SoftwareRasterizer {
+public:
+  static constexpr uint32_t TileSize = 64;
+
+  void Resize(uint32_t width, uint32_t height);
+  void SetClearColor(const Vector4 &color);
+
+  void BeginFrame();
+  void DrawTriangles(const SoftwareClipVertex *vertices,
+                     const uint32_t *indices, uint32_t indexCount);
+  void Resolve();
+
+  uint32_t GetWidth() const { return m_Width; }
+  uint32_t GetHeight() const { return m_Height; }
+  // Rows are padded to whole tiles, the stride is in pixels.
+  uint32_t GetStride() const { return m_Stride; }
+  const uint32_t *GetPixels() const { return m_Pixels.data(); }
+
+  uint32_t GetTriangleCount() const { return (uint32_t)m_Triangles.size(); }
+
+private:
+  struct Triangle {
+    // Edge functions A * x + B * y + C, one per edge opposite to a vertex
+    float A[3], B[3], C[3];
+    bool TopLeft[3];
+    float InvArea;
+
+    float InvW[3];
+    Vector4 ColorOverW[3];
+
+    int32_t MinX, MinY, MaxX, MaxY;
+  };
+
+  void SetupTriangle(const SoftwareClipVertex &v0, const SoftwareClipVertex &v1,
+                     const SoftwareClipVertex &v2);
+  void RasterizeTile(uint32_t tile);
+  void RasterizeTriangle(const Triangle &triangle, int32_t tileX,
+                         int32_t tileY);
+
+  uint32_t m_Width = 0, m_Height = 0, m_Stride = 0;
+  uint32_t m_TilesX = 0, m_TilesY = 0;
+  std::vector<uint32_t> m_Pixels;
+  uint32_t m_ClearColor = 0xFF000000;
+
+  std::vector<Triangle> m_Triangles;
+  std::vector<std::vector<uint32_t>> m_Bins;
+};
+} // namespace MyEngine
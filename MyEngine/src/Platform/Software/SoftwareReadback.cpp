@@ -0,0 +1,41 @@
+#include "mepch.h"
+
+#include "Platform/Software/SoftwareBuffer.h"
+#include "Platform/Software/SoftwareReadback.h"
+#include "Platform/Software/SoftwareTexture.h"
+
+namespace MyEngine {
+SoftwareReadback::SoftwareReadback(const Ref<VertexBuffer> &buffer,
+                                   uint32_t offset, uint32_t size) {
+  const SoftwareVertexBuffer *source =
+      static_cast<const SoftwareVertexBuffer *>(buffer.get());
+  ME_CORE_ASSERT((uint64_t)offset + size <= source->GetSize(),
+                 "Readback range is out of bounds!");
+
+  m_Data.assign(source->GetData() + offset, source->GetData() + offset + size);
+}
+
+SoftwareReadback::SoftwareReadback(const Ref<IndexBuffer> &buffer,
+                                   uint32_t offset, uint32_t count) {
+  const SoftwareIndexBuffer *source =
+      static_cast<const SoftwareIndexBuffer *>(buffer.get());
+  ME_CORE_ASSERT((uint64_t)offset + count <= source->GetCount(),
+                 "Readback range is out of bounds!");
+
+  const uint8_t *indices =
+      reinterpret_cast<const uint8_t *>(source->GetIndices() + offset);
+  m_Data.assign(indices, indices + sizeof(uint32_t) * count);
+}
+
+SoftwareReadback::SoftwareReadback(const Ref<Texture2D> &texture) {
+  const SoftwareTexture2D *source =
+      static_cast<const SoftwareTexture2D *>(texture.get());
+  if (!source->IsLoaded()) {
+    return;
+  }
+
+  m_Data = source->GetPixels();
+  m_Width = source->GetWidth();
+  m_Height = source->GetHeight();
+}
+} // namespace MyEngine
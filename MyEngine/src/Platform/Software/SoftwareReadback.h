@@ -0,0 +1,27 @@
+#pragma once
+
+#include "MyEngine/Renderer/Readback.h"
+
+#include <vector>
+
+namespace MyEngine {
+// Buffers and textures live in memory, the data is copied when the readback
+// is created
+class SoftwareReadback : public Readback {
+public:
+  SoftwareReadback(const Ref<VertexBuffer> &buffer, uint32_t offset,
+                   uint32_t size);
+  SoftwareReadback(const Ref<IndexBuffer> &buffer, uint32_t offset,
+                   uint32_t count);
+  SoftwareReadback(const Ref<Texture2D> &texture);
+  virtual ~SoftwareReadback() = default;
+
+  virtual bool IsReady() const override { return true; }
+  virtual Span<const uint8_t> GetData() const override {
+    return Span<const uint8_t>(m_Data.data(), m_Data.size());
+  }
+
+private:
+  std::vector<uint8_t> m_Data;
+};
+} // namespace MyEngine
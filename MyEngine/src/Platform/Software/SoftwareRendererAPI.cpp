@@ -0,0 +1,224 @@
+#include "mepch.h"
+
+#include "Platform/Software/SoftwareRendererAPI.h"
+
+#include "MyEngine/Core/Application.h"
+#include "MyEngine/Core/ThreadPool.h"
+#include "MyEngine/Renderer/Quantize.h"
+#include "MyEngine/Renderer/VertexLayout.h"
+#include "Platform/Software/SoftwareBuffer.h"
+#include "Platform/Software/SoftwareShader.h"
+
+#include <SDL.h>
+#include <cstring>
+
+namespace MyEngine {
+void SoftwareRendererAPI::Init() {
+  ME_CORE_INFO("Using the software renderer on {0} threads",
+               ThreadPool::Get().GetThreadCount() + 1);
+
+  Window &window = Application::Get().GetWindow();
+  m_Rasterizer.Resize(window.GetWidth(), window.GetHeight());
+}
+
+void SoftwareRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width,
+                                      uint32_t height) {
+  m_Rasterizer.Resize(width, height);
+}
+
+void SoftwareRendererAPI::SetClearColor(const glm::vec4 &color) {
+  m_Rasterizer.SetClearColor(color);
+}
+
+bool SoftwareRendererAPI::BeginFrame(GraphicsContext *ctx) {
+  Window &window = Application::Get().GetWindow();
+  if (window.GetWidth() == 0 || window.GetHeight() == 0) {
+    return false;
+  }
+
+  m_Rasterizer.Resize(window.GetWidth(), window.GetHeight());
+  m_Rasterizer.BeginFrame();
+  return true;
+}
+
+void SoftwareRendererAPI::EndFrame(GraphicsContext *ctx) {
+  m_Rasterizer.Resolve();
+}
+
+void SoftwareRendererAPI::PresentFrame(GraphicsContext *ctx) {
+  Window &appWindow = Application::Get().GetWindow();
+  SDL_Window *window = static_cast<SDL_Window *>(appWindow.GetNativeWindow());
+  if (window == nullptr) {
+    return;
+  }
+
+  SDL_Surface *surface = SDL_GetWindowSurface(window);
+  if (surface == nullptr) {
+    ME_CORE_ERROR("Unable to get the window surface: {0}", SDL_GetError());
+    return;
+  }
+
+  int width = std::min(surface->w, (int)m_Rasterizer.GetWidth());
+  int height = std::min(surface->h, (int)m_Rasterizer.GetHeight());
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_LockSurface(surface);
+  }
+  SDL_ConvertPixels(width, height, SDL_PIXELFORMAT_ARGB8888,
+                    m_Rasterizer.GetPixels(),
+                    m_Rasterizer.GetStride() * sizeof(uint32_t),
+                    surface->format->format, surface->pixels, surface->pitch);
+  if (SDL_MUSTLOCK(surface)) {
+    SDL_UnlockSurface(surface);
+  }
+
+  SDL_UpdateWindowSurface(window);
+}
+
+// Reads an attribute like the vertex fetch of the GPU, missing components are
+// filled in from (0, 0, 0, 1)
+static Vector4 ReadAttribute(const uint8_t *vertex,
+                             const BufferElement &element) {
+  const uint8_t *data = vertex + element.Offset;
+  Vector4 result(0.0f, 0.0f, 0.0f, 1.0f);
+  const uint32_t count = std::min(element.GetComponentCount(), 4u);
+  for (uint32_t i = 0; i < count; i++) {
+    switch (element.Type) {
+    case ShaderDataType::Float:
+    case ShaderDataType::Float2:
+    case ShaderDataType::Float3:
+    case ShaderDataType::Float4: {
+      float value;
+      memcpy(&value, data + sizeof(float) * i, sizeof(value));
+      result[i] = value;
+    } break;
+    case ShaderDataType::Int:
+    case ShaderDataType::Int2:
+    case ShaderDataType::Int3:
+    case ShaderDataType::Int4: {
+      int32_t value;
+      memcpy(&value, data + sizeof(int32_t) * i, sizeof(value));
+      result[i] = (float)value;
+    } break;
+    case ShaderDataType::UByte4: {
+      const uint8_t value = data[i];
+      result[i] = element.Normalized ? Quantize::FromUnorm8(value) : value;
+    } break;
+    case ShaderDataType::Byte4: {
+      const int8_t value = (int8_t)data[i];
+      result[i] = element.Normalized ? Quantize::FromSnorm8(value) : value;
+    } break;
+    case ShaderDataType::Short2:
+    case ShaderDataType::Short4: {
+      int16_t value;
+      memcpy(&value, data + sizeof(int16_t) * i, sizeof(value));
+      result[i] = element.Normalized ? Quantize::FromSnorm16(value) : value;
+    } break;
+    case ShaderDataType::Half2:
+    case ShaderDataType::Half4: {
+      uint16_t value;
+      memcpy(&value, data + sizeof(uint16_t) * i, sizeof(value));
+      result[i] = Quantize::HalfToFloat(value);
+    } break;
+    default:
+      break;
+    }
+  }
+  return result;
+}
+
+// Attribute of a vertex array in the buffer holding it
+struct SoftwareAttribute {
+  const uint8_t *Data = nullptr;
+  uint32_t Stride = 0;
+  uint32_t VertexCount = 0;
+  const BufferElement *Element = nullptr;
+};
+
+// Matches inputs by name first and by position across all buffers second,
+// like the pipelines of the Vulkan backend
+static SoftwareAttribute
+FindAttribute(const std::vector<Ref<VertexBuffer>> &buffers,
+              const std::string &name, uint32_t position) {
+  SoftwareAttribute positional;
+  uint32_t index = 0;
+  for (const Ref<VertexBuffer> &vertexBuffer : buffers) {
+    const SoftwareVertexBuffer *buffer =
+        static_cast<const SoftwareVertexBuffer *>(vertexBuffer.get());
+    // Buffers without a layout hold Vertex
+    const BufferLayout &layout = buffer->GetLayout().GetStride() > 0
+                                     ? buffer->GetLayout()
+                                     : DefaultVertexLayout::Get();
+    SoftwareAttribute attribute;
+    attribute.Data = buffer->GetData();
+    attribute.Stride = layout.GetStride();
+    attribute.VertexCount = buffer->GetSize() / layout.GetStride();
+    for (const BufferElement &element : layout) {
+      attribute.Element = &element;
+      if (element.Name == name) {
+        return attribute;
+      }
+      if (index++ == position) {
+        positional = attribute;
+      }
+    }
+  }
+  return positional;
+}
+
+void SoftwareRendererAPI::DrawIndexed(const Ref<VertexArray> vertexArray,
+                                      const DrawRange &range) {
+  const std::vector<Ref<VertexBuffer>> &vertexBuffers =
+      vertexArray->GetVertexBuffers();
+  const Ref<SoftwareIndexBuffer> indexBuffer =
+      std::static_pointer_cast<SoftwareIndexBuffer>(
+          vertexArray->GetIndexBuffer());
+
+  // Built in equivalent of shaders/vertexColor.vert.glsl
+  Matrix4 transform(1.0f);
+  if (const SoftwareShader *shader = SoftwareShader::GetBound()) {
+    transform = shader->GetMat4("u_ViewProjection", Matrix4(1.0f)) *
+                shader->GetMat4("u_Transform", Matrix4(1.0f));
+  }
+
+  const SoftwareAttribute position =
+      FindAttribute(vertexBuffers, "a_position", 0);
+  const SoftwareAttribute color = FindAttribute(vertexBuffers, "a_color", 1);
+  if (position.Element == nullptr) {
+    return;
+  }
+
+  uint32_t vertexCount = position.VertexCount;
+  if (color.Element != nullptr) {
+    vertexCount = std::min(vertexCount, color.VertexCount);
+  }
+  ME_CORE_ASSERT((uint64_t)range.FirstIndex + range.IndexCount <=
+                     indexBuffer->GetCount(),
+                 "Draw range is out of bounds!");
+  const uint32_t *indices = indexBuffer->GetIndices() + range.FirstIndex;
+
+  // Only the vertices the range references, from VertexOffset on, so drawing
+  // one mesh of a shared buffer doesn't transform all of them
+  uint32_t referenced = 0;
+  for (uint32_t i = 0; i < range.IndexCount; i++) {
+    referenced = std::max(referenced, indices[i] + 1);
+  }
+  ME_CORE_ASSERT(range.VertexOffset >= 0 &&
+                     (uint64_t)range.VertexOffset + referenced <= vertexCount,
+                 "Draw range references vertices out of bounds!");
+
+  m_ClipVertices.resize(referenced);
+  for (uint32_t i = 0; i < referenced; i++) {
+    const size_t vertex = (size_t)range.VertexOffset + i;
+    Vector4 vertexPosition = ReadAttribute(
+        position.Data + position.Stride * vertex, *position.Element);
+    vertexPosition.w = 1.0f;
+    m_ClipVertices[i].Position = transform * vertexPosition;
+    m_ClipVertices[i].Color =
+        color.Element ? ReadAttribute(color.Data + color.Stride * vertex,
+                                      *color.Element)
+                      : Vector4(1.0f);
+  }
+
+  m_Rasterizer.DrawTriangles(m_ClipVertices.data(), indices, range.IndexCount);
+}
+} // namespace MyEngine
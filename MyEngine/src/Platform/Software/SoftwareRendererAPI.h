@@ -0,0 +1,36 @@
+#pragma once
+
+#include "MyEngine/Renderer/RendererAPI.h"
+#include "Platform/Software/SoftwareRasterizer.h"
+
+namespace MyEngine {
+// Rasterizes on the CPU, presents into the SDL window surface or keeps the
+// frame offscreen when running without a window.
+class SoftwareRendererAPI : public RendererAPI {
+public:
+  virtual ~SoftwareRendererAPI() = default;
+
+  virtual void Init() override;
+  virtual void Shutdown() override {}
+  virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width,
+                           uint32_t height) override;
+  virtual void SetClearColor(const glm::vec4 &color) override;
+  virtual void Clear() override {}
+  virtual void WaitForIdle() override {}
+
+  virtual void SetLineWidth(float width) override {}
+
+  virtual bool BeginFrame(GraphicsContext *ctx) override;
+  virtual void EndFrame(GraphicsContext *ctx) override;
+  virtual void PresentFrame(GraphicsContext *ctx) override;
+
+  virtual void DrawIndexed(const Ref<VertexArray> vertexArray,
+                           const DrawRange &range) override;
+
+  const SoftwareRasterizer &GetRasterizer() const { return m_Rasterizer; }
+
+private:
+  SoftwareRasterizer m_Rasterizer;
+  std::vector<SoftwareClipVertex> m_ClipVertices;
+};
+} // namespace MyEngine
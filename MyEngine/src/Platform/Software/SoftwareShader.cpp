@@ -0,0 +1,35 @@
+#include "mepch.h"
+
+#include "Platform/Software/SoftwareShader.h"
+
+#include <cstring>
+
+namespace MyEngine {
+SoftwareShader *SoftwareShader::s_BoundShader = nullptr;
+
+SoftwareShader::~SoftwareShader() {
+  if (s_BoundShader == this) {
+    s_BoundShader = nullptr;
+  }
+}
+
+Matrix4 SoftwareShader::GetMat4(const std::string &name,
+                                const Matrix4 &fallback) const {
+  auto it = m_Values.find(name);
+  if (it == m_Values.end() || it->second.size() != sizeof(Matrix4)) {
+    return fallback;
+  }
+
+  Matrix4 value;
+  memcpy(&value, it->second.data(), sizeof(value));
+  return value;
+}
+
+void SoftwareShader::SetData(const std::string &name, ShaderDataType type,
+                             const void *data, uint32_t count) {
+  // Only allocates the first time a name is set
+  std::vector<uint8_t> &value = m_Values[name];
+  value.resize(ShaderDataTypeSize(type) * count);
+  memcpy(value.data(), data, value.size());
+}
+} // namespace MyEngine
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "MyEngine/Renderer/Buffer.h"
+#include "MyEngine/Renderer/Shader.h"
+
+#include <unordered_map>
+
+namespace MyEngine {
+class SoftwareShader : public Shader {
+public:
+  SoftwareShader(const std::string &name,
+                 const std::vector<Ref<ShaderStage>> stages)
+      : m_Name(name), m_Stages(stages) {}
+  virtual ~SoftwareShader() override;
+  virtual void Bind() override { s_BoundShader = this; }
+
+  // Returns the fallback if the value was never set
+  Matrix4 GetMat4(const std::string &name, const Matrix4 &fallback) const;
+
+  static SoftwareShader *GetBound() { return s_BoundShader; }
+
+private:
+  virtual void SetData(const std::string &name, ShaderDataType type,
+                       const void *data, uint32_t count) override;
+
+  std::string m_Name;
+  std::vector<Ref<ShaderStage>> m_Stages;
+  std::unordered_map<std::string, std::vector<uint8_t>> m_Values;
+
+  static SoftwareShader *s_BoundShader;
+};
+} // namespace MyEngine
@@ -0,0 +1,15 @@
+#include "mepch.h"
+
+#include "Platform/Software/SoftwareShaderStage.h"
+
+namespace MyEngine {
+SoftwareShaderStage::SoftwareShaderStage(const std::string &filepath,
+                                         StageType type)
+    : m_Filepath(filepath), m_Type(type) {
+  if (filepath.find("vertexColor") == std::string::npos) {
+    ME_CORE_WARN("The software renderer only supports the vertex color "
+                 "shaders, {0} will be drawn with them",
+                 filepath);
+  }
+}
+} // namespace MyEngine
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "MyEngine/Renderer/ShaderStage.h"
+
+namespace MyEngine {
+// The software renderer runs a built in equivalent of the vertex color
+// shaders, stages only remember what they were created from.
+class SoftwareShaderStage : public ShaderStage {
+public:
+  SoftwareShaderStage(const std::string &filepath, StageType type);
+  virtual ~SoftwareShaderStage() override = default;
+
+  virtual StageType GetType() const override { return m_Type; }
+
+private:
+  std::string m_Filepath;
+  StageType m_Type;
+};
+} // namespace MyEngine
@@ -0,0 +1,83 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/ThreadPool.h"
+#include "Platform/Software/SoftwareTexture.h"
+
+#include <cstring>
+
+namespace MyEngine {
+SoftwareTexture2D::SoftwareTexture2D(
+    const TextureSpecification &specification) {
+  m_Image.Width = specification.Width;
+  m_Image.Height = specification.Height;
+}
+
+SoftwareTexture2D::SoftwareTexture2D(
+    const std::string &filepath, const TextureSpecification &specification) {
+  m_Image.Width = specification.Width;
+  m_Image.Height = specification.Height;
+  m_Decode = ThreadPool::Get().Submit([filepath]() {
+    ImageData image;
+    if (!ImageDecoder::IsKTX2(filepath)) {
+      ImageDecoder::Decode(filepath, &image);
+      return image;
+    }
+
+    // The rasterizer samples RGBA8 only, Basis Universal data is transcoded
+    // to it and block compressed files can't be used
+    std::vector<ImageData> mips;
+    if (!ImageDecoder::DecodeKTX2(filepath, {}, &mips)) {
+      return image;
+    }
+    if (TextureFormatBlockSize(mips[0].Format) != 0) {
+      ME_CORE_ERROR("Unable to load {0}, the software renderer can't sample "
+                    "block compressed textures",
+                    filepath);
+      return image;
+    }
+    return std::move(mips[0]);
+  });
+}
+
+uint32_t SoftwareTexture2D::GetWidth() const {
+  Poll();
+  return m_Image.Width;
+}
+
+uint32_t SoftwareTexture2D::GetHeight() const {
+  Poll();
+  return m_Image.Height;
+}
+
+bool SoftwareTexture2D::IsLoaded() const {
+  Poll();
+  return !m_Image.Pixels.empty();
+}
+
+void SoftwareTexture2D::SetData(const void *data, uint32_t size) {
+  ME_CORE_ASSERT(size == m_Image.Width * m_Image.Height * 4,
+                 "Texture data must cover the whole texture!");
+  // Data set explicitly wins over a decode still in flight
+  m_Decode = std::future<ImageData>();
+  m_Image.Pixels.resize(size);
+  memcpy(m_Image.Pixels.data(), data, size);
+}
+
+const std::vector<uint8_t> &SoftwareTexture2D::GetPixels() const {
+  Poll();
+  return m_Image.Pixels;
+}
+
+void SoftwareTexture2D::Poll() const {
+  if (!m_Decode.valid() || m_Decode.wait_for(std::chrono::seconds(0)) !=
+                               std::future_status::ready) {
+    return;
+  }
+
+  ImageData image = m_Decode.get();
+  // A failed decode keeps the size of the specification and no pixels
+  if (!image.Pixels.empty()) {
+    m_Image = std::move(image);
+  }
+}
+} // namespace MyEngine
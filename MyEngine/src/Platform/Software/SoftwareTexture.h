@@ -0,0 +1,36 @@
+#pragma once
+
+#include "MyEngine/Renderer/Image.h"
+#include "MyEngine/Renderer/Texture.h"
+
+#include <future>
+
+namespace MyEngine {
+// Keeps the RGBA8 pixels in memory, images are decoded on the thread pool
+class SoftwareTexture2D : public Texture2D {
+public:
+  SoftwareTexture2D(const TextureSpecification &specification);
+  SoftwareTexture2D(const std::string &filepath,
+                    const TextureSpecification &specification);
+  virtual ~SoftwareTexture2D() = default;
+
+  virtual uint32_t GetWidth() const override;
+  virtual uint32_t GetHeight() const override;
+
+  virtual bool IsLoaded() const override;
+  virtual uint32_t GetIndex() const override { return 0; }
+  virtual void RequestSize(uint32_t pixels) override {}
+
+  virtual void SetData(const void *data, uint32_t size) override;
+
+  // Empty until the texture is loaded
+  const std::vector<uint8_t> &GetPixels() const;
+
+private:
+  // Takes the decoded image once the decode finished, never blocks
+  void Poll() const;
+
+  mutable ImageData m_Image;
+  mutable std::future<ImageData> m_Decode;
+};
+} // namespace MyEngine
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "MyEngine/Renderer/VertexArray.h"
+
+namespace MyEngine {
+class SoftwareVertexArray : public VertexArray {
+public:
+  SoftwareVertexArray() = default;
+  virtual ~SoftwareVertexArray() = default;
+
+  virtual void Bind() const override {}
+  virtual void Unbind() const override {}
+  virtual void Draw(const DrawRange &range) const override {}
+
+  virtual void AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) override {
+    m_VertexBuffers.push_back(vertexBuffer);
+  }
+  virtual void SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) override {
+    m_IndexBuffer = indexBuffer;
+  }
+
+  virtual const std::vector<Ref<VertexBuffer>> &
+  GetVertexBuffers() const override {
+    return m_VertexBuffers;
+  }
+  virtual const Ref<IndexBuffer> &GetIndexBuffer() const override {
+    return m_IndexBuffer;
+  }
+
+private:
+  std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+  Ref<IndexBuffer> m_IndexBuffer;
+};
+} // namespace MyEngine
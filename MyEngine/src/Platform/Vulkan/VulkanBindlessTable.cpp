@@ -0,0 +1,192 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanBindlessTable.h"
+#include "Platform/Vulkan/VulkanContext.h"
+
+namespace MyEngine {
+uint32_t VulkanBindlessTable::Slots::Allocate() {
+  if (!Free.empty()) {
+    uint32_t index = Free.back();
+    Free.pop_back();
+    return index;
+  }
+  if (Next < Capacity) {
+    return Next++;
+  }
+  return InvalidIndex;
+}
+
+void VulkanBindlessTable::Init(VulkanContext *context) {
+  m_Context = context;
+  if (!context->DescriptorIndexing) {
+    ME_CORE_WARN("Descriptor indexing is not supported, bindless resources "
+                 "are disabled!");
+    return;
+  }
+
+  VkPhysicalDeviceVulkan12Properties properties12{};
+  properties12.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+  VkPhysicalDeviceProperties2 properties{};
+  properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+  properties.pNext = &properties12;
+  vkGetPhysicalDeviceProperties2(context->PhysicalDevice, &properties);
+
+  m_Textures.Capacity =
+      std::min({MaxTextures,
+                properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+                properties12.maxPerStageDescriptorUpdateAfterBindSamplers});
+  m_Buffers.Capacity =
+      std::min({MaxBuffers,
+                properties12.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                properties12
+                    .maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+
+  VkDescriptorSetLayoutBinding bindings[2] = {};
+  bindings[0].binding = TextureBinding;
+  bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  bindings[0].descriptorCount = m_Textures.Capacity;
+  bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+  bindings[1].binding = BufferBinding;
+  bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  bindings[1].descriptorCount = m_Buffers.Capacity;
+  bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+
+  // Unused slots may hold stale descriptors, slots not used by pending
+  // command buffers can be rewritten at any time
+  const VkDescriptorBindingFlags flags =
+      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+      VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+      VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+  VkDescriptorBindingFlags bindingFlags[2] = {flags, flags};
+  VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+  flagsInfo.sType =
+      VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+  flagsInfo.bindingCount = 2;
+  flagsInfo.pBindingFlags = bindingFlags;
+
+  VkDescriptorSetLayoutCreateInfo layoutInfo{};
+  layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layoutInfo.pNext = &flagsInfo;
+  layoutInfo.flags =
+      VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+  layoutInfo.bindingCount = 2;
+  layoutInfo.pBindings = bindings;
+  VkResult res =
+      vkCreateDescriptorSetLayout(context->LogicalDevice, &layoutInfo,
+                                  context->AllocationCallback, &m_SetLayout);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create bindless set layout!");
+
+  VkDescriptorPoolSize poolSizes[] = {
+      {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_Textures.Capacity},
+      {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_Buffers.Capacity},
+  };
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+  poolInfo.maxSets = 1;
+  poolInfo.poolSizeCount = (uint32_t)std::size(poolSizes);
+  poolInfo.pPoolSizes = poolSizes;
+  res = vkCreateDescriptorPool(context->LogicalDevice, &poolInfo,
+                               context->AllocationCallback, &m_Pool);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create bindless pool!");
+
+  VkDescriptorSetAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  allocInfo.descriptorPool = m_Pool;
+  allocInfo.descriptorSetCount = 1;
+  allocInfo.pSetLayouts = &m_SetLayout;
+  res = vkAllocateDescriptorSets(context->LogicalDevice, &allocInfo, &m_Set);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to allocate bindless set!");
+
+  ME_CORE_TRACE("Created bindless table with {0} textures and {1} buffers",
+                m_Textures.Capacity, m_Buffers.Capacity);
+}
+
+void VulkanBindlessTable::Destroy(VulkanContext *context) {
+  if (m_Pool != VK_NULL_HANDLE) {
+    vkDestroyDescriptorPool(context->LogicalDevice, m_Pool,
+                            context->AllocationCallback);
+  }
+  if (m_SetLayout != VK_NULL_HANDLE) {
+    vkDestroyDescriptorSetLayout(context->LogicalDevice, m_SetLayout,
+                                 context->AllocationCallback);
+  }
+  m_Pool = VK_NULL_HANDLE;
+  m_SetLayout = VK_NULL_HANDLE;
+  m_Set = VK_NULL_HANDLE;
+  m_Textures = Slots();
+  m_Buffers = Slots();
+}
+
+uint32_t VulkanBindlessTable::AddTexture(VkImageView view, VkSampler sampler,
+                                         VkImageLayout layout) {
+  if (!IsSupported()) {
+    return InvalidIndex;
+  }
+
+  uint32_t index = m_Textures.Allocate();
+  ME_CORE_ASSERT(index != InvalidIndex, "Bindless texture table is full!");
+  UpdateTexture(index, view, sampler, layout);
+  return index;
+}
+
+void VulkanBindlessTable::UpdateTexture(uint32_t index, VkImageView view,
+                                        VkSampler sampler,
+                                        VkImageLayout layout) {
+  if (index == InvalidIndex) {
+    return;
+  }
+
+  VkDescriptorImageInfo imageInfo{sampler, view, layout};
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = m_Set;
+  write.dstBinding = TextureBinding;
+  write.dstArrayElement = index;
+  write.descriptorCount = 1;
+  write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  write.pImageInfo = &imageInfo;
+  vkUpdateDescriptorSets(m_Context->LogicalDevice, 1, &write, 0, nullptr);
+}
+
+void VulkanBindlessTable::RemoveTexture(uint32_t index) {
+  Release(&m_Textures, index);
+}
+
+uint32_t VulkanBindlessTable::AddBuffer(VkBuffer buffer, VkDeviceSize offset,
+                                        VkDeviceSize range) {
+  if (!IsSupported()) {
+    return InvalidIndex;
+  }
+
+  uint32_t index = m_Buffers.Allocate();
+  ME_CORE_ASSERT(index != InvalidIndex, "Bindless buffer table is full!");
+
+  VkDescriptorBufferInfo bufferInfo{buffer, offset, range};
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = m_Set;
+  write.dstBinding = BufferBinding;
+  write.dstArrayElement = index;
+  write.descriptorCount = 1;
+  write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  write.pBufferInfo = &bufferInfo;
+  vkUpdateDescriptorSets(m_Context->LogicalDevice, 1, &write, 0, nullptr);
+  return index;
+}
+
+void VulkanBindlessTable::RemoveBuffer(uint32_t index) {
+  Release(&m_Buffers, index);
+}
+
+void VulkanBindlessTable::Release(Slots *pSlots, uint32_t index) {
+  if (index == InvalidIndex || !IsSupported()) {
+    return;
+  }
+
+  // Draws recorded so far may still read the slot, it is only reused once
+  // they finished. The stale descriptor is never read after that.
+  m_Context->Defer([pSlots, index]() { pSlots->Free.push_back(index); });
+}
+} // namespace MyEngine
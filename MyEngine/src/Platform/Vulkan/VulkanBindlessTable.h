@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+class VulkanContext;
+
+// Global descriptor set holding large arrays of every sampled texture and
+// storage buffer, so draws pick their resources by index instead of binding
+// them and can be batched across textures. Needs descriptor indexing (core in
+// vulkan 1.2), the set is partially bound and updated after bind.
+//
+// Shaders opt in by declaring the arrays in set Set:
+//   layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+//   layout(set = 1, binding = 1) buffer Buffers { ... } u_Buffers[];
+// and indexing them with nonuniformEXT.
+class VulkanBindlessTable {
+public:
+  static constexpr uint32_t Set = 1;
+  static constexpr uint32_t TextureBinding = 0;
+  static constexpr uint32_t BufferBinding = 1;
+  static constexpr uint32_t MaxTextures = 16384;
+  static constexpr uint32_t MaxBuffers = 4096;
+  static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+  void Init(VulkanContext *context);
+  void Destroy(VulkanContext *context);
+
+  bool IsSupported() const { return m_Set != VK_NULL_HANDLE; }
+
+  uint32_t AddTexture(VkImageView view, VkSampler sampler,
+                      VkImageLayout layout);
+  void UpdateTexture(uint32_t index, VkImageView view, VkSampler sampler,
+                     VkImageLayout layout);
+  // The index is handed out again once the frames that may use it finished
+  void RemoveTexture(uint32_t index);
+
+  uint32_t AddBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range);
+  void RemoveBuffer(uint32_t index);
+
+  VkDescriptorSetLayout GetSetLayout() const { return m_SetLayout; }
+  VkDescriptorSet GetSet() const { return m_Set; }
+
+private:
+  struct Slots {
+    uint32_t Capacity = 0;
+    uint32_t Next = 0;
+    std::vector<uint32_t> Free;
+
+    uint32_t Allocate();
+  };
+
+  void Release(Slots *pSlots, uint32_t index);
+
+  VulkanContext *m_Context = nullptr;
+  VkDescriptorSetLayout m_SetLayout = VK_NULL_HANDLE;
+  VkDescriptorPool m_Pool = VK_NULL_HANDLE;
+  VkDescriptorSet m_Set = VK_NULL_HANDLE;
+  Slots m_Textures;
+  Slots m_Buffers;
+};
+} // namespace MyEngine
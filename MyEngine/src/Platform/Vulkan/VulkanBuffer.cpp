@@ -1,56 +1,102 @@
 #include "mepch.h"
 
 #include "MyEngine/Core/Application.h"
+#include "MyEngine/Renderer/Mesh.h"
 #include "Platform/Vulkan/VulkanBuffer.h"
+#include "Platform/Vulkan/VulkanBufferUploader.h"
 #include "Platform/Vulkan/VulkanContext.h"
 
 #include <vulkan/vulkan_core.h>
 
 namespace MyEngine {
+static_assert(HasVulkanFormats<DefaultVertexLayout>() &&
+                  HasVulkanFormats<MeshPositionLayout>() &&
+                  HasVulkanFormats<MeshColorLayout>(),
+              "Engine vertex layouts must map to vertex formats");
+
+// +========+
+// | SHADOW |
+// +========+
+bool VulkanBufferShadow::Update(const void *data, uint32_t offset,
+                                uint32_t size, uint32_t *pBegin,
+                                uint32_t *pEnd) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  const uint32_t end = offset + size;
+  const uint32_t knownEnd = m_Offset + (uint32_t)m_Data.size();
+
+  // Trims the bytes equal to the copy off both ends
+  uint32_t begin = offset;
+  while (begin < end && begin >= m_Offset && begin < knownEnd &&
+         m_Data[begin - m_Offset] == bytes[begin - offset]) {
+    begin++;
+  }
+  uint32_t changedEnd = end;
+  while (changedEnd > begin && changedEnd - 1 >= m_Offset &&
+         changedEnd - 1 < knownEnd &&
+         m_Data[changedEnd - 1 - m_Offset] == bytes[changedEnd - 1 - offset]) {
+    changedEnd--;
+  }
+
+  if (offset < m_Offset + m_Size && m_Offset < end) {
+    m_Data.assign(bytes, bytes + size);
+  } else {
+    m_Data.clear();
+    m_Data.shrink_to_fit();
+  }
+  m_Offset = offset;
+  m_Size = size;
+
+  *pBegin = begin;
+  *pEnd = changedEnd;
+  return begin < changedEnd;
+}
+
 // +===============+
 // | VERTEX BUFFER |
 // +===============+
-VulkanVertexBuffer::VulkanVertexBuffer(uint32_t size) {}
-
-VulkanVertexBuffer::VulkanVertexBuffer(Vertex *vertices, uint32_t size) {
+VulkanVertexBuffer::VulkanVertexBuffer(uint32_t size)
+    : m_Size(sizeof(Vertex) * size) {
   VulkanContext *context = static_cast<VulkanContext *>(
       Application::Get().GetWindow().GetGraphicsContext());
 
-  VkDeviceSize bufferSize = sizeof(Vertex) * size;
-  VkBuffer stagingBuffer;
-  VkDeviceMemory stagingBufferMemory;
+  // Filled through SetData, readbacks copy out of it
+  VulkanBufferHelper::CreateBuffer(
+      context->PhysicalDevice, context->LogicalDevice, m_Size,
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_Buffer, m_BufferMemory);
+}
 
-  VulkanBufferHelper::CreateBuffer(context->PhysicalDevice,
-                                   context->LogicalDevice, bufferSize,
-                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                   stagingBuffer, stagingBufferMemory);
+VulkanVertexBuffer::VulkanVertexBuffer(Vertex *vertices, uint32_t size)
+    : VulkanVertexBuffer(static_cast<const void *>(vertices),
+                         sizeof(Vertex) * size) {}
 
-  void *data;
-  vkMapMemory(context->LogicalDevice, stagingBufferMemory, 0, bufferSize, 0,
-              &data);
-  memcpy(data, vertices, (unsigned long long)bufferSize);
-  vkUnmapMemory(context->LogicalDevice, stagingBufferMemory);
+VulkanVertexBuffer::VulkanVertexBuffer(const void *vertices, uint32_t size)
+    : m_Size(size) {
+  VulkanContext *context = static_cast<VulkanContext *>(
+      Application::Get().GetWindow().GetGraphicsContext());
 
   VulkanBufferHelper::CreateBuffer(
-      context->PhysicalDevice, context->LogicalDevice, bufferSize,
-      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+      context->PhysicalDevice, context->LogicalDevice, m_Size,
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_Buffer, m_BufferMemory);
-  VulkanBufferHelper::CopyBuffer(
-      context->LogicalDevice, context->Window.GetCurrentFrame()->CommandPool,
-      context->Queue, stagingBuffer, m_Buffer, bufferSize);
-
-  vkDestroyBuffer(context->LogicalDevice, stagingBuffer, nullptr);
-  vkFreeMemory(context->LogicalDevice, stagingBufferMemory, nullptr);
+  // Copied before the draws of the frame being recorded, like SetData
+  if (vertices != nullptr) {
+    VulkanBufferUploader::Queue(m_Buffer, 0, vertices, m_Size);
+  }
 }
 
 VulkanVertexBuffer::~VulkanVertexBuffer() {
   VulkanContext *context = static_cast<VulkanContext *>(
       Application::Get().GetWindow().GetGraphicsContext());
 
-  vkDestroyBuffer(context->LogicalDevice, m_Buffer, nullptr);
-  vkFreeMemory(context->LogicalDevice, m_BufferMemory, nullptr);
+  // Frames in flight may still read the buffer
+  VulkanBufferUploader::Cancel(m_Buffer);
+  context->Defer([context, buffer = m_Buffer, memory = m_BufferMemory]() {
+    vkDestroyBuffer(context->LogicalDevice, buffer, nullptr);
+    vkFreeMemory(context->LogicalDevice, memory, nullptr);
+  });
 }
 
 void VulkanVertexBuffer::Bind() const {
@@ -71,78 +117,81 @@ void VulkanVertexBuffer::Unbind() const {
                          VK_NULL_HANDLE, offsets);
 }
 
-void VulkanVertexBuffer::SetData(const Vertex *pData, uint32_t size) {
-  VulkanContext *context = static_cast<VulkanContext *>(
-      Application::Get().GetWindow().GetGraphicsContext());
-
-  VkDeviceSize bufferSize = sizeof(Vertex) * size;
-  VkBuffer stagingBuffer;
-  VkDeviceMemory stagingBufferMemory;
-
-  VulkanBufferHelper::CreateBuffer(context->PhysicalDevice,
-                                   context->LogicalDevice, bufferSize,
-                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                   stagingBuffer, stagingBufferMemory);
-
-  void *pStagingData;
-  vkMapMemory(context->LogicalDevice, stagingBufferMemory, 0, bufferSize, 0,
-              &pStagingData);
-  memcpy(pStagingData, pData, (unsigned long long)bufferSize);
-  vkUnmapMemory(context->LogicalDevice, stagingBufferMemory);
-
-  VulkanBufferHelper::CopyBuffer(
-      context->LogicalDevice, context->Window.GetCurrentFrame()->CommandPool,
-      context->Queue, stagingBuffer, m_Buffer, bufferSize);
+void VulkanVertexBuffer::WriteData(const void *pData, uint32_t offset,
+                                   uint32_t size) {
+  ME_CORE_ASSERT((uint64_t)offset + size <= m_Size,
+                 "Vertex data is larger than the buffer!");
+
+  uint32_t begin, end;
+  if (m_Shadow.Update(pData, offset, size, &begin, &end)) {
+    VulkanBufferUploader::Queue(
+        m_Buffer, begin, static_cast<const uint8_t *>(pData) + (begin - offset),
+        end - begin);
+  }
+}
 
-  vkDestroyBuffer(context->LogicalDevice, stagingBuffer, nullptr);
-  vkFreeMemory(context->LogicalDevice, stagingBufferMemory, nullptr);
+void *VulkanVertexBuffer::MapData(uint32_t offset, uint32_t size) {
+  m_Shadow.Forget();
+  if (size == 0) {
+    return nullptr;
+  }
+  return VulkanBufferUploader::Allocate(m_Buffer, offset, size);
 }
 
 // +==============+
 // | INDEX BUFFER |
 // +==============+
 VulkanIndexBuffer::VulkanIndexBuffer(uint32_t *indices, uint32_t count)
-    : m_Count(count) {
+    : m_Count(count), m_IndexType(VK_INDEX_TYPE_UINT32) {
   VulkanContext *context = static_cast<VulkanContext *>(
       Application::Get().GetWindow().GetGraphicsContext());
 
+  // Halves the index memory and fetch of meshes below 65535 vertices
   VkDeviceSize bufferSize = sizeof(uint32_t) * count;
-  VkBuffer stagingBuffer;
-  VkDeviceMemory stagingBufferMemory;
-
-  VulkanBufferHelper::CreateBuffer(context->PhysicalDevice,
-                                   context->LogicalDevice, bufferSize,
-                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                   stagingBuffer, stagingBufferMemory);
-
-  void *data;
-  vkMapMemory(context->LogicalDevice, stagingBufferMemory, 0, bufferSize, 0,
-              &data);
-  memcpy(data, indices, (unsigned long long)bufferSize);
-  vkUnmapMemory(context->LogicalDevice, stagingBufferMemory);
+  if (IndexBuffer::Fits16Bit(indices, count)) {
+    bufferSize = sizeof(uint16_t) * count;
+    m_IndexType = VK_INDEX_TYPE_UINT16;
+  }
 
   VulkanBufferHelper::CreateBuffer(
       context->PhysicalDevice, context->LogicalDevice, bufferSize,
       VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_Buffer, m_BufferMemory);
-  VulkanBufferHelper::CopyBuffer(
-      context->LogicalDevice, context->Window.GetCurrentFrame()->CommandPool,
-      context->Queue, stagingBuffer, m_Buffer, bufferSize);
+  if (m_IndexType == VK_INDEX_TYPE_UINT32) {
+    VulkanBufferUploader::Queue(m_Buffer, 0, indices, bufferSize);
+  } else if (count != 0) {
+    // Converted straight into staging memory
+    uint16_t *shortIndices = static_cast<uint16_t *>(
+        VulkanBufferUploader::Allocate(m_Buffer, 0, bufferSize));
+    std::copy(indices, indices + count, shortIndices);
+  }
+}
+
+VulkanIndexBuffer::VulkanIndexBuffer(uint32_t count, IndexFormat format)
+    : m_Count(count), m_IndexType(format == IndexFormat::UInt16
+                                      ? VK_INDEX_TYPE_UINT16
+                                      : VK_INDEX_TYPE_UINT32) {
+  VulkanContext *context = static_cast<VulkanContext *>(
+      Application::Get().GetWindow().GetGraphicsContext());
 
-  vkDestroyBuffer(context->LogicalDevice, stagingBuffer, nullptr);
-  vkFreeMemory(context->LogicalDevice, stagingBufferMemory, nullptr);
+  const VkDeviceSize indexSize = format == IndexFormat::UInt16
+                                     ? sizeof(uint16_t)
+                                     : sizeof(uint32_t);
+  VulkanBufferHelper::CreateBuffer(
+      context->PhysicalDevice, context->LogicalDevice, indexSize * count,
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_Buffer, m_BufferMemory);
 }
 
 VulkanIndexBuffer::~VulkanIndexBuffer() {
   VulkanContext *context = static_cast<VulkanContext *>(
       Application::Get().GetWindow().GetGraphicsContext());
 
-  vkDestroyBuffer(context->LogicalDevice, m_Buffer, nullptr);
-  vkFreeMemory(context->LogicalDevice, m_BufferMemory, nullptr);
+  VulkanBufferUploader::Cancel(m_Buffer);
+  context->Defer([context, buffer = m_Buffer, memory = m_BufferMemory]() {
+    vkDestroyBuffer(context->LogicalDevice, buffer, nullptr);
+    vkFreeMemory(context->LogicalDevice, memory, nullptr);
+  });
 }
 
 void VulkanIndexBuffer::Bind() const {
@@ -150,7 +199,7 @@ void VulkanIndexBuffer::Bind() const {
       Application::Get().GetWindow().GetGraphicsContext());
 
   vkCmdBindIndexBuffer(context->Window.GetCurrentFrame()->CommandBuffer,
-                       m_Buffer, 0, VK_INDEX_TYPE_UINT32);
+                       m_Buffer, 0, m_IndexType);
 }
 
 void VulkanIndexBuffer::Unbind() const {
@@ -158,6 +207,67 @@ void VulkanIndexBuffer::Unbind() const {
       Application::Get().GetWindow().GetGraphicsContext());
 
   vkCmdBindIndexBuffer(context->Window.GetCurrentFrame()->CommandBuffer,
-                       VK_NULL_HANDLE, 0, VK_INDEX_TYPE_UINT32);
+                       VK_NULL_HANDLE, 0, m_IndexType);
+}
+
+void VulkanIndexBuffer::WriteData(const uint32_t *indices, uint32_t offset,
+                                  uint32_t count) {
+  ME_CORE_ASSERT((uint64_t)offset + count <= m_Count,
+                 "Index data is larger than the buffer!");
+
+  if (m_IndexType == VK_INDEX_TYPE_UINT16 &&
+      !IndexBuffer::Fits16Bit(indices, count)) {
+    ME_CORE_ERROR("Index buffer was created with 16 bit indices, the new "
+                  "indices don't fit");
+    return;
+  }
+
+  // Diffed as 32 bit indices, only the indices that changed are converted
+  uint32_t begin, end;
+  if (!m_Shadow.Update(indices, sizeof(uint32_t) * offset,
+                       sizeof(uint32_t) * count, &begin, &end)) {
+    return;
+  }
+  const uint32_t first = begin / sizeof(uint32_t);
+  const uint32_t changed = (end + sizeof(uint32_t) - 1) / sizeof(uint32_t) -
+                           first;
+  const uint32_t *source = indices + (first - offset);
+  if (m_IndexType == VK_INDEX_TYPE_UINT32) {
+    VulkanBufferUploader::Queue(m_Buffer, sizeof(uint32_t) * first, source,
+                                sizeof(uint32_t) * changed);
+  } else {
+    uint16_t *shortIndices =
+        static_cast<uint16_t *>(VulkanBufferUploader::Allocate(
+            m_Buffer, sizeof(uint16_t) * first, sizeof(uint16_t) * changed));
+    std::copy(source, source + changed, shortIndices);
+  }
+}
+
+uint32_t *VulkanIndexBuffer::MapData(uint32_t offset, uint32_t count) {
+  m_Shadow.Forget();
+  if (count == 0) {
+    return nullptr;
+  }
+  if (m_IndexType == VK_INDEX_TYPE_UINT32) {
+    return static_cast<uint32_t *>(VulkanBufferUploader::Allocate(
+        m_Buffer, sizeof(uint32_t) * offset, sizeof(uint32_t) * count));
+  }
+  m_Scratch.resize(count);
+  return m_Scratch.data();
+}
+
+void VulkanIndexBuffer::UnmapData(uint32_t offset, uint32_t count) {
+  if (count == 0 || m_IndexType == VK_INDEX_TYPE_UINT32) {
+    return;
+  }
+  if (!IndexBuffer::Fits16Bit(m_Scratch.data(), count)) {
+    ME_CORE_ERROR("Index buffer was created with 16 bit indices, the new "
+                  "indices don't fit");
+    return;
+  }
+  uint16_t *shortIndices =
+      static_cast<uint16_t *>(VulkanBufferUploader::Allocate(
+          m_Buffer, sizeof(uint16_t) * offset, sizeof(uint16_t) * count));
+  std::copy(m_Scratch.begin(), m_Scratch.begin() + count, shortIndices);
 }
 } // namespace MyEngine
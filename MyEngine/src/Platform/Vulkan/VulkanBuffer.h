@@ -1,35 +1,134 @@
 #pragma once
 
 #include "MyEngine/Renderer/Buffer.h"
+#include "MyEngine/Renderer/VertexLayout.h"
 
 #include <vulkan/vulkan_core.h>
 
 namespace MyEngine {
+// Format of a single column for matrix types. Normalized integer types are
+// fetched as floats.
+constexpr VkFormat ToVulkanFormat(ShaderDataType type, bool normalized) {
+  switch (type) {
+  case ShaderDataType::Float:
+    return VK_FORMAT_R32_SFLOAT;
+  case ShaderDataType::Float2:
+    return VK_FORMAT_R32G32_SFLOAT;
+  case ShaderDataType::Float3:
+  case ShaderDataType::Mat3:
+    return VK_FORMAT_R32G32B32_SFLOAT;
+  case ShaderDataType::Float4:
+  case ShaderDataType::Mat4:
+    return VK_FORMAT_R32G32B32A32_SFLOAT;
+  case ShaderDataType::Int:
+    return VK_FORMAT_R32_SINT;
+  case ShaderDataType::Int2:
+    return VK_FORMAT_R32G32_SINT;
+  case ShaderDataType::Int3:
+    return VK_FORMAT_R32G32B32_SINT;
+  case ShaderDataType::Int4:
+    return VK_FORMAT_R32G32B32A32_SINT;
+  case ShaderDataType::Bool:
+    return VK_FORMAT_R8_UINT;
+  case ShaderDataType::UByte4:
+    return normalized ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_UINT;
+  case ShaderDataType::Byte4:
+    return normalized ? VK_FORMAT_R8G8B8A8_SNORM : VK_FORMAT_R8G8B8A8_SINT;
+  case ShaderDataType::Short2:
+    return normalized ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R16G16_SINT;
+  case ShaderDataType::Short4:
+    return normalized ? VK_FORMAT_R16G16B16A16_SNORM
+                      : VK_FORMAT_R16G16B16A16_SINT;
+  case ShaderDataType::Half2:
+    return VK_FORMAT_R16G16_SFLOAT;
+  case ShaderDataType::Half4:
+    return VK_FORMAT_R16G16B16A16_SFLOAT;
+  default:
+    return VK_FORMAT_UNDEFINED;
+  }
+}
+
+// Formats of the attributes of a VertexLayout, known at compile time
+template <typename... Attrs>
+constexpr std::array<VkFormat, sizeof...(Attrs)>
+GetVulkanFormats(VertexLayout<Attrs...>) {
+  return {ToVulkanFormat(Attrs::DataType, Attrs::IsNormalized)...};
+}
+
+template <typename Layout> constexpr bool HasVulkanFormats() {
+  for (VkFormat format : GetVulkanFormats(Layout())) {
+    if (format == VK_FORMAT_UNDEFINED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// CPU copy of the last range set on a buffer, narrows updates of the same
+// range down to the bytes that changed. Data is only copied once an update
+// overlaps the range before it, so buffers filled once in pieces, like the
+// geometry pool pages, never keep a copy. Buffers updated every frame rewrite
+// the same range and are diffed from their third update on.
+class VulkanBufferShadow {
+public:
+  // Remembers [offset, offset + size) and returns the part of it that differs
+  // from the last range in pBegin and pEnd. Returns false when nothing
+  // changed.
+  bool Update(const void *data, uint32_t offset, uint32_t size,
+              uint32_t *pBegin, uint32_t *pEnd);
+  // For data written without Update, the next range is uploaded whole
+  void Forget() {
+    m_Offset = 0;
+    m_Size = 0;
+    m_Data.clear();
+    m_Data.shrink_to_fit();
+  }
+
+private:
+  uint32_t m_Offset = 0;
+  uint32_t m_Size = 0;
+  // Data of the last range, empty unless it overlapped the one before
+  std::vector<uint8_t> m_Data;
+};
+
 class VulkanVertexBuffer : public VertexBuffer {
 public:
   VulkanVertexBuffer(uint32_t size);
   VulkanVertexBuffer(Vertex *vertices, uint32_t size);
+  // size is in bytes, without vertices the buffer is filled through SetData
+  VulkanVertexBuffer(const void *vertices, uint32_t size);
   virtual ~VulkanVertexBuffer();
 
   virtual void Bind() const override;
   virtual void Unbind() const override;
 
-  virtual void SetData(const Vertex *pData, uint32_t size) override;
-
   virtual const BufferLayout &GetLayout() const override { return m_Layout; }
   virtual void SetLayout(const BufferLayout &layout) override {
     m_Layout = layout;
   }
 
+  VkBuffer GetBuffer() const { return m_Buffer; }
+  virtual uint32_t GetSize() const override { return m_Size; }
+
+protected:
+  virtual void WriteData(const void *pData, uint32_t offset,
+                         uint32_t size) override;
+  // Straight into staging memory
+  virtual void *MapData(uint32_t offset, uint32_t size) override;
+
 private:
   VkBuffer m_Buffer;
   VkDeviceMemory m_BufferMemory;
+  uint32_t m_Size;
   BufferLayout m_Layout;
+  VulkanBufferShadow m_Shadow;
 };
 
 class VulkanIndexBuffer : public IndexBuffer {
 public:
   VulkanIndexBuffer(uint32_t *indices, uint32_t count);
+  // Always 32 bit, the indices set later aren't known yet
+  VulkanIndexBuffer(uint32_t count, IndexFormat format);
   virtual ~VulkanIndexBuffer();
 
   virtual void Bind() const override;
@@ -37,35 +136,63 @@ public:
 
   virtual uint32_t GetCount() const override { return m_Count; }
 
+  VkBuffer GetBuffer() const { return m_Buffer; }
+  VkIndexType GetIndexType() const { return m_IndexType; }
+
+protected:
+  virtual void WriteData(const uint32_t *indices, uint32_t offset,
+                         uint32_t count) override;
+  // 32 bit indices go straight into staging memory, 16 bit ones are
+  // converted on unmap
+  virtual uint32_t *MapData(uint32_t offset, uint32_t count) override;
+  virtual void UnmapData(uint32_t offset, uint32_t count) override;
+
 private:
   VkBuffer m_Buffer;
   VkDeviceMemory m_BufferMemory;
   uint32_t m_Count;
+  VkIndexType m_IndexType;
+  VulkanBufferShadow m_Shadow;
+  std::vector<uint32_t> m_Scratch;
 };
 
 class VulkanBufferHelper {
 public:
-  static uint32_t FindMemoryType(VkPhysicalDevice physicalDevice,
-                                 uint32_t typeFilter,
-                                 VkMemoryPropertyFlags flags) {
+  // Returns false instead of asserting when no memory type has the flags
+  static bool TryFindMemoryType(VkPhysicalDevice physicalDevice,
+                                uint32_t typeFilter,
+                                VkMemoryPropertyFlags flags, uint32_t *pIndex) {
     VkPhysicalDeviceMemoryProperties memProperties;
     vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
 
     for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
       if ((typeFilter & (1 << i)) &&
           (memProperties.memoryTypes[i].propertyFlags & flags) == flags) {
-        return i;
+        *pIndex = i;
+        return true;
       }
     }
+    return false;
+  }
 
-    ME_CORE_ASSERT(false, "Unable to find suitable memory type!");
-    return 0;
+  static uint32_t FindMemoryType(VkPhysicalDevice physicalDevice,
+                                 uint32_t typeFilter,
+                                 VkMemoryPropertyFlags flags) {
+    uint32_t index = 0;
+    if (!TryFindMemoryType(physicalDevice, typeFilter, flags, &index)) {
+      ME_CORE_ASSERT(false, "Unable to find suitable memory type!");
+    }
+    return index;
   }
 
-  static void CreateBuffer(VkPhysicalDevice physicalDevice, VkDevice device,
-                           VkDeviceSize size, VkBufferUsageFlags usage,
-                           VkMemoryPropertyFlags properties, VkBuffer &buffer,
-                           VkDeviceMemory &bufferMemory) {
+  // The memory has all of properties, and also preferred when the device has
+  // such memory. Returns the flags of the memory type that was picked.
+  static VkMemoryPropertyFlags
+  CreateBuffer(VkPhysicalDevice physicalDevice, VkDevice device,
+               VkDeviceSize size, VkBufferUsageFlags usage,
+               VkMemoryPropertyFlags properties, VkBuffer &buffer,
+               VkDeviceMemory &bufferMemory,
+               VkMemoryPropertyFlags preferred = 0) {
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.size = size;
@@ -81,44 +208,18 @@ public:
     VkMemoryAllocateInfo memAllocInfo{};
     memAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     memAllocInfo.allocationSize = memRequirements.size;
-    memAllocInfo.memoryTypeIndex = FindMemoryType(
-        physicalDevice, memRequirements.memoryTypeBits, properties);
+    VkMemoryPropertyFlags flags = properties | preferred;
+    if (!TryFindMemoryType(physicalDevice, memRequirements.memoryTypeBits,
+                           flags, &memAllocInfo.memoryTypeIndex)) {
+      flags = properties;
+      memAllocInfo.memoryTypeIndex = FindMemoryType(
+          physicalDevice, memRequirements.memoryTypeBits, properties);
+    }
 
     res = vkAllocateMemory(device, &memAllocInfo, nullptr, &bufferMemory);
     ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to allocate memory for buffer!");
     vkBindBufferMemory(device, buffer, bufferMemory, 0);
-  }
-
-  static void CopyBuffer(VkDevice device, VkCommandPool commandPool,
-                         VkQueue graphicsQueue, VkBuffer srcBuffer,
-                         VkBuffer dstBuffer, VkDeviceSize size) {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = commandPool;
-    allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer commandBuffer;
-    vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(commandBuffer, &beginInfo);
-
-    VkBufferCopy copyRegion{};
-    copyRegion.size = size;
-    vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
-    vkEndCommandBuffer(commandBuffer);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(graphicsQueue);
-    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    return flags;
   }
 };
 
@@ -0,0 +1,138 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Application.h"
+
+#include "Platform/Vulkan/VulkanBufferUploader.h"
+#include "Platform/Vulkan/VulkanContext.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace MyEngine {
+struct PendingCopy {
+  // Destination offset
+  VkDeviceSize Offset;
+  VkBuffer Staging;
+  VkDeviceSize StagingOffset;
+  VkDeviceSize Size;
+};
+
+struct BufferUploaderData {
+  // Copies into each buffer, sorted by offset and never overlapping
+  std::unordered_map<VkBuffer, std::vector<PendingCopy>> Pending;
+};
+
+static Unique<BufferUploaderData> s_Data;
+
+void VulkanBufferUploader::Init() {
+  s_Data = CreateUnique<BufferUploaderData>();
+}
+
+void VulkanBufferUploader::Shutdown() { s_Data.reset(); }
+
+void VulkanBufferUploader::Update(VkCommandBuffer commandBuffer) {
+  if (!s_Data || s_Data->Pending.empty()) {
+    return;
+  }
+
+  // Earlier frames read the buffers as vertices and indices, the barriers
+  // order the copies after them and the draws of this frame after the copies
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = 0;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0,
+                       nullptr, 0, nullptr);
+
+  // One vkCmdCopyBuffer per run of copies out of the same staging page
+  std::vector<VkBufferCopy> regions;
+  for (const auto &[buffer, copies] : s_Data->Pending) {
+    for (size_t first = 0; first < copies.size();) {
+      regions.clear();
+      size_t last = first;
+      for (; last < copies.size() && copies[last].Staging ==
+                                         copies[first].Staging;
+           last++) {
+        VkBufferCopy region{};
+        region.srcOffset = copies[last].StagingOffset;
+        region.dstOffset = copies[last].Offset;
+        region.size = copies[last].Size;
+        regions.push_back(region);
+      }
+      vkCmdCopyBuffer(commandBuffer, copies[first].Staging, buffer,
+                      (uint32_t)regions.size(), regions.data());
+      first = last;
+    }
+  }
+
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask =
+      VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &barrier, 0,
+                       nullptr, 0, nullptr);
+
+  s_Data->Pending.clear();
+}
+
+void VulkanBufferUploader::Queue(VkBuffer buffer, VkDeviceSize offset,
+                                 const void *data, VkDeviceSize size) {
+  if (size != 0) {
+    memcpy(Allocate(buffer, offset, size), data, size);
+  }
+}
+
+void *VulkanBufferUploader::Allocate(VkBuffer buffer, VkDeviceSize offset,
+                                     VkDeviceSize size) {
+  ME_CORE_ASSERT(s_Data, "Buffers can't be updated before the renderer!");
+  ME_CORE_ASSERT(size != 0, "Empty buffer uploads need no staging memory!");
+
+  // Written into staging memory right away, nothing else holds the data
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  VulkanStagingSpan<uint8_t> staging =
+      context->StagingBelt.Allocate<uint8_t>(size);
+
+  // Earlier copies lose the bytes the new one overwrites, so the newest data
+  // wins without ever copying staging memory around
+  std::vector<PendingCopy> &copies = s_Data->Pending[buffer];
+  const VkDeviceSize end = offset + size;
+  auto it = copies.begin();
+  while (it != copies.end() && it->Offset + it->Size <= offset) {
+    it++;
+  }
+  while (it != copies.end() && it->Offset < end) {
+    const VkDeviceSize itEnd = it->Offset + it->Size;
+    if (it->Offset < offset && itEnd > end) {
+      // Split around the new copy, which goes before the tail
+      PendingCopy tail = *it;
+      tail.StagingOffset += end - it->Offset;
+      tail.Offset = end;
+      tail.Size = itEnd - end;
+      it->Size = offset - it->Offset;
+      it = copies.insert(it + 1, tail);
+      break;
+    }
+    if (it->Offset < offset) {
+      it->Size = offset - it->Offset;
+      it++;
+    } else if (itEnd > end) {
+      it->StagingOffset += end - it->Offset;
+      it->Size = itEnd - end;
+      it->Offset = end;
+      break;
+    } else {
+      it = copies.erase(it);
+    }
+  }
+  copies.insert(it, {offset, staging.Buffer, staging.Offset, size});
+  return staging.Data.data();
+}
+
+void VulkanBufferUploader::Cancel(VkBuffer buffer) {
+  if (s_Data) {
+    s_Data->Pending.erase(buffer);
+  }
+}
+} // namespace MyEngine
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+// Moves buffer data to the GPU without stalling the queue. Queued data is
+// written straight into the staging belt, later ranges trim the parts of
+// earlier ones they overwrite. When the frame ends every range is copied by an
+// upload command buffer submitted ahead of the frame, so the data set at any
+// point of a frame is seen by all of its draws. Frames submitted earlier
+// finish reading the buffers before the copies start.
+class VulkanBufferUploader {
+public:
+  static void Init();
+  static void Shutdown();
+
+  static void Update(VkCommandBuffer commandBuffer);
+
+  // The data is copied, it may be reused right away
+  static void Queue(VkBuffer buffer, VkDeviceSize offset, const void *data,
+                    VkDeviceSize size);
+  // Like Queue but returns the staging memory to write the data into, so data
+  // that is converted first doesn't need a copy of its own. Filled before the
+  // frame ends.
+  static void *Allocate(VkBuffer buffer, VkDeviceSize offset,
+                        VkDeviceSize size);
+  // Drops the pending ranges of a buffer that is destroyed
+  static void Cancel(VkBuffer buffer);
+};
+} // namespace MyEngine
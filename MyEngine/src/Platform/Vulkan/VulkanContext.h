@@ -3,15 +3,26 @@
 #include <vulkan/vulkan.h>
 
 #include "MyEngine/Renderer/GraphicsContext.h"
+#include "Platform/Vulkan/VulkanBindlessTable.h"
+#include "Platform/Vulkan/VulkanDeletionQueue.h"
+#include "Platform/Vulkan/VulkanDescriptorAllocator.h"
+#include "Platform/Vulkan/VulkanLayoutCache.h"
+#include "Platform/Vulkan/VulkanSamplerCache.h"
+#include "Platform/Vulkan/VulkanStagingBelt.h"
+#include "Platform/Vulkan/VulkanUniformRing.h"
 
 namespace MyEngine {
 struct VulkanFrame {
   VkCommandPool CommandPool;
   VkCommandBuffer CommandBuffer;
+  // Buffer copies of the frame, submitted ahead of CommandBuffer
+  VkCommandBuffer UploadCommandBuffer;
   VkFence Fence;
   VkImage BackBuffer;
   VkImageView BackBufferView;
   VkFramebuffer Framebuffer;
+  // Serial of the last frame recorded into this frame's command buffer
+  uint64_t Serial;
 };
 
 struct VulkanFrameSemaphores {
@@ -72,12 +83,32 @@ public:
   VkQueue Queue = VK_NULL_HANDLE;
   VkDebugReportCallbackEXT DebugReport = VK_NULL_HANDLE;
   VkPipelineCache PipelineCache = VK_NULL_HANDLE;
+  // Only used by ImGui, the renderer allocates from DescriptorAllocator
   VkDescriptorPool DescriptorPool = VK_NULL_HANDLE;
   uint32_t MinImageCount = 2;
   bool RebuildSwapchain = false;
+  // The device supports and enabled what the bindless table needs
+  bool DescriptorIndexing = false;
+
+  // Incremented for every recorded frame, CompletedSerial is the newest frame
+  // the GPU is known to have finished
+  uint64_t FrameSerial = 0;
+  uint64_t CompletedSerial = 0;
+  VulkanDeletionQueue DeletionQueue;
+  VulkanLayoutCache LayoutCache;
+  VulkanSamplerCache SamplerCache;
+  VulkanUniformRing UniformRing;
+  VulkanStagingBelt StagingBelt;
+  VulkanDescriptorAllocator DescriptorAllocator;
+  VulkanBindlessTable Bindless;
 
   VulkanWindow Window;
 
+  // Destroys an object once the frames that may use it finished
+  void Defer(std::function<void()> &&deleter) {
+    DeletionQueue.Push(FrameSerial, std::move(deleter));
+  }
+
   bool IsValid() {
     return PhysicalDevice != VK_NULL_HANDLE &&
            LogicalDevice != VK_NULL_HANDLE && Instance != VK_NULL_HANDLE &&
@@ -90,6 +121,8 @@ public:
     ME_CORE_ASSERT(res == VK_SUCCESS,
                    "Unable to wait for device idle when cleaning up vulkan!");
 
+    DeletionQueue.FlushAll();
+
     for (uint32_t i = 0; i < this->Window.ImageCount; i++) {
       DestroyFrame(&this->Window.Frames[i]);
     }
@@ -110,6 +143,12 @@ public:
 
     vkDestroyDescriptorPool(this->LogicalDevice, this->DescriptorPool,
                             this->AllocationCallback);
+    DescriptorAllocator.Destroy();
+    Bindless.Destroy(this);
+    LayoutCache.Destroy(this->LogicalDevice, this->AllocationCallback);
+    SamplerCache.Destroy(this->LogicalDevice, this->AllocationCallback);
+    UniformRing.Destroy(this);
+    StagingBelt.Destroy();
 
 #ifdef ME_DEBUG
     auto f_vkDestroyDebugReportCallbackEXT =
@@ -129,10 +168,13 @@ private:
     vkDestroyFence(this->LogicalDevice, fd->Fence, this->AllocationCallback);
     vkFreeCommandBuffers(this->LogicalDevice, fd->CommandPool, 1,
                          &fd->CommandBuffer);
+    vkFreeCommandBuffers(this->LogicalDevice, fd->CommandPool, 1,
+                         &fd->UploadCommandBuffer);
     vkDestroyCommandPool(this->LogicalDevice, fd->CommandPool,
                          this->AllocationCallback);
     fd->Fence = VK_NULL_HANDLE;
     fd->CommandBuffer = VK_NULL_HANDLE;
+    fd->UploadCommandBuffer = VK_NULL_HANDLE;
     fd->CommandPool = VK_NULL_HANDLE;
 
     vkDestroyImageView(this->LogicalDevice, fd->BackBufferView,
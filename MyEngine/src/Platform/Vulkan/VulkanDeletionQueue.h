@@ -0,0 +1,35 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+
+namespace MyEngine {
+// Defers destroying vulkan objects until the GPU finished every frame that
+// could still reference them. Entries are tagged with the serial of the frame
+// being recorded when they were retired.
+class VulkanDeletionQueue {
+public:
+  void Push(uint64_t serial, std::function<void()> &&deleter) {
+    m_Deleters.emplace_back(serial, std::move(deleter));
+  }
+
+  // Runs the deleters of every frame up to and including completedSerial
+  void Flush(uint64_t completedSerial) {
+    while (!m_Deleters.empty() && m_Deleters.front().first <= completedSerial) {
+      m_Deleters.front().second();
+      m_Deleters.pop_front();
+    }
+  }
+
+  // Only safe once the device is idle
+  void FlushAll() {
+    for (auto &[serial, deleter] : m_Deleters) {
+      deleter();
+    }
+    m_Deleters.clear();
+  }
+
+private:
+  std::deque<std::pair<uint64_t, std::function<void()>>> m_Deleters;
+};
+} // namespace MyEngine
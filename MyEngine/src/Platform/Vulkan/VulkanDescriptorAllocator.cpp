@@ -0,0 +1,246 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanDescriptorAllocator.h"
+
+namespace MyEngine {
+template <typename T> static void AppendKey(std::string *pKey, const T &value) {
+  pKey->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Descriptors per set of every type a pool provides
+static const std::pair<VkDescriptorType, float> s_PoolRatios[] = {
+    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2.0f},
+    {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f},
+    {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f},
+    {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1.0f},
+    {VK_DESCRIPTOR_TYPE_SAMPLER, 1.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1.0f},
+    {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f},
+};
+
+VulkanDescriptorWriter &
+VulkanDescriptorWriter::WriteBuffer(uint32_t binding, VkDescriptorType type,
+                                    VkBuffer buffer, VkDeviceSize offset,
+                                    VkDeviceSize range) {
+  m_Writes.push_back({binding, type, (uint32_t)m_BufferInfos.size(), false});
+  m_BufferInfos.push_back({buffer, offset, range});
+
+  AppendKey(&m_Key, binding);
+  AppendKey(&m_Key, type);
+  AppendKey(&m_Key, buffer);
+  AppendKey(&m_Key, offset);
+  AppendKey(&m_Key, range);
+  return *this;
+}
+
+VulkanDescriptorWriter &
+VulkanDescriptorWriter::WriteImage(uint32_t binding, VkDescriptorType type,
+                                   VkImageView view, VkSampler sampler,
+                                   VkImageLayout layout) {
+  m_Writes.push_back({binding, type, (uint32_t)m_ImageInfos.size(), true});
+  m_ImageInfos.push_back({sampler, view, layout});
+
+  AppendKey(&m_Key, binding);
+  AppendKey(&m_Key, type);
+  AppendKey(&m_Key, view);
+  AppendKey(&m_Key, sampler);
+  AppendKey(&m_Key, layout);
+  return *this;
+}
+
+void VulkanDescriptorWriter::Update(VkDevice device,
+                                    VkDescriptorSet set) const {
+  if (m_Writes.empty()) {
+    return;
+  }
+
+  std::vector<VkWriteDescriptorSet> writes;
+  writes.reserve(m_Writes.size());
+  for (const Write &w : m_Writes) {
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = set;
+    write.dstBinding = w.Binding;
+    write.descriptorCount = 1;
+    write.descriptorType = w.Type;
+    if (w.Image) {
+      write.pImageInfo = &m_ImageInfos[w.Info];
+    } else {
+      write.pBufferInfo = &m_BufferInfos[w.Info];
+    }
+    writes.push_back(write);
+  }
+  vkUpdateDescriptorSets(device, (uint32_t)writes.size(), writes.data(), 0,
+                         nullptr);
+}
+
+void VulkanDescriptorAllocator::Init(VkDevice device,
+                                     const VkAllocationCallbacks *allocator) {
+  m_Device = device;
+  m_Allocator = allocator;
+}
+
+void VulkanDescriptorAllocator::Destroy() {
+  for (const Pool &pool : m_FramePools) {
+    vkDestroyDescriptorPool(m_Device, pool.Handle, m_Allocator);
+  }
+  for (const auto &[serial, pool] : m_RetiredPools) {
+    vkDestroyDescriptorPool(m_Device, pool.Handle, m_Allocator);
+  }
+  for (const Pool &pool : m_FreePools) {
+    vkDestroyDescriptorPool(m_Device, pool.Handle, m_Allocator);
+  }
+  for (const Pool &pool : m_PersistentPools) {
+    vkDestroyDescriptorPool(m_Device, pool.Handle, m_Allocator);
+  }
+  m_FramePools.clear();
+  m_RetiredPools.clear();
+  m_FreePools.clear();
+  m_PersistentPools.clear();
+  m_FrameSets.clear();
+  m_PersistentSets.clear();
+  m_PersistentBufferSets.clear();
+}
+
+void VulkanDescriptorAllocator::BeginFrame(uint64_t frameSerial,
+                                           uint64_t completedSerial) {
+  for (const Pool &pool : m_FramePools) {
+    m_RetiredPools.emplace_back(frameSerial, pool);
+  }
+  m_FramePools.clear();
+  m_FrameSets.clear();
+
+  while (!m_RetiredPools.empty() &&
+         m_RetiredPools.front().first <= completedSerial) {
+    const Pool &pool = m_RetiredPools.front().second;
+    VkResult res = vkResetDescriptorPool(m_Device, pool.Handle, 0);
+    ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to reset descriptor pool!");
+    m_FreePools.push_back(pool);
+    m_RetiredPools.pop_front();
+  }
+}
+
+VkDescriptorSet
+VulkanDescriptorAllocator::AllocateFrameSet(VkDescriptorSetLayout layout) {
+  return Allocate(&m_FramePools, &m_FreePools, &m_FrameSetsPerPool, layout);
+}
+
+VkDescriptorSet
+VulkanDescriptorAllocator::GetFrameSet(VkDescriptorSetLayout layout,
+                                       const VulkanDescriptorWriter &writer) {
+  std::string key = MakeKey(layout, writer);
+  auto it = m_FrameSets.find(key);
+  if (it != m_FrameSets.end()) {
+    return it->second;
+  }
+
+  VkDescriptorSet set = AllocateFrameSet(layout);
+  writer.Update(m_Device, set);
+  m_FrameSets.emplace(std::move(key), set);
+  return set;
+}
+
+VkDescriptorSet VulkanDescriptorAllocator::GetPersistentSet(
+    VkDescriptorSetLayout layout, const VulkanDescriptorWriter &writer) {
+  std::string key = MakeKey(layout, writer);
+  auto it = m_PersistentSets.find(key);
+  if (it != m_PersistentSets.end()) {
+    return it->second;
+  }
+
+  VkDescriptorSet set =
+      Allocate(&m_PersistentPools, nullptr, &m_PersistentSetsPerPool, layout);
+  writer.Update(m_Device, set);
+  for (const VkDescriptorBufferInfo &info : writer.GetBufferInfos()) {
+    m_PersistentBufferSets[info.buffer].push_back(key);
+  }
+  m_PersistentSets.emplace(std::move(key), set);
+  return set;
+}
+
+void VulkanDescriptorAllocator::ReleasePersistentSets(VkBuffer buffer) {
+  auto it = m_PersistentBufferSets.find(buffer);
+  if (it == m_PersistentBufferSets.end()) {
+    return;
+  }
+  for (const std::string &key : it->second) {
+    m_PersistentSets.erase(key);
+  }
+  m_PersistentBufferSets.erase(it);
+}
+
+VulkanDescriptorAllocator::Pool
+VulkanDescriptorAllocator::CreatePool(uint32_t maxSets) const {
+  std::vector<VkDescriptorPoolSize> sizes;
+  for (const auto &[type, ratio] : s_PoolRatios) {
+    sizes.push_back({type, (uint32_t)(ratio * (float)maxSets)});
+  }
+
+  VkDescriptorPoolCreateInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  info.maxSets = maxSets;
+  info.poolSizeCount = (uint32_t)sizes.size();
+  info.pPoolSizes = sizes.data();
+
+  Pool pool;
+  pool.MaxSets = maxSets;
+  VkResult res =
+      vkCreateDescriptorPool(m_Device, &info, m_Allocator, &pool.Handle);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create descriptor pool!");
+  return pool;
+}
+
+VkDescriptorSet VulkanDescriptorAllocator::Allocate(
+    std::vector<Pool> *pPools, std::vector<Pool> *pFreePools,
+    uint32_t *pSetsPerPool, VkDescriptorSetLayout layout) {
+  VkDescriptorSetAllocateInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  info.descriptorSetCount = 1;
+  info.pSetLayouts = &layout;
+
+  VkDescriptorSet set;
+  if (!pPools->empty()) {
+    info.descriptorPool = pPools->back().Handle;
+    VkResult res = vkAllocateDescriptorSets(m_Device, &info, &set);
+    if (res == VK_SUCCESS) {
+      return set;
+    }
+    ME_CORE_ASSERT(res == VK_ERROR_OUT_OF_POOL_MEMORY ||
+                       res == VK_ERROR_FRAGMENTED_POOL,
+                   "Unable to allocate descriptor set!");
+    *pSetsPerPool = std::min(*pSetsPerPool * 2, MaxSetsPerPool);
+  }
+
+  // Free pools that are too small for the grown size are dropped
+  Pool pool{VK_NULL_HANDLE, 0};
+  while (pFreePools != nullptr && !pFreePools->empty() &&
+         pool.Handle == VK_NULL_HANDLE) {
+    if (pFreePools->back().MaxSets >= *pSetsPerPool) {
+      pool = pFreePools->back();
+    } else {
+      vkDestroyDescriptorPool(m_Device, pFreePools->back().Handle,
+                              m_Allocator);
+    }
+    pFreePools->pop_back();
+  }
+  if (pool.Handle == VK_NULL_HANDLE) {
+    pool = CreatePool(*pSetsPerPool);
+  }
+  pPools->push_back(pool);
+
+  info.descriptorPool = pool.Handle;
+  VkResult res = vkAllocateDescriptorSets(m_Device, &info, &set);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to allocate descriptor set!");
+  return set;
+}
+
+std::string
+VulkanDescriptorAllocator::MakeKey(VkDescriptorSetLayout layout,
+                                   const VulkanDescriptorWriter &writer) {
+  std::string key;
+  AppendKey(&key, layout);
+  key += writer.GetKey();
+  return key;
+}
+} // namespace MyEngine
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+// Contents of a descriptor set. Fills freshly allocated sets and doubles as
+// the key of the set caches, so writes should be added in a stable order.
+class VulkanDescriptorWriter {
+public:
+  VulkanDescriptorWriter &WriteBuffer(uint32_t binding, VkDescriptorType type,
+                                      VkBuffer buffer, VkDeviceSize offset,
+                                      VkDeviceSize range);
+  VulkanDescriptorWriter &WriteImage(uint32_t binding, VkDescriptorType type,
+                                     VkImageView view, VkSampler sampler,
+                                     VkImageLayout layout);
+
+  void Update(VkDevice device, VkDescriptorSet set) const;
+
+  const std::string &GetKey() const { return m_Key; }
+  const std::vector<VkDescriptorBufferInfo> &GetBufferInfos() const {
+    return m_BufferInfos;
+  }
+
+private:
+  struct Write {
+    uint32_t Binding;
+    VkDescriptorType Type;
+    // Index into the buffer or image infos
+    uint32_t Info;
+    bool Image;
+  };
+
+  std::vector<Write> m_Writes;
+  std::vector<VkDescriptorBufferInfo> m_BufferInfos;
+  std::vector<VkDescriptorImageInfo> m_ImageInfos;
+  std::string m_Key;
+};
+
+// Hands out descriptor sets from pools that grow on demand instead of one
+// fixed pool, so the number of materials is not limited by a pool size.
+//
+// Frame sets come from pools that are reset wholesale once the GPU finished
+// the frame that used them, nothing is ever freed individually. Persistent
+// sets come from long lived pools and are shared by everything asking for the
+// same layout and contents. Both kinds are cached by their contents, frame
+// sets only for the rest of their frame.
+class VulkanDescriptorAllocator {
+public:
+  static constexpr uint32_t InitialSetsPerPool = 64;
+  static constexpr uint32_t MaxSetsPerPool = 4096;
+
+  void Init(VkDevice device, const VkAllocationCallbacks *allocator);
+  void Destroy();
+
+  // Called once the fence of a frame was waited on. Sets allocated so far
+  // belong to frameSerial, pools of frames up to completedSerial are reset.
+  void BeginFrame(uint64_t frameSerial, uint64_t completedSerial);
+
+  // Valid until the end of the frame being recorded
+  VkDescriptorSet AllocateFrameSet(VkDescriptorSetLayout layout);
+  VkDescriptorSet GetFrameSet(VkDescriptorSetLayout layout,
+                              const VulkanDescriptorWriter &writer);
+
+  // Valid until the allocator is destroyed. The set is shared, so it may only
+  // reference resources that live as long, like the uniform ring.
+  VkDescriptorSet GetPersistentSet(VkDescriptorSetLayout layout,
+                                   const VulkanDescriptorWriter &writer);
+  // Stops handing out the persistent sets referencing a buffer that is about
+  // to be destroyed, so a later buffer with the same handle gets new sets.
+  // Frames in flight may keep using the old sets.
+  void ReleasePersistentSets(VkBuffer buffer);
+
+private:
+  struct Pool {
+    VkDescriptorPool Handle;
+    uint32_t MaxSets;
+  };
+
+  Pool CreatePool(uint32_t maxSets) const;
+  // Allocates from the last of pools. When it is full the pool size grows
+  // and a new pool is appended, reusing one of pFreePools when possible.
+  VkDescriptorSet Allocate(std::vector<Pool> *pPools,
+                           std::vector<Pool> *pFreePools,
+                           uint32_t *pSetsPerPool,
+                           VkDescriptorSetLayout layout);
+  static std::string MakeKey(VkDescriptorSetLayout layout,
+                             const VulkanDescriptorWriter &writer);
+
+  VkDevice m_Device = VK_NULL_HANDLE;
+  const VkAllocationCallbacks *m_Allocator = nullptr;
+
+  // Pools used by the frame being recorded, the last one is allocated from
+  std::vector<Pool> m_FramePools;
+  // Pools of frames the GPU may still be using, tagged with the frame serial
+  std::deque<std::pair<uint64_t, Pool>> m_RetiredPools;
+  std::vector<Pool> m_FreePools;
+  uint32_t m_FrameSetsPerPool = InitialSetsPerPool;
+  std::unordered_map<std::string, VkDescriptorSet> m_FrameSets;
+
+  std::vector<Pool> m_PersistentPools;
+  uint32_t m_PersistentSetsPerPool = InitialSetsPerPool;
+  std::unordered_map<std::string, VkDescriptorSet> m_PersistentSets;
+  // Keys of the persistent sets referencing each buffer
+  std::unordered_map<VkBuffer, std::vector<std::string>> m_PersistentBufferSets;
+};
+} // namespace MyEngine
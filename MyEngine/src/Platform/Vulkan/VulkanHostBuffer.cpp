@@ -0,0 +1,114 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanBuffer.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanHostBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace MyEngine {
+// Non coherent buffers written since the last FlushAll
+static std::vector<VulkanHostBuffer *> s_DirtyBuffers;
+
+VulkanHostBuffer::VulkanHostBuffer(VulkanContext *context, VkDeviceSize size,
+                                   VkBufferUsageFlags usage,
+                                   VkMemoryPropertyFlags preferred)
+    : m_Context(context), m_Size(size) {
+  const VkMemoryPropertyFlags flags = VulkanBufferHelper::CreateBuffer(
+      context->PhysicalDevice, context->LogicalDevice, size, usage,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, m_Buffer, m_Memory, preferred);
+  m_Coherent = (flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+  if (!m_Coherent) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(context->PhysicalDevice, &properties);
+    m_AtomSize = properties.limits.nonCoherentAtomSize;
+  }
+
+  void *mapped;
+  VkResult res = vkMapMemory(context->LogicalDevice, m_Memory, 0,
+                             VK_WHOLE_SIZE, 0, &mapped);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to map host buffer!");
+  m_Mapped = static_cast<uint8_t *>(mapped);
+}
+
+VulkanHostBuffer::~VulkanHostBuffer() {
+  if (m_DirtyBegin != m_DirtyEnd) {
+    s_DirtyBuffers.erase(
+        std::find(s_DirtyBuffers.begin(), s_DirtyBuffers.end(), this));
+  }
+
+  vkUnmapMemory(m_Context->LogicalDevice, m_Memory);
+  vkDestroyBuffer(m_Context->LogicalDevice, m_Buffer, nullptr);
+  vkFreeMemory(m_Context->LogicalDevice, m_Memory, nullptr);
+}
+
+void VulkanHostBuffer::Write(VkDeviceSize offset, const void *data,
+                             VkDeviceSize size) {
+  memcpy(Map<uint8_t>(offset, size).data(), data, size);
+}
+
+void VulkanHostBuffer::Invalidate() {
+  if (m_Coherent) {
+    return;
+  }
+
+  VkMappedMemoryRange range{};
+  range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+  range.memory = m_Memory;
+  range.offset = 0;
+  range.size = VK_WHOLE_SIZE;
+  VkResult res =
+      vkInvalidateMappedMemoryRanges(m_Context->LogicalDevice, 1, &range);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to invalidate host buffer!");
+}
+
+void VulkanHostBuffer::MarkWritten(VkDeviceSize offset, VkDeviceSize size) {
+  if (m_Coherent || size == 0) {
+    return;
+  }
+
+  // One range per buffer, writes into the rings and staging pages are mostly
+  // consecutive so little is flushed needlessly
+  if (m_DirtyBegin == m_DirtyEnd) {
+    s_DirtyBuffers.push_back(this);
+    m_DirtyBegin = offset;
+    m_DirtyEnd = offset + size;
+  } else {
+    m_DirtyBegin = std::min(m_DirtyBegin, offset);
+    m_DirtyEnd = std::max(m_DirtyEnd, offset + size);
+  }
+}
+
+void VulkanHostBuffer::FlushAll(VulkanContext *context) {
+  if (s_DirtyBuffers.empty()) {
+    return;
+  }
+
+  std::vector<VkMappedMemoryRange> ranges;
+  ranges.reserve(s_DirtyBuffers.size());
+  for (VulkanHostBuffer *buffer : s_DirtyBuffers) {
+    // Ranges have to start and end on atoms, unless they reach the end of
+    // the allocation
+    const VkDeviceSize atom = buffer->m_AtomSize;
+    const VkDeviceSize begin = buffer->m_DirtyBegin / atom * atom;
+    const VkDeviceSize end = (buffer->m_DirtyEnd + atom - 1) / atom * atom;
+
+    VkMappedMemoryRange range{};
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = buffer->m_Memory;
+    range.offset = begin;
+    range.size = end >= buffer->m_Size ? VK_WHOLE_SIZE : end - begin;
+    ranges.push_back(range);
+
+    buffer->m_DirtyBegin = 0;
+    buffer->m_DirtyEnd = 0;
+  }
+  s_DirtyBuffers.clear();
+
+  VkResult res = vkFlushMappedMemoryRanges(
+      context->LogicalDevice, (uint32_t)ranges.size(), ranges.data());
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to flush host buffers!");
+}
+} // namespace MyEngine
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Core/Span.h"
+
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+class VulkanContext;
+
+// Host visible buffer that stays mapped from creation until it is destroyed,
+// so writes are plain stores instead of a vkMapMemory and vkUnmapMemory pair.
+// Coherent memory is preferred for buffers the CPU writes. When the device only
+// offers non coherent host memory the written ranges are collected and FlushAll
+// flushes all of them in one vkFlushMappedMemoryRanges before the frame is
+// submitted. Buffers the GPU writes into prefer cached memory instead, which
+// is much faster to read, and are invalidated before they are read.
+class VulkanHostBuffer {
+public:
+  VulkanHostBuffer(
+      VulkanContext *context, VkDeviceSize size, VkBufferUsageFlags usage,
+      VkMemoryPropertyFlags preferred = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  ~VulkanHostBuffer();
+
+  VulkanHostBuffer(const VulkanHostBuffer &) = delete;
+  VulkanHostBuffer &operator=(const VulkanHostBuffer &) = delete;
+
+  // Writable view of count elements starting at a byte offset. The range is
+  // flushed with the frame, it has to be written before the frame is ended.
+  template <typename T> Span<T> Map(VkDeviceSize offset, size_t count) {
+    const VkDeviceSize size = sizeof(T) * count;
+    ME_CORE_ASSERT(offset + size <= m_Size, "Mapped range is out of bounds!");
+    MarkWritten(offset, size);
+    return Span<T>(reinterpret_cast<T *>(m_Mapped + offset), count);
+  }
+  void Write(VkDeviceSize offset, const void *data, VkDeviceSize size);
+
+  // Makes GPU writes visible to the host, only needed once after the frame
+  // writing them finished
+  void Invalidate();
+  Span<const uint8_t> GetData() const {
+    return Span<const uint8_t>(m_Mapped, m_Size);
+  }
+
+  VkBuffer GetBuffer() const { return m_Buffer; }
+  VkDeviceSize GetSize() const { return m_Size; }
+  bool IsCoherent() const { return m_Coherent; }
+
+  // Flushes the ranges written to non coherent buffers since the last call
+  static void FlushAll(VulkanContext *context);
+
+private:
+  void MarkWritten(VkDeviceSize offset, VkDeviceSize size);
+
+  VulkanContext *m_Context;
+  VkBuffer m_Buffer = VK_NULL_HANDLE;
+  VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+  uint8_t *m_Mapped = nullptr;
+  VkDeviceSize m_Size;
+  bool m_Coherent = true;
+  // Flushed ranges are aligned to it
+  VkDeviceSize m_AtomSize = 1;
+  // Written since the last flush, empty when begin and end are equal
+  VkDeviceSize m_DirtyBegin = 0;
+  VkDeviceSize m_DirtyEnd = 0;
+};
+} // namespace MyEngine
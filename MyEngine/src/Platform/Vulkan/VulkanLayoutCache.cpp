@@ -0,0 +1,91 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanLayoutCache.h"
+
+namespace MyEngine {
+template <typename T> static void AppendKey(std::string *pKey, const T &value) {
+  pKey->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+VkDescriptorSetLayout VulkanLayoutCache::GetDescriptorSetLayout(
+    VkDevice device, const VkAllocationCallbacks *allocator,
+    std::vector<VkDescriptorSetLayoutBinding> bindings) {
+  std::sort(bindings.begin(), bindings.end(),
+            [](const VkDescriptorSetLayoutBinding &a,
+               const VkDescriptorSetLayoutBinding &b) {
+              return a.binding < b.binding;
+            });
+
+  std::string key;
+  for (const VkDescriptorSetLayoutBinding &binding : bindings) {
+    AppendKey(&key, binding.binding);
+    AppendKey(&key, binding.descriptorType);
+    AppendKey(&key, binding.descriptorCount);
+    AppendKey(&key, binding.stageFlags);
+  }
+
+  auto it = m_SetLayouts.find(key);
+  if (it != m_SetLayouts.end()) {
+    return it->second;
+  }
+
+  VkDescriptorSetLayoutCreateInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  info.bindingCount = (uint32_t)bindings.size();
+  info.pBindings = bindings.data();
+
+  VkDescriptorSetLayout layout;
+  VkResult res = vkCreateDescriptorSetLayout(device, &info, allocator, &layout);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create descriptor set layout!");
+
+  m_SetLayouts.emplace(std::move(key), layout);
+  return layout;
+}
+
+VkPipelineLayout VulkanLayoutCache::GetPipelineLayout(
+    VkDevice device, const VkAllocationCallbacks *allocator,
+    const std::vector<VkDescriptorSetLayout> &setLayouts,
+    const std::vector<VkPushConstantRange> &pushConstants) {
+  std::string key;
+  AppendKey(&key, (uint32_t)setLayouts.size());
+  for (VkDescriptorSetLayout setLayout : setLayouts) {
+    AppendKey(&key, setLayout);
+  }
+  for (const VkPushConstantRange &range : pushConstants) {
+    AppendKey(&key, range.stageFlags);
+    AppendKey(&key, range.offset);
+    AppendKey(&key, range.size);
+  }
+
+  auto it = m_PipelineLayouts.find(key);
+  if (it != m_PipelineLayouts.end()) {
+    return it->second;
+  }
+
+  VkPipelineLayoutCreateInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  info.setLayoutCount = (uint32_t)setLayouts.size();
+  info.pSetLayouts = setLayouts.data();
+  info.pushConstantRangeCount = (uint32_t)pushConstants.size();
+  info.pPushConstantRanges = pushConstants.data();
+
+  VkPipelineLayout layout;
+  VkResult res = vkCreatePipelineLayout(device, &info, allocator, &layout);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Could not create pipeline layout!");
+
+  m_PipelineLayouts.emplace(std::move(key), layout);
+  return layout;
+}
+
+void VulkanLayoutCache::Destroy(VkDevice device,
+                                const VkAllocationCallbacks *allocator) {
+  for (auto &[key, layout] : m_PipelineLayouts) {
+    vkDestroyPipelineLayout(device, layout, allocator);
+  }
+  for (auto &[key, layout] : m_SetLayouts) {
+    vkDestroyDescriptorSetLayout(device, layout, allocator);
+  }
+  m_PipelineLayouts.clear();
+  m_SetLayouts.clear();
+}
+} // namespace MyEngine
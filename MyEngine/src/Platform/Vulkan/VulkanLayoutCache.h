@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+// Deduplicates descriptor set and pipeline layouts so pipelines with the same
+// interface share their layouts and stay compatible for descriptor binding.
+// Layouts live until the device is destroyed.
+class VulkanLayoutCache {
+public:
+  VkDescriptorSetLayout
+  GetDescriptorSetLayout(VkDevice device,
+                         const VkAllocationCallbacks *allocator,
+                         std::vector<VkDescriptorSetLayoutBinding> bindings);
+  VkPipelineLayout
+  GetPipelineLayout(VkDevice device, const VkAllocationCallbacks *allocator,
+                    const std::vector<VkDescriptorSetLayout> &setLayouts,
+                    const std::vector<VkPushConstantRange> &pushConstants);
+
+  void Destroy(VkDevice device, const VkAllocationCallbacks *allocator);
+
+private:
+  std::unordered_map<std::string, VkDescriptorSetLayout> m_SetLayouts;
+  std::unordered_map<std::string, VkPipelineLayout> m_PipelineLayouts;
+};
+} // namespace MyEngine
@@ -0,0 +1,218 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Application.h"
+
+#include "Platform/Vulkan/VulkanBuffer.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanReadback.h"
+
+#include <algorithm>
+
+namespace MyEngine {
+struct ReadbackData {
+  // Requested during the frame being recorded
+  std::vector<VulkanReadback *> Pending;
+  std::vector<Unique<VulkanHostBuffer>> FreeBuffers;
+};
+
+static Unique<ReadbackData> s_Data;
+
+VulkanReadback::VulkanReadback(const Ref<VertexBuffer> &buffer,
+                               uint32_t offset, uint32_t size) {
+  VulkanVertexBuffer *source = static_cast<VulkanVertexBuffer *>(buffer.get());
+  ME_CORE_ASSERT((uint64_t)offset + size <= source->GetSize(),
+                 "Readback range is out of bounds!");
+
+  m_SourceBuffer = source->GetBuffer();
+  m_Offset = offset;
+  Request(buffer, size);
+}
+
+VulkanReadback::VulkanReadback(const Ref<IndexBuffer> &buffer,
+                               uint32_t offset, uint32_t count) {
+  VulkanIndexBuffer *source = static_cast<VulkanIndexBuffer *>(buffer.get());
+  ME_CORE_ASSERT((uint64_t)offset + count <= source->GetCount(),
+                 "Readback range is out of bounds!");
+
+  const VkDeviceSize indexSize =
+      source->GetIndexType() == VK_INDEX_TYPE_UINT16 ? 2 : 4;
+  m_SourceBuffer = source->GetBuffer();
+  m_Offset = indexSize * offset;
+  m_Widen = indexSize == 2;
+  Request(buffer, indexSize * count);
+}
+
+VulkanReadback::VulkanReadback(const Ref<Texture2D> &texture) {
+  m_SourceTexture = static_cast<VulkanTexture2D *>(texture.get());
+  Request(texture, 0);
+}
+
+void VulkanReadback::Request(const Ref<void> &source, VkDeviceSize size) {
+  ME_CORE_ASSERT(s_Data, "Readbacks can't be requested before the renderer!");
+
+  m_Source = source;
+  m_Size = size;
+  if (!m_SourceTexture) {
+    m_Buffer = AcquireBuffer(std::max<VkDeviceSize>(size, 1));
+  }
+  s_Data->Pending.push_back(this);
+}
+
+VulkanReadback::~VulkanReadback() {
+  if (m_Serial == 0) {
+    // Not pending when the renderer was initialized again since the request
+    if (s_Data) {
+      auto &pending = s_Data->Pending;
+      auto it = std::find(pending.begin(), pending.end(), this);
+      if (it != pending.end()) {
+        pending.erase(it);
+      }
+    }
+    ReleaseBuffer(std::move(m_Buffer));
+    return;
+  }
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  if (context->CompletedSerial >= m_Serial) {
+    ReleaseBuffer(std::move(m_Buffer));
+    return;
+  }
+
+  // The copy is still in flight
+  VulkanHostBuffer *buffer = m_Buffer.release();
+  context->Defer(
+      [buffer]() { ReleaseBuffer(Unique<VulkanHostBuffer>(buffer)); });
+}
+
+bool VulkanReadback::IsReady() const {
+  if (m_Serial == 0) {
+    return false;
+  }
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  return context->CompletedSerial >= m_Serial;
+}
+
+Span<const uint8_t> VulkanReadback::GetData() const {
+  if (!IsReady()) {
+    return Span<const uint8_t>();
+  }
+
+  // Textures that weren't loaded have no buffer
+  if (!m_Buffer) {
+    return Span<const uint8_t>();
+  }
+
+  if (!m_Invalidated) {
+    m_Buffer->Invalidate();
+    m_Invalidated = true;
+
+    if (m_Widen) {
+      const uint16_t *indices =
+          reinterpret_cast<const uint16_t *>(m_Buffer->GetData().data());
+      m_Widened.assign(indices, indices + m_Size / sizeof(uint16_t));
+    }
+  }
+
+  if (m_Widen) {
+    return Span<const uint8_t>(
+        reinterpret_cast<const uint8_t *>(m_Widened.data()),
+        sizeof(uint32_t) * m_Widened.size());
+  }
+  return Span<const uint8_t>(m_Buffer->GetData().data(), m_Size);
+}
+
+void VulkanReadback::Init() { s_Data = CreateUnique<ReadbackData>(); }
+
+void VulkanReadback::Shutdown() { s_Data.reset(); }
+
+void VulkanReadback::RecordPending(VkCommandBuffer commandBuffer) {
+  if (!s_Data || s_Data->Pending.empty()) {
+    return;
+  }
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+
+  // The copies wait for everything written to the sources earlier, by
+  // transfers and shaders alike
+  VkMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0,
+                       nullptr, 0, nullptr);
+
+  for (VulkanReadback *readback : s_Data->Pending) {
+    readback->RecordCopy(commandBuffer);
+    readback->m_Serial = context->FrameSerial;
+    readback->m_Source.reset();
+  }
+
+  // Made available to the host with the fence of the frame
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr,
+                       0, nullptr);
+
+  s_Data->Pending.clear();
+}
+
+void VulkanReadback::RecordCopy(VkCommandBuffer commandBuffer) {
+  if (m_SourceTexture) {
+    // The image and its size are only known once the frame started
+    if (!m_SourceTexture->IsLoaded()) {
+      return;
+    }
+
+    m_Width = m_SourceTexture->GetResidentWidth();
+    m_Height = m_SourceTexture->GetResidentHeight();
+    m_Size = TextureFormatImageSize(
+        m_SourceTexture->GetSpecification().Format, m_Width, m_Height);
+    m_Buffer = AcquireBuffer(m_Size);
+    m_SourceTexture->RecordCopyToBuffer(commandBuffer, m_Buffer->GetBuffer());
+    return;
+  }
+
+  if (m_Size > 0) {
+    VkBufferCopy region{};
+    region.srcOffset = m_Offset;
+    region.dstOffset = 0;
+    region.size = m_Size;
+    vkCmdCopyBuffer(commandBuffer, m_SourceBuffer, m_Buffer->GetBuffer(), 1,
+                    &region);
+  }
+}
+
+Unique<VulkanHostBuffer> VulkanReadback::AcquireBuffer(VkDeviceSize size) {
+  // The smallest free buffer that fits, or a new one
+  auto &freeBuffers = s_Data->FreeBuffers;
+  auto best = freeBuffers.end();
+  for (auto it = freeBuffers.begin(); it != freeBuffers.end(); it++) {
+    if ((*it)->GetSize() >= size &&
+        (best == freeBuffers.end() || (*it)->GetSize() < (*best)->GetSize())) {
+      best = it;
+    }
+  }
+
+  if (best != freeBuffers.end()) {
+    Unique<VulkanHostBuffer> buffer = std::move(*best);
+    freeBuffers.erase(best);
+    return buffer;
+  }
+
+  return CreateUnique<VulkanHostBuffer>(
+      Application::Get().GetGraphicsContext<VulkanContext>(), size,
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+}
+
+void VulkanReadback::ReleaseBuffer(Unique<VulkanHostBuffer> buffer) {
+  if (buffer && s_Data && s_Data->FreeBuffers.size() < MaxFreeBuffers) {
+    s_Data->FreeBuffers.push_back(std::move(buffer));
+  }
+}
+} // namespace MyEngine
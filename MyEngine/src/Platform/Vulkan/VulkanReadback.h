@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MyEngine/Renderer/Readback.h"
+#include "Platform/Vulkan/VulkanHostBuffer.h"
+#include "Platform/Vulkan/VulkanTexture.h"
+
+namespace MyEngine {
+// Copies into a persistently mapped buffer in cached host memory. The copies
+// requested during a frame are recorded by RecordPending after its render
+// pass, and are ready once the fence of that frame was waited on for the
+// frame slot to be reused, a few frames later. Buffers of readbacks that are
+// done are kept for the next requests. 16 bit indices are widened on the
+// first GetData, textures get their buffer when the copy is recorded.
+class VulkanReadback : public Readback {
+public:
+  static constexpr size_t MaxFreeBuffers = 16;
+
+  VulkanReadback(const Ref<VertexBuffer> &buffer, uint32_t offset,
+                 uint32_t size);
+  VulkanReadback(const Ref<IndexBuffer> &buffer, uint32_t offset,
+                 uint32_t count);
+  VulkanReadback(const Ref<Texture2D> &texture);
+  virtual ~VulkanReadback();
+
+  virtual bool IsReady() const override;
+  virtual Span<const uint8_t> GetData() const override;
+
+  static void Init();
+  static void Shutdown();
+
+  // Records the copies requested so far, outside of a render pass
+  static void RecordPending(VkCommandBuffer commandBuffer);
+
+private:
+  static Unique<VulkanHostBuffer> AcquireBuffer(VkDeviceSize size);
+  static void ReleaseBuffer(Unique<VulkanHostBuffer> buffer);
+
+  void Request(const Ref<void> &source, VkDeviceSize size);
+  void RecordCopy(VkCommandBuffer commandBuffer);
+
+  // Held until the copy is recorded
+  Ref<void> m_Source;
+  VkBuffer m_SourceBuffer = VK_NULL_HANDLE;
+  VulkanTexture2D *m_SourceTexture = nullptr;
+  VkDeviceSize m_Offset = 0;
+  VkDeviceSize m_Size = 0;
+  Unique<VulkanHostBuffer> m_Buffer;
+  bool m_Widen = false;
+  mutable std::vector<uint32_t> m_Widened;
+  // Frame the copy was recorded in, 0 until then
+  uint64_t m_Serial = 0;
+  mutable bool m_Invalidated = false;
+};
+} // namespace MyEngine
@@ -4,8 +4,15 @@
 
 #include "MyEngine/Core/Application.h"
 #include "MyEngine/Renderer/GraphicsContext.h"
+#include "Platform/Vulkan/VulkanBufferUploader.h"
 #include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanHostBuffer.h"
+#include "Platform/Vulkan/VulkanReadback.h"
 #include "Platform/Vulkan/VulkanRendererAPI.h"
+#include "Platform/Vulkan/VulkanShader.h"
+#include "Platform/Vulkan/VulkanShaderReloader.h"
+#include "Platform/Vulkan/VulkanTextureStreamer.h"
+#include "Platform/Vulkan/VulkanTextureUploader.h"
 
 #include <SDL.h>
 #include <SDL2/SDL_vulkan.h>
@@ -23,12 +30,26 @@ void VulkanRendererAPI::Init() {
   Window &win = app.GetWindow();
   VulkanContext *ctx = static_cast<VulkanContext *>(win.GetGraphicsContext());
   SetupVulkan(ctx);
+  ctx->UniformRing.Init(ctx);
+  ctx->StagingBelt.Init(ctx);
+  ctx->DescriptorAllocator.Init(ctx->LogicalDevice, ctx->AllocationCallback);
+  ctx->Bindless.Init(ctx);
+  VulkanShaderReloader::Init();
+  VulkanBufferUploader::Init();
+  VulkanReadback::Init();
+  VulkanTextureUploader::Init();
+  VulkanTextureStreamer::Init();
 }
 
 void VulkanRendererAPI::Shutdown() {
   Application &app = Application::Get();
   Window &win = app.GetWindow();
   VulkanContext *ctx = static_cast<VulkanContext *>(win.GetGraphicsContext());
+  VulkanTextureStreamer::Shutdown();
+  VulkanTextureUploader::Shutdown();
+  VulkanReadback::Shutdown();
+  VulkanBufferUploader::Shutdown();
+  VulkanShaderReloader::Shutdown();
   CleanupVulkan(ctx);
 }
 
@@ -252,6 +273,41 @@ void VulkanRendererAPI::SetupVulkan(VulkanContext *context) {
     vkEnumerateDeviceExtensionProperties(context->PhysicalDevice, nullptr,
                                          &propertiesCount, properties.data());
 
+    // Descriptor indexing backs the bindless table, only the features it
+    // needs are enabled
+    VkPhysicalDeviceVulkan12Features supported12{};
+    supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supported{};
+    supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supported.pNext = &supported12;
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(context->PhysicalDevice, &deviceProperties);
+    if (deviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+      vkGetPhysicalDeviceFeatures2(context->PhysicalDevice, &supported);
+    }
+
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    context->DescriptorIndexing =
+        supported12.descriptorIndexing &&
+        supported12.runtimeDescriptorArray &&
+        supported12.descriptorBindingPartiallyBound &&
+        supported12.descriptorBindingUpdateUnusedWhilePending &&
+        supported12.descriptorBindingSampledImageUpdateAfterBind &&
+        supported12.descriptorBindingStorageBufferUpdateAfterBind &&
+        supported12.shaderSampledImageArrayNonUniformIndexing &&
+        supported12.shaderStorageBufferArrayNonUniformIndexing;
+    if (context->DescriptorIndexing) {
+      features12.descriptorIndexing = VK_TRUE;
+      features12.runtimeDescriptorArray = VK_TRUE;
+      features12.descriptorBindingPartiallyBound = VK_TRUE;
+      features12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+      features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+      features12.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+      features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+      features12.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+    }
+
     const float queuePriority[] = {1.0f};
 
     VkDeviceQueueCreateInfo queueInfo[1] = {};
@@ -263,6 +319,9 @@ void VulkanRendererAPI::SetupVulkan(VulkanContext *context) {
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    if (deviceProperties.apiVersion >= VK_API_VERSION_1_2) {
+      createInfo.pNext = &features12;
+    }
     createInfo.queueCreateInfoCount = sizeof(queueInfo) / sizeof(queueInfo[0]);
     createInfo.pQueueCreateInfos = queueInfo;
     createInfo.enabledExtensionCount = (uint32_t)deviceExtensions.size();
@@ -369,8 +428,31 @@ void VulkanRendererAPI::SetupVulkan(VulkanContext *context) {
     ME_CORE_TRACE("Surface format for vulkan selected successfully!");
   }
 
-  // Present mode
-  { context->Window.PresentMode = VK_PRESENT_MODE_FIFO_KHR; }
+  // Present mode, FIFO is the only one every device supports
+  {
+    context->Window.PresentMode = VK_PRESENT_MODE_FIFO_KHR;
+    if (!Application::Get().GetWindow().IsVsyncEnabled()) {
+      uint32_t modeCount;
+      vkGetPhysicalDeviceSurfacePresentModesKHR(context->PhysicalDevice,
+                                                context->Window.Surface,
+                                                &modeCount, nullptr);
+      std::vector<VkPresentModeKHR> modes(modeCount);
+      vkGetPhysicalDeviceSurfacePresentModesKHR(context->PhysicalDevice,
+                                                context->Window.Surface,
+                                                &modeCount, modes.data());
+
+      // Mailbox doesn't tear, immediate does
+      for (VkPresentModeKHR request :
+           {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR}) {
+        if (std::find(modes.begin(), modes.end(), request) != modes.end()) {
+          context->Window.PresentMode = request;
+          break;
+        }
+      }
+    }
+    ME_CORE_TRACE("Selected vulkan present mode {0}",
+                  (int)context->Window.PresentMode);
+  }
 
   // Swapchain
   {
@@ -402,6 +484,10 @@ void VulkanRendererAPI::CreateWindowSwapchain(VulkanContext *context,
   err = vkDeviceWaitIdle(context->LogicalDevice);
   ME_CORE_ASSERT(err == VK_SUCCESS, "Unable to wait for device idle to create "
                                     "swapchain when setting up vulkan!");
+  // The frames are recreated without their serials, everything submitted so
+  // far finished anyway
+  context->CompletedSerial = context->FrameSerial;
+  context->DeletionQueue.Flush(context->CompletedSerial);
 
   // Cleanup old memory
   {
@@ -412,10 +498,13 @@ void VulkanRendererAPI::CreateWindowSwapchain(VulkanContext *context,
                      context->AllocationCallback);
       vkFreeCommandBuffers(context->LogicalDevice, fd->CommandPool, 1,
                            &fd->CommandBuffer);
+      vkFreeCommandBuffers(context->LogicalDevice, fd->CommandPool, 1,
+                           &fd->UploadCommandBuffer);
       vkDestroyCommandPool(context->LogicalDevice, fd->CommandPool,
                            context->AllocationCallback);
       fd->Fence = VK_NULL_HANDLE;
       fd->CommandBuffer = VK_NULL_HANDLE;
+      fd->UploadCommandBuffer = VK_NULL_HANDLE;
       fd->CommandPool = VK_NULL_HANDLE;
 
       vkDestroyImageView(context->LogicalDevice, fd->BackBufferView,
@@ -670,6 +759,11 @@ void VulkanRendererAPI::CreateWindowCommandBuffers(VulkanContext *context) {
       ME_CORE_ASSERT(err == VK_SUCCESS,
                      "Unable to allocate command buffer when creating window "
                      "command buffers for vulkan!");
+      err = vkAllocateCommandBuffers(context->LogicalDevice, &info,
+                                     &fd->UploadCommandBuffer);
+      ME_CORE_ASSERT(err == VK_SUCCESS,
+                     "Unable to allocate upload command buffer when creating "
+                     "window command buffers for vulkan!");
     }
 
     {
@@ -710,6 +804,10 @@ bool VulkanRendererAPI::BeginFrame(GraphicsContext *ctx) {
   Window &window = app.GetWindow();
   VulkanContext *context = static_cast<VulkanContext *>(ctx);
 
+  // Finished recompiles are swapped in before anything of this frame is
+  // recorded
+  VulkanShaderReloader::Update();
+
   if (window.GetWidth() > 0 && window.GetHeight() > 0 &&
       (context->RebuildSwapchain ||
        context->Window.Width != window.GetWidth() ||
@@ -744,6 +842,16 @@ bool VulkanRendererAPI::BeginFrame(GraphicsContext *ctx) {
     err = vkResetFences(context->LogicalDevice, 1, &fd->Fence);
     ME_CORE_ASSERT(err == VK_SUCCESS,
                    "Unable to reset fences when beginning vulkan frame!");
+
+    // Everything recorded up to this frame's previous use finished
+    context->CompletedSerial = std::max(context->CompletedSerial, fd->Serial);
+    context->DeletionQueue.Flush(context->CompletedSerial);
+    context->UniformRing.BeginFrame(context->FrameSerial,
+                                    context->CompletedSerial);
+    context->DescriptorAllocator.BeginFrame(context->FrameSerial,
+                                            context->CompletedSerial);
+    context->StagingBelt.BeginFrame(context->CompletedSerial);
+    fd->Serial = ++context->FrameSerial;
   }
   {
     err = vkResetCommandPool(context->LogicalDevice, fd->CommandPool, 0);
@@ -757,6 +865,9 @@ bool VulkanRendererAPI::BeginFrame(GraphicsContext *ctx) {
         err == VK_SUCCESS,
         "Unable to begin command buffer when beginning vulkan frame!");
   }
+  // Texture copies have to be recorded outside of the render pass
+  VulkanTextureUploader::Update(fd->CommandBuffer);
+  VulkanTextureStreamer::Update(fd->CommandBuffer);
   {
     VkRenderPassBeginInfo info{};
     info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -785,6 +896,25 @@ void VulkanRendererAPI::EndFrame(GraphicsContext *ctx) {
       context->Window.GetRenderCompleteSemaphore();
 
   vkCmdEndRenderPass(fd->CommandBuffer);
+  // After the draws of the frame, whose results they may read
+  VulkanReadback::RecordPending(fd->CommandBuffer);
+  {
+    // Buffer data set at any point of the frame is copied before its draws
+    VkCommandBufferBeginInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VkResult err = vkBeginCommandBuffer(fd->UploadCommandBuffer, &info);
+    ME_CORE_ASSERT(
+        err == VK_SUCCESS,
+        "Unable to begin upload command buffer when ending vulkan frame!");
+    VulkanBufferUploader::Update(fd->UploadCommandBuffer);
+    err = vkEndCommandBuffer(fd->UploadCommandBuffer);
+    ME_CORE_ASSERT(
+        err == VK_SUCCESS,
+        "Unable to end upload command buffer when ending vulkan frame!");
+  }
+  // Nothing allocates staging space for this frame past this point
+  context->StagingBelt.EndFrame(context->FrameSerial);
   {
     VkPipelineStageFlags waitStage =
         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
@@ -793,11 +923,15 @@ void VulkanRendererAPI::EndFrame(GraphicsContext *ctx) {
     info.waitSemaphoreCount = 1;
     info.pWaitSemaphores = &imageAcquiredSemaphore;
     info.pWaitDstStageMask = &waitStage;
-    info.commandBufferCount = 1;
-    info.pCommandBuffers = &fd->CommandBuffer;
+    const VkCommandBuffer commandBuffers[] = {fd->UploadCommandBuffer,
+                                              fd->CommandBuffer};
+    info.commandBufferCount = 2;
+    info.pCommandBuffers = commandBuffers;
     info.signalSemaphoreCount = 1;
     info.pSignalSemaphores = &renderCompleteSemaphore;
 
+    // Host writes of the frame have to be visible before it is submitted
+    VulkanHostBuffer::FlushAll(context);
     VkResult err = vkEndCommandBuffer(fd->CommandBuffer);
     ME_CORE_ASSERT(err == VK_SUCCESS,
                    "Unable to end command buffer when ending vulkan frame!");
@@ -837,9 +971,17 @@ void VulkanRendererAPI::PresentFrame(GraphicsContext *ctx) {
       (context->Window.SemaphoreIndex + 1) % context->Window.SemaphoreCount;
 }
 
-void VulkanRendererAPI::DrawIndexed(const Ref<VertexArray> vertexArray) {
-  vertexArray->Bind();
-  vertexArray->Draw();
+void VulkanRendererAPI::DrawIndexed(const Ref<VertexArray> vertexArray,
+                                    const DrawRange &range) {
+  VulkanShader *shader = VulkanShader::GetBound();
+  ME_CORE_ASSERT(shader != nullptr, "No shader bound before drawing!");
+  if (!shader->BindPipeline(vertexArray->GetVertexBuffers())) {
+    return;
+  }
+  shader->BindResources();
+
+  // Renderer::Submit bound the vertex array
+  vertexArray->Draw(range);
 }
 
 } // namespace MyEngine
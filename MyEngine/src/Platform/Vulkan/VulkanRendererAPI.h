@@ -34,7 +34,8 @@ public:
   virtual void EndFrame(GraphicsContext *ctx) override;
   virtual void PresentFrame(GraphicsContext *ctx) override;
 
-  virtual void DrawIndexed(const Ref<VertexArray> vertexArray) override;
+  virtual void DrawIndexed(const Ref<VertexArray> vertexArray,
+                           const DrawRange &range) override;
 
 private:
   // +============+
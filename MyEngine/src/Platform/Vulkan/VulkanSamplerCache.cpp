@@ -0,0 +1,59 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanSamplerCache.h"
+
+namespace MyEngine {
+static VkSamplerAddressMode ToVulkanAddressMode(TextureWrap wrap) {
+  switch (wrap) {
+  case TextureWrap::Repeat:
+    return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+  case TextureWrap::MirroredRepeat:
+    return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+  case TextureWrap::ClampToEdge:
+    return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  }
+
+  ME_CORE_ASSERT(false, "Unknown texture wrap mode!");
+  return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+}
+
+VkSampler VulkanSamplerCache::GetSampler(VkDevice device,
+                                         const VkAllocationCallbacks *allocator,
+                                         TextureFilter filter,
+                                         TextureWrap wrap) {
+  const uint32_t key = ((uint32_t)filter << 8) | (uint32_t)wrap;
+  auto it = m_Samplers.find(key);
+  if (it != m_Samplers.end()) {
+    return it->second;
+  }
+
+  const bool linear = filter == TextureFilter::Linear;
+  VkSamplerCreateInfo info{};
+  info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+  info.magFilter = linear ? VK_FILTER_LINEAR : VK_FILTER_NEAREST;
+  info.minFilter = info.magFilter;
+  info.mipmapMode = linear ? VK_SAMPLER_MIPMAP_MODE_LINEAR
+                           : VK_SAMPLER_MIPMAP_MODE_NEAREST;
+  info.addressModeU = ToVulkanAddressMode(wrap);
+  info.addressModeV = info.addressModeU;
+  info.addressModeW = info.addressModeU;
+  info.minLod = 0.0f;
+  info.maxLod = VK_LOD_CLAMP_NONE;
+  info.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+
+  VkSampler sampler;
+  VkResult res = vkCreateSampler(device, &info, allocator, &sampler);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create sampler!");
+
+  m_Samplers.emplace(key, sampler);
+  return sampler;
+}
+
+void VulkanSamplerCache::Destroy(VkDevice device,
+                                 const VkAllocationCallbacks *allocator) {
+  for (auto &[key, sampler] : m_Samplers) {
+    vkDestroySampler(device, sampler, allocator);
+  }
+  m_Samplers.clear();
+}
+} // namespace MyEngine
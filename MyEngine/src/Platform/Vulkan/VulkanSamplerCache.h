@@ -0,0 +1,22 @@
+#pragma once
+
+#include "MyEngine/Renderer/Texture.h"
+
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+// Textures with the same filter and wrap mode share one sampler. Samplers
+// don't clamp the level of detail so they work for any number of mips, they
+// live until the device is destroyed.
+class VulkanSamplerCache {
+public:
+  VkSampler GetSampler(VkDevice device, const VkAllocationCallbacks *allocator,
+                       TextureFilter filter, TextureWrap wrap);
+
+  void Destroy(VkDevice device, const VkAllocationCallbacks *allocator);
+
+private:
+  std::unordered_map<uint32_t, VkSampler> m_Samplers;
+};
+} // namespace MyEngine
@@ -1,57 +1,526 @@
 #include "mepch.h"
 
 #include "MyEngine/Core/Application.h"
-#include "MyEngine/Renderer/Vertex.h"
+#include "MyEngine/Core/Hash.h"
+#include "Platform/Vulkan/VulkanBuffer.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanShader.h"
+#include "Platform/Vulkan/VulkanShaderReloader.h"
 #include "Platform/Vulkan/VulkanShaderStage.h"
 
+#include <cstring>
+#include <map>
+#include <vulkan/vk_enum_string_helper.h>
 #include <vulkan/vulkan.h>
 #include <vulkan/vulkan_core.h>
 
 namespace MyEngine {
+VulkanShader *VulkanShader::s_BoundShader = nullptr;
+
+static uint32_t GetColumnCount(ShaderDataType type) {
+  switch (type) {
+  case ShaderDataType::Mat3:
+    return 3;
+  case ShaderDataType::Mat4:
+    return 4;
+  default:
+    return 1;
+  }
+}
+
+static uint64_t HashLayouts(const std::vector<Ref<VertexBuffer>> &buffers) {
+  uint64_t hash = buffers.size();
+  for (const Ref<VertexBuffer> &buffer : buffers) {
+    const BufferLayout &layout = buffer->GetLayout();
+    hash = Hash::Combine(hash, layout.GetStride());
+    for (const BufferElement &element : layout) {
+      hash = Hash::Combine(hash, Hash::XXH64(element.Name));
+      hash = Hash::Combine(hash, (uint64_t)element.Type);
+      hash = Hash::Combine(hash, element.Offset);
+      hash = Hash::Combine(hash, element.Normalized);
+    }
+  }
+  return hash;
+}
+
+// Compares everything HashLayouts hashes
+static bool MatchesLayouts(const std::vector<BufferLayout> &layouts,
+                           const std::vector<Ref<VertexBuffer>> &buffers) {
+  if (layouts.size() != buffers.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < layouts.size(); i++) {
+    const BufferLayout &layout = buffers[i]->GetLayout();
+    const std::vector<BufferElement> &a = layouts[i].GetElements();
+    const std::vector<BufferElement> &b = layout.GetElements();
+    if (layouts[i].GetStride() != layout.GetStride() || a.size() != b.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < a.size(); j++) {
+      if (a[j].Name != b[j].Name || a[j].Type != b[j].Type ||
+          a[j].Offset != b[j].Offset || a[j].Normalized != b[j].Normalized) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 VulkanShader::VulkanShader(const std::string &name,
                            const std::vector<Ref<ShaderStage>> stages)
     : m_Name(name), m_Stages(std::move(stages)) {
+  m_Interface = CreateInterface();
+  VulkanShaderReloader::RegisterShader(this);
+}
+
+VulkanShader::~VulkanShader() {
+  VulkanShaderReloader::UnregisterShader(this);
+  if (s_BoundShader == this) {
+    s_BoundShader = nullptr;
+  }
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+
+  // The stages destroy their own modules, they may be shared between shaders.
+  // The pipeline layout belongs to the layout cache and the descriptor sets
+  // to the descriptor allocator.
+  for (auto &[hash, variant] : m_Pipelines) {
+    vkDestroyPipeline(context->LogicalDevice, variant.Pipeline,
+                      context->AllocationCallback);
+  }
+}
+
+void VulkanShader::Bind() { s_BoundShader = this; }
+
+bool VulkanShader::BindPipeline(
+    const std::vector<Ref<VertexBuffer>> &vertexBuffers) {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+
+  // Different layouts may share a hash, the stored layouts tell them apart
+  const uint64_t hash = HashLayouts(vertexBuffers);
+  auto [it, end] = m_Pipelines.equal_range(hash);
+  while (it != end && !MatchesLayouts(it->second.Layouts, vertexBuffers)) {
+    it++;
+  }
+  if (it == end) {
+    PipelineVariant variant;
+    for (const Ref<VertexBuffer> &buffer : vertexBuffers) {
+      variant.Layouts.push_back(buffer->GetLayout());
+    }
+
+    // Failed variants are kept with a null pipeline, so the error is only
+    // reported once
+    VkResult res = CreatePipeline(variant.Layouts, &variant.Pipeline);
+    if (res != VK_SUCCESS) {
+      ME_CORE_ERROR("Unable to create pipeline for shader {0}: {1}", m_Name,
+                    string_VkResult(res));
+      variant.Pipeline = VK_NULL_HANDLE;
+    }
+    it = m_Pipelines.emplace(hash, std::move(variant));
+  }
+
+  if (it->second.Pipeline == VK_NULL_HANDLE) {
+    return false;
+  }
+  vkCmdBindPipeline(context->Window.GetCurrentFrame()->CommandBuffer,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS, it->second.Pipeline);
+  return true;
+}
+
+void VulkanShader::BindResources() {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  VkCommandBuffer commandBuffer =
+      context->Window.GetCurrentFrame()->CommandBuffer;
+
+  // Blocks are only copied into the ring when they changed, draws in between
+  // share the copy. Copies of earlier frames may already be overwritten. A
+  // push that grows the ring moves every block into the new buffer.
+  VulkanUniformRing &ring = context->UniformRing;
+  bool pushed = false;
+  while (!pushed) {
+    pushed = true;
+    for (size_t i = 0; i < m_Interface.UniformBlocks.size(); i++) {
+      UniformBlock &block = m_Interface.UniformBlocks[i];
+      if (block.Dirty || block.Serial != context->FrameSerial ||
+          block.Generation != ring.GetGeneration()) {
+        const uint32_t generation = ring.GetGeneration();
+        block.Offset =
+            ring.Push(block.Data.data(), (uint32_t)block.Data.size());
+        block.Serial = context->FrameSerial;
+        block.Generation = ring.GetGeneration();
+        block.Dirty = false;
+        if (block.Generation != generation) {
+          pushed = false;
+          break;
+        }
+      }
+      m_Interface.DynamicOffsets[i] = block.Offset;
+    }
+  }
+  if (m_Interface.RingGeneration != ring.GetGeneration()) {
+    CreateDescriptorSets(&m_Interface);
+  }
+
+  if (!m_Interface.DescriptorSets.empty()) {
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            m_Interface.PipelineLayout, 0,
+                            (uint32_t)m_Interface.DescriptorSets.size(),
+                            m_Interface.DescriptorSets.data(),
+                            (uint32_t)m_Interface.DynamicOffsets.size(),
+                            m_Interface.DynamicOffsets.data());
+  }
+
+  const VkPushConstantRange &pushConstants = m_Interface.PushConstants;
+  if (pushConstants.stageFlags != 0) {
+    vkCmdPushConstants(commandBuffer, m_Interface.PipelineLayout,
+                       pushConstants.stageFlags, pushConstants.offset,
+                       pushConstants.size,
+                       m_Interface.PushConstantData.data() +
+                           pushConstants.offset);
+  }
+}
+
+void VulkanShader::SetData(const std::string &name, ShaderDataType type,
+                           const void *data, uint32_t count) {
+  auto it = m_Interface.Members.find(name);
+  if (it == m_Interface.Members.end()) {
+    if (m_MissingMembers.insert(name).second) {
+      ME_CORE_WARN("Shader {0} has no uniform named {1}", m_Name, name);
+    }
+    return;
+  }
+
+  const UniformMember &member = it->second;
+  uint8_t *block;
+  if (member.Block == PushConstantBlock) {
+    block = m_Interface.PushConstantData.data();
+  } else {
+    UniformBlock &uniformBlock = m_Interface.UniformBlocks[member.Block];
+    uniformBlock.Dirty = true;
+    block = uniformBlock.Data.data();
+  }
+
+  // Arrays are laid out with the stride of the block layout, std140 pads
+  // scalar elements to 16 bytes
+  const uint32_t size = ShaderDataTypeSize(type);
+  const uint32_t stride = member.ArrayStride != 0 ? member.ArrayStride : size;
+  const uint8_t *src = static_cast<const uint8_t *>(data);
+  for (uint32_t i = 0; i < count && i * stride < member.Size; i++) {
+    memcpy(block + member.Offset + i * stride, src + i * size,
+           std::min(size, member.Size - i * stride));
+  }
+}
+
+bool VulkanShader::UsesStage(const ShaderStage *stage) const {
+  for (const Ref<ShaderStage> &s : m_Stages) {
+    if (s.get() == stage) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void VulkanShader::Reload() {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+
+  // The shaderInterface may have changed with the new modules
+  ShaderInterface oldInterface = std::move(m_Interface);
+  m_Interface = CreateInterface();
+
+  // In the order of m_Pipelines. Variants that failed before may fail again
+  // without keeping the others from being reloaded.
+  std::vector<VkPipeline> pipelines;
+  for (auto &[hash, variant] : m_Pipelines) {
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkResult res = CreatePipeline(variant.Layouts, &pipeline);
+    if (res != VK_SUCCESS && variant.Pipeline != VK_NULL_HANDLE) {
+      ME_CORE_ERROR("Unable to recreate pipeline for shader {0}: {1}", m_Name,
+                    string_VkResult(res));
+      for (VkPipeline createdPipeline : pipelines) {
+        vkDestroyPipeline(context->LogicalDevice, createdPipeline,
+                          context->AllocationCallback);
+      }
+      m_Interface = std::move(oldInterface);
+      return;
+    }
+    pipelines.push_back(res == VK_SUCCESS ? pipeline : VK_NULL_HANDLE);
+  }
+
+  // Keep the values of members that still exist
+  for (auto &[name, member] : m_Interface.Members) {
+    auto it = oldInterface.Members.find(name);
+    if (it == oldInterface.Members.end() || it->second.Size != member.Size) {
+      continue;
+    }
+    const uint8_t *src =
+        it->second.Block == PushConstantBlock
+            ? oldInterface.PushConstantData.data()
+            : oldInterface.UniformBlocks[it->second.Block].Data.data();
+    uint8_t *dst = member.Block == PushConstantBlock
+                       ? m_Interface.PushConstantData.data()
+                       : m_Interface.UniformBlocks[member.Block].Data.data();
+    memcpy(dst + member.Offset, src + it->second.Offset, member.Size);
+  }
+
+  size_t index = 0;
+  for (auto &[hash, variant] : m_Pipelines) {
+    VkPipeline oldPipeline = variant.Pipeline;
+    context->Defer([context, oldPipeline]() {
+      vkDestroyPipeline(context->LogicalDevice, oldPipeline,
+                        context->AllocationCallback);
+    });
+    variant.Pipeline = pipelines[index++];
+  }
+  ME_CORE_INFO("Reloaded shader {0}", m_Name);
+}
+
+VulkanShader::ShaderInterface VulkanShader::CreateInterface() const {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  ShaderInterface shaderInterface;
+
+  // Merge the interfaces of all stages, resources used by several stages are
+  // visible to all of them. Uniform buffers are bound through the uniform
+  // ring with dynamic offsets.
+  std::map<std::pair<uint32_t, uint32_t>, VkDescriptorSetLayoutBinding>
+      bindings;
+  std::map<std::pair<uint32_t, uint32_t>, const VulkanDescriptorBinding *>
+      uniformBuffers;
+  VkPushConstantRange &pushConstants = shaderInterface.PushConstants;
+  uint32_t pushConstantsEnd = 0;
+
+  // Stages share push constants, the same member is added once per stage. A
+  // name declared by different blocks only finds the first of them, the
+  // others are set through their block name.
+  auto addMember = [&](const std::string &name, const UniformMember &member) {
+    auto [it, inserted] = shaderInterface.Members.try_emplace(name, member);
+    if (!inserted && (it->second.Block != member.Block ||
+                      it->second.Offset != member.Offset)) {
+      ME_CORE_ERROR("Shader {0} declares uniform {1} in more than one block, "
+                    "set it as <block>.{1}",
+                    m_Name, name);
+    }
+  };
+  for (const Ref<ShaderStage> &s : m_Stages) {
+    const VulkanShaderReflection &reflection =
+        static_cast<VulkanShaderStage *>(s.get())->GetReflection();
+
+    for (const VulkanDescriptorBinding &binding : reflection.Bindings) {
+      VkDescriptorType type = binding.Type;
+      const std::pair<uint32_t, uint32_t> key = {binding.Set, binding.Binding};
+      if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
+        type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        uniformBuffers.try_emplace(key, &binding);
+      }
+
+      auto [it, inserted] = bindings.try_emplace(key);
+      VkDescriptorSetLayoutBinding &layoutBinding = it->second;
+      if (inserted) {
+        layoutBinding.binding = binding.Binding;
+        layoutBinding.descriptorType = type;
+        layoutBinding.descriptorCount = binding.Count;
+        layoutBinding.stageFlags = 0;
+      }
+      ME_CORE_ASSERT(layoutBinding.descriptorType == type,
+                     "Shader stages disagree on a descriptor binding type!");
+      layoutBinding.stageFlags |= binding.Stages;
+    }
+
+    for (const VkPushConstantRange &range : reflection.PushConstants) {
+      if (pushConstants.stageFlags == 0) {
+        pushConstants.offset = range.offset;
+      }
+      pushConstants.offset = std::min(pushConstants.offset, range.offset);
+      pushConstantsEnd = std::max(pushConstantsEnd, range.offset + range.size);
+      pushConstants.stageFlags |= range.stageFlags;
+    }
+    for (const VulkanBlockMember &member : reflection.PushConstantMembers) {
+      addMember(member.Name, UniformMember{PushConstantBlock, member.Offset,
+                                           member.Size, member.ArrayStride});
+    }
+  }
+
+  // Sets without bindings in between used sets get an empty layout
+  std::vector<std::vector<VkDescriptorSetLayoutBinding>> sets;
+  for (auto &[key, binding] : bindings) {
+    if (sets.size() <= key.first) {
+      sets.resize(key.first + 1);
+    }
+    sets[key.first].push_back(binding);
+  }
+
+  // The bindless set is shared by every shader declaring it
+  std::vector<VkDescriptorSetLayout> &setLayouts = shaderInterface.SetLayouts;
+  for (size_t i = 0; i < sets.size(); i++) {
+    if (i == VulkanBindlessTable::Set && !sets[i].empty()) {
+      ME_CORE_ASSERT(context->Bindless.IsSupported(),
+                     "Shader uses bindless resources but the device doesn't "
+                     "support descriptor indexing!");
+      for (const VkDescriptorSetLayoutBinding &binding : sets[i]) {
+        ME_CORE_ASSERT(
+            (binding.binding == VulkanBindlessTable::TextureBinding &&
+             binding.descriptorType ==
+                 VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER) ||
+                (binding.binding == VulkanBindlessTable::BufferBinding &&
+                 binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+            "Shader binding doesn't match the bindless table!");
+      }
+      setLayouts.push_back(context->Bindless.GetSetLayout());
+      continue;
+    }
+    setLayouts.push_back(context->LayoutCache.GetDescriptorSetLayout(
+        context->LogicalDevice, context->AllocationCallback,
+        std::move(sets[i])));
+  }
+
+  std::vector<VkPushConstantRange> pushConstantRanges;
+  if (pushConstants.stageFlags != 0) {
+    pushConstants.size = pushConstantsEnd - pushConstants.offset;
+    pushConstantRanges.push_back(pushConstants);
+    shaderInterface.PushConstantData.resize(pushConstantsEnd);
+  }
+
+  shaderInterface.PipelineLayout = context->LayoutCache.GetPipelineLayout(
+      context->LogicalDevice, context->AllocationCallback, setLayouts,
+      pushConstantRanges);
+
+  for (auto &[key, binding] : uniformBuffers) {
+    ME_CORE_ASSERT(binding->Size <= context->UniformRing.GetMaxRange(),
+                   "Uniform block is larger than a uniform buffer range!");
+
+    const uint32_t blockIndex = (uint32_t)shaderInterface.UniformBlocks.size();
+    UniformBlock block;
+    block.Data.resize(binding->Size);
+    shaderInterface.UniformBlocks.push_back(std::move(block));
+    shaderInterface.UniformBindings.push_back(
+        {key.first, key.second, binding->Size});
+    for (const VulkanBlockMember &member : binding->Members) {
+      const UniformMember uniformMember{blockIndex, member.Offset, member.Size,
+                                        member.ArrayStride};
+      addMember(member.Name, uniformMember);
+      addMember(binding->Name + "." + member.Name, uniformMember);
+    }
+  }
+  shaderInterface.DynamicOffsets.resize(shaderInterface.UniformBlocks.size());
+
+  CreateDescriptorSets(&shaderInterface);
+  return shaderInterface;
+}
+
+void VulkanShader::CreateDescriptorSets(ShaderInterface *pInterface) const {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+
+  // The sets only ever point at the uniform ring, so shaders with the same
+  // set layouts share their persistent sets
+  const std::vector<VkDescriptorSetLayout> &setLayouts = pInterface->SetLayouts;
+  std::vector<VulkanDescriptorWriter> writers(setLayouts.size());
+  for (const UniformBinding &binding : pInterface->UniformBindings) {
+    writers[binding.Set].WriteBuffer(
+        binding.Binding, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+        context->UniformRing.GetBuffer(), 0, (VkDeviceSize)binding.Size);
+  }
+
+  pInterface->DescriptorSets.clear();
+  for (size_t i = 0; i < setLayouts.size(); i++) {
+    if (setLayouts[i] == context->Bindless.GetSetLayout()) {
+      pInterface->DescriptorSets.push_back(context->Bindless.GetSet());
+      continue;
+    }
+    pInterface->DescriptorSets.push_back(
+        context->DescriptorAllocator.GetPersistentSet(setLayouts[i],
+                                                      writers[i]));
+  }
+  pInterface->RingGeneration = context->UniformRing.GetGeneration();
+}
+
+VkResult VulkanShader::CreatePipeline(const std::vector<BufferLayout> &layouts,
+                                      VkPipeline *pPipeline) const {
   VulkanContext *context =
       Application::Get().GetGraphicsContext<VulkanContext>();
 
   VkPipelineShaderStageCreateInfo shaderStages[m_Stages.size()];
+  const VulkanShaderReflection *vertexReflection = nullptr;
   for (int i = 0; i < m_Stages.size(); i++) {
     VulkanShaderStage *stage =
-        static_cast<VulkanShaderStage *>(stages[i].get());
-    if (stage == nullptr) {
-      ME_CORE_ASSERT(false, "Shader module is null!");
+        static_cast<VulkanShaderStage *>(m_Stages[i].get());
+    if (stage == nullptr || stage->GetShaderModule() == VK_NULL_HANDLE) {
+      ME_CORE_ERROR("Shader {0} has a stage that failed to compile", m_Name);
+      return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    shaderStages[i] = stage->GetStageInfo();
+    if (stage->GetType() == ShaderStage::Vertex) {
+      vertexReflection = &stage->GetReflection();
+    }
+  }
+  ME_CORE_ASSERT(vertexReflection != nullptr, "Shader has no vertex stage!");
+
+  // One binding per vertex buffer
+  std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+  for (uint32_t i = 0; i < layouts.size(); i++) {
+    VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding = i;
+    bindingDescription.stride = layouts[i].GetStride();
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    bindingDescriptions.push_back(bindingDescription);
+  }
+
+  // Inputs are matched to layout elements by name across all buffers. An
+  // input without an element of its name is an error, guessing by position
+  // silently feeds it the wrong data.
+  std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+  for (const VulkanStageInput &input : vertexReflection->Inputs) {
+    const BufferElement *match = nullptr;
+    uint32_t matchBinding = 0;
+    for (uint32_t binding = 0; binding < layouts.size() && match == nullptr;
+         binding++) {
+      for (const BufferElement &element : layouts[binding]) {
+        if (element.Name == input.Name) {
+          match = &element;
+          matchBinding = binding;
+          break;
+        }
+      }
+    }
+
+    if (match == nullptr) {
+      ME_CORE_ERROR("Shader {0} input {1} has no vertex attribute of that name",
+                    m_Name, input.Name);
+      return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    const uint32_t columns = GetColumnCount(match->Type);
+    if (columns != input.Columns) {
+      ME_CORE_ERROR("Shader {0} input {1} does not match the type of vertex "
+                    "attribute {2}",
+                    m_Name, input.Name, match->Name);
+      return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    for (uint32_t column = 0; column < columns; column++) {
+      VkVertexInputAttributeDescription attribute{};
+      attribute.binding = matchBinding;
+      attribute.location = input.Location + column;
+      attribute.format =
+          ToVulkanFormat(match->Type, match->Normalized);
+      attribute.offset =
+          (uint32_t)match->Offset + column * (match->Size / columns);
+      attributeDescriptions.push_back(attribute);
     }
-    VkPipelineShaderStageCreateInfo info = stage->GetStageInfo();
-    shaderStages[i] = info;
   }
 
   VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
   vertexInputInfo.sType =
       VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-
-  VkVertexInputBindingDescription bindingDescription{};
-  bindingDescription.binding = 0;
-  bindingDescription.stride = sizeof(Vertex);
-  bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-  std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
-
-  // Position
-  attributeDescriptions[0].binding = 0;
-  attributeDescriptions[0].location = 0;
-  attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
-  attributeDescriptions[0].offset = offsetof(Vertex, Position);
-  // Color
-  attributeDescriptions[1].binding = 0;
-  attributeDescriptions[1].location = 1;
-  attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-  attributeDescriptions[1].offset = offsetof(Vertex, Color);
-
-  vertexInputInfo.vertexBindingDescriptionCount = 1;
+  vertexInputInfo.vertexBindingDescriptionCount =
+      static_cast<uint32_t>(bindingDescriptions.size());
   vertexInputInfo.vertexAttributeDescriptionCount =
       static_cast<uint32_t>(attributeDescriptions.size());
-  vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+  vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
   vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
   VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
@@ -88,7 +557,7 @@ VulkanShader::VulkanShader(const std::string &name,
   rasterState.polygonMode = VK_POLYGON_MODE_FILL;
   rasterState.lineWidth = 1.0f;
   rasterState.cullMode = VK_CULL_MODE_BACK_BIT;
-  rasterState.frontFace = VK_FRONT_FACE_CLOCKWISE;
+  rasterState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
   rasterState.depthBiasEnable = VK_FALSE;
 
   VkPipelineMultisampleStateCreateInfo multisampling{};
@@ -115,16 +584,6 @@ VulkanShader::VulkanShader(const std::string &name,
   colorBlending.blendConstants[2] = 0.0f;
   colorBlending.blendConstants[3] = 0.0f;
 
-  VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-  pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-  pipelineLayoutInfo.setLayoutCount = 0;
-  pipelineLayoutInfo.pushConstantRangeCount = 0;
-
-  VkResult res =
-      vkCreatePipelineLayout(context->LogicalDevice, &pipelineLayoutInfo,
-                             context->AllocationCallback, &m_PipelineLayout);
-  ME_CORE_ASSERT(res == VK_SUCCESS, "Could not create pipeline layout!");
-
   VkGraphicsPipelineCreateInfo pipelineInfo{};
   pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
   pipelineInfo.stageCount = m_Stages.size();
@@ -135,48 +594,14 @@ VulkanShader::VulkanShader(const std::string &name,
   pipelineInfo.pRasterizationState = &rasterState;
   pipelineInfo.pMultisampleState = &multisampling;
   pipelineInfo.pColorBlendState = &colorBlending;
-  pipelineInfo.layout = m_PipelineLayout;
+  pipelineInfo.layout = m_Interface.PipelineLayout;
   pipelineInfo.renderPass = context->Window.RenderPass;
   pipelineInfo.subpass = 0;
   pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-  res = vkCreateGraphicsPipelines(context->LogicalDevice, VK_NULL_HANDLE, 1,
-                                  &pipelineInfo, context->AllocationCallback,
-                                  &m_ShaderPipeline);
-  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create shader pipeline!");
-}
-
-VulkanShader::~VulkanShader() {
-  VulkanContext *context =
-      Application::Get().GetGraphicsContext<VulkanContext>();
-
-  // TODO: Maybe move to the module so that its responsible for both creation
-  // and deletion
-  for (int i = 0; i < m_Stages.size(); i++) {
-    vkDestroyShaderModule(
-        context->LogicalDevice,
-        static_cast<VulkanShaderStage *>(m_Stages[i].get())->GetShaderModule(),
-        nullptr);
-  }
-
-  vkDestroyPipelineLayout(context->LogicalDevice, m_PipelineLayout,
-                          context->AllocationCallback);
-  vkDestroyPipeline(context->LogicalDevice, m_ShaderPipeline,
-                    context->AllocationCallback);
-}
-
-void VulkanShader::Bind() {
-  VulkanContext *context =
-      Application::Get().GetGraphicsContext<VulkanContext>();
-  vkCmdBindPipeline(context->Window.GetCurrentFrame()->CommandBuffer,
-                    VK_PIPELINE_BIND_POINT_GRAPHICS, m_ShaderPipeline);
+  return vkCreateGraphicsPipelines(context->LogicalDevice, VK_NULL_HANDLE, 1,
+                                   &pipelineInfo, context->AllocationCallback,
+                                   pPipeline);
 }
 
-/* void SetInt(const std::string &name, int value) {}
-void SetIntArray(const std::string &name, int *value, uint32_t count) {}
-void SetFloat(const std::string &name, float value) {}
-void SetFloat2(const std::string &name, const Vector2 &value) {}
-void SetFloat3(const std::string &name, const Vector3 &value) {}
-void SetFloat4(const std::string &name, const Vector4 &value) {}
-void SetMat4(const std::string &name, const Matrix4 &value) {} */
 } // namespace MyEngine
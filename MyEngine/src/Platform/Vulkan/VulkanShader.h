@@ -2,8 +2,10 @@
 
 #include "MyEngine/Core/Base.h"
 #include "MyEngine/Math/Math.h"
+#include "MyEngine/Renderer/Buffer.h"
 #include "MyEngine/Renderer/Shader.h"
 #include "MyEngine/Renderer/ShaderStage.h"
+#include <unordered_set>
 #include <vulkan/vulkan_core.h>
 
 namespace MyEngine {
@@ -14,23 +16,98 @@ public:
   virtual ~VulkanShader() override;
   virtual void Bind() override;
 
-  /* virtual void SetInt(const std::string &name, int value) override;
-  virtual void SetIntArray(const std::string &name, int *value,
-                           uint32_t count) override;
-  virtual void SetFloat(const std::string &name, float value) override;
-  virtual void SetFloat2(const std::string &name,
-                         const Vector2 &value) override;
-  virtual void SetFloat3(const std::string &name,
-                         const Vector3 &value) override;
-  virtual void SetFloat4(const std::string &name,
-                         const Vector4 &value) override;
-  virtual void SetMat4(const std::string &name, const Matrix4 &value) override;
-*/
+  // The vertex input state is derived from the reflected stage inputs and the
+  // layouts of the vertex buffers, so a pipeline is created the first time the
+  // shader is drawn with a new combination of layouts. Returns false when the
+  // pipeline can't be created, the draw has to be skipped then.
+  bool BindPipeline(const std::vector<Ref<VertexBuffer>> &vertexBuffers);
+  // Uploads changed uniform blocks into the uniform ring, binds them with
+  // their dynamic offsets and pushes the push constants
+  void BindResources();
+
+  VkPipelineLayout GetPipelineLayout() const {
+    return m_Interface.PipelineLayout;
+  }
+
+  bool UsesStage(const ShaderStage *stage) const;
+  // Rebuilds the pipelines from the current stage modules, the old pipelines
+  // are destroyed once the frames using them finished. Keeps the old pipelines
+  // when the new ones can't be created.
+  void Reload();
+
+  // The shader of the last Bind call, the pipeline is bound at draw time
+  static VulkanShader *GetBound() { return s_BoundShader; }
 
 private:
+  struct PipelineVariant {
+    std::vector<BufferLayout> Layouts;
+    VkPipeline Pipeline;
+  };
+
+  // CPU copy of a uniform block and where it was last written in the ring
+  struct UniformBlock {
+    std::vector<uint8_t> Data;
+    bool Dirty = true;
+    uint32_t Offset = 0;
+    uint64_t Serial = 0;
+    uint32_t Generation = 0;
+  };
+
+  struct UniformBinding {
+    uint32_t Set;
+    uint32_t Binding;
+    uint32_t Size;
+  };
+
+  static constexpr uint32_t PushConstantBlock = UINT32_MAX;
+
+  struct UniformMember {
+    // Index into UniformBlocks or PushConstantBlock
+    uint32_t Block;
+    uint32_t Offset;
+    uint32_t Size;
+    uint32_t ArrayStride;
+  };
+
+  // Everything derived from the reflection of the stages, rebuilt on reload
+  struct ShaderInterface {
+    // Owned by the layout cache of the context
+    VkPipelineLayout PipelineLayout = VK_NULL_HANDLE;
+    // Owned by the layout cache of the context or the bindless table
+    std::vector<VkDescriptorSetLayout> SetLayouts;
+    // Owned by the descriptor allocator of the context, written for the
+    // buffer of RingGeneration
+    std::vector<VkDescriptorSet> DescriptorSets;
+    uint32_t RingGeneration = 0;
+    // Uniform blocks bound through the uniform ring, in block order
+    std::vector<UniformBinding> UniformBindings;
+    // Ordered by set and binding like the dynamic offsets
+    std::vector<UniformBlock> UniformBlocks;
+    std::vector<uint32_t> DynamicOffsets;
+    VkPushConstantRange PushConstants{};
+    std::vector<uint8_t> PushConstantData;
+    // Keyed by member name and by block name followed by a dot and the member
+    // name
+    std::unordered_map<std::string, UniformMember> Members;
+  };
+
+  ShaderInterface CreateInterface() const;
+  // Points the uniform bindings at the current buffer of the uniform ring
+  void CreateDescriptorSets(ShaderInterface *pInterface) const;
+  VkResult CreatePipeline(const std::vector<BufferLayout> &layouts,
+                          VkPipeline *pPipeline) const;
+  virtual void SetData(const std::string &name, ShaderDataType type,
+                       const void *data, uint32_t count) override;
+
   std::string m_Name;
   std::vector<Ref<ShaderStage>> m_Stages;
-  VkPipeline m_ShaderPipeline;
-  VkPipelineLayout m_PipelineLayout;
+  ShaderInterface m_Interface;
+  // Keyed by a hash of the vertex buffer layouts, variants with the same hash
+  // are told apart by their layouts. Pipelines that failed are null.
+  std::unordered_multimap<uint64_t, PipelineVariant> m_Pipelines;
+  // Names that were set but don't exist, only reported once
+  std::unordered_set<std::string> m_MissingMembers;
+
+  static VulkanShader *s_BoundShader;
 };
 } // namespace MyEngine
@@ -0,0 +1,308 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanShaderReflection.h"
+
+#include <cstring>
+#include <spirv_cross/spirv_cross.hpp>
+
+namespace MyEngine {
+static VkFormat GetInputFormat(const spirv_cross::SPIRType &type) {
+  static constexpr VkFormat s_FloatFormats[] = {
+      VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT,
+      VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+  static constexpr VkFormat s_IntFormats[] = {
+      VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT,
+      VK_FORMAT_R32G32B32A32_SINT};
+  static constexpr VkFormat s_UIntFormats[] = {
+      VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT,
+      VK_FORMAT_R32G32B32A32_UINT};
+
+  if (type.vecsize < 1 || type.vecsize > 4) {
+    return VK_FORMAT_UNDEFINED;
+  }
+
+  switch (type.basetype) {
+  case spirv_cross::SPIRType::Float:
+    return s_FloatFormats[type.vecsize - 1];
+  case spirv_cross::SPIRType::Int:
+    return s_IntFormats[type.vecsize - 1];
+  case spirv_cross::SPIRType::UInt:
+    return s_UIntFormats[type.vecsize - 1];
+  default:
+    return VK_FORMAT_UNDEFINED;
+  }
+}
+
+static std::vector<VulkanBlockMember>
+GetBlockMembers(const spirv_cross::Compiler &compiler,
+                const spirv_cross::SPIRType &blockType) {
+  std::vector<VulkanBlockMember> members;
+  for (uint32_t i = 0; i < (uint32_t)blockType.member_types.size(); i++) {
+    const spirv_cross::SPIRType &memberType =
+        compiler.get_type(blockType.member_types[i]);
+
+    VulkanBlockMember member;
+    member.Name = compiler.get_member_name(blockType.self, i);
+    member.Offset = compiler.type_struct_member_offset(blockType, i);
+    member.Size =
+        (uint32_t)compiler.get_declared_struct_member_size(blockType, i);
+    member.ArrayStride =
+        memberType.array.empty()
+            ? 0
+            : compiler.type_struct_member_array_stride(blockType, i);
+    members.push_back(member);
+  }
+  return members;
+}
+
+static void
+AddBindings(const spirv_cross::Compiler &compiler,
+            const spirv_cross::SmallVector<spirv_cross::Resource> &resources,
+            VkDescriptorType type, VkShaderStageFlagBits stage,
+            std::vector<VulkanDescriptorBinding> *pBindings) {
+  for (const spirv_cross::Resource &resource : resources) {
+    const spirv_cross::SPIRType &resourceType =
+        compiler.get_type(resource.type_id);
+
+    VulkanDescriptorBinding binding;
+    binding.Name = resource.name;
+    binding.Set =
+        compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
+    binding.Binding =
+        compiler.get_decoration(resource.id, spv::DecorationBinding);
+    binding.Type = type;
+    binding.Count = resourceType.array.empty() ? 1 : resourceType.array[0];
+    binding.Size = 0;
+    if (type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER ||
+        type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+      const spirv_cross::SPIRType &baseType =
+          compiler.get_type(resource.base_type_id);
+      binding.Size = (uint32_t)compiler.get_declared_struct_size(baseType);
+      binding.Members = GetBlockMembers(compiler, baseType);
+    }
+    binding.Stages = stage;
+    pBindings->push_back(binding);
+  }
+}
+
+VulkanShaderReflection
+VulkanShaderReflection::Reflect(const std::vector<uint32_t> &spirv,
+                                VkShaderStageFlagBits stage) {
+  VulkanShaderReflection reflection;
+
+  spirv_cross::Compiler compiler(spirv);
+  spirv_cross::ShaderResources resources = compiler.get_shader_resources();
+
+  if (stage == VK_SHADER_STAGE_VERTEX_BIT) {
+    for (const spirv_cross::Resource &resource : resources.stage_inputs) {
+      const spirv_cross::SPIRType &type = compiler.get_type(resource.type_id);
+
+      VulkanStageInput input;
+      input.Name = resource.name;
+      input.Location =
+          compiler.get_decoration(resource.id, spv::DecorationLocation);
+      input.Format = GetInputFormat(type);
+      input.Columns = type.columns;
+      reflection.Inputs.push_back(input);
+    }
+    std::sort(reflection.Inputs.begin(), reflection.Inputs.end(),
+              [](const VulkanStageInput &a, const VulkanStageInput &b) {
+                return a.Location < b.Location;
+              });
+  }
+
+  AddBindings(compiler, resources.uniform_buffers,
+              VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, stage, &reflection.Bindings);
+  AddBindings(compiler, resources.storage_buffers,
+              VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stage, &reflection.Bindings);
+  AddBindings(compiler, resources.sampled_images,
+              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, stage,
+              &reflection.Bindings);
+  AddBindings(compiler, resources.separate_images,
+              VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, stage, &reflection.Bindings);
+  AddBindings(compiler, resources.separate_samplers,
+              VK_DESCRIPTOR_TYPE_SAMPLER, stage, &reflection.Bindings);
+  AddBindings(compiler, resources.storage_images,
+              VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, stage, &reflection.Bindings);
+
+  for (const spirv_cross::Resource &resource :
+       resources.push_constant_buffers) {
+    // Only the members the stage actually reads are part of its range
+    spirv_cross::SmallVector<spirv_cross::BufferRange> ranges =
+        compiler.get_active_buffer_ranges(resource.id);
+    if (ranges.empty()) {
+      continue;
+    }
+
+    size_t begin = ranges[0].offset;
+    size_t end = 0;
+    for (const spirv_cross::BufferRange &range : ranges) {
+      begin = std::min(begin, range.offset);
+      end = std::max(end, range.offset + range.range);
+    }
+    reflection.PushConstants.push_back(
+        {(VkShaderStageFlags)stage, (uint32_t)begin, (uint32_t)(end - begin)});
+    reflection.PushConstantMembers = GetBlockMembers(
+        compiler, compiler.get_type(resource.base_type_id));
+  }
+
+  return reflection;
+}
+
+// The serialized form is only read back by the same build through the shader
+// cache, so values are stored in native byte order
+class ReflectionWriter {
+public:
+  explicit ReflectionWriter(std::vector<uint8_t> *pData) : m_Data(pData) {}
+
+  void Write(uint32_t value) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    m_Data->insert(m_Data->end(), bytes, bytes + sizeof(value));
+  }
+
+  void Write(const std::string &value) {
+    Write((uint32_t)value.size());
+    m_Data->insert(m_Data->end(), value.begin(), value.end());
+  }
+
+  void Write(const std::vector<VulkanBlockMember> &members) {
+    Write((uint32_t)members.size());
+    for (const VulkanBlockMember &member : members) {
+      Write(member.Name);
+      Write(member.Offset);
+      Write(member.Size);
+      Write(member.ArrayStride);
+    }
+  }
+
+private:
+  std::vector<uint8_t> *m_Data;
+};
+
+class ReflectionReader {
+public:
+  ReflectionReader(const uint8_t *data, size_t size)
+      : m_Data(data), m_Size(size) {}
+
+  bool Read(uint32_t *pValue) {
+    if (m_Size - m_Offset < sizeof(uint32_t)) {
+      return false;
+    }
+    memcpy(pValue, m_Data + m_Offset, sizeof(uint32_t));
+    m_Offset += sizeof(uint32_t);
+    return true;
+  }
+
+  bool Read(std::string *pValue) {
+    uint32_t size;
+    if (!Read(&size) || m_Size - m_Offset < size) {
+      return false;
+    }
+    pValue->assign((const char *)m_Data + m_Offset, size);
+    m_Offset += size;
+    return true;
+  }
+
+  bool Read(std::vector<VulkanBlockMember> *pMembers) {
+    uint32_t count;
+    if (!Read(&count)) {
+      return false;
+    }
+    pMembers->resize(count);
+    for (VulkanBlockMember &member : *pMembers) {
+      if (!Read(&member.Name) || !Read(&member.Offset) ||
+          !Read(&member.Size) || !Read(&member.ArrayStride)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool IsAtEnd() const { return m_Offset == m_Size; }
+
+private:
+  const uint8_t *m_Data;
+  size_t m_Size;
+  size_t m_Offset = 0;
+};
+
+void VulkanShaderReflection::Serialize(std::vector<uint8_t> *pData) const {
+  ReflectionWriter writer(pData);
+
+  writer.Write((uint32_t)Inputs.size());
+  for (const VulkanStageInput &input : Inputs) {
+    writer.Write(input.Name);
+    writer.Write(input.Location);
+    writer.Write((uint32_t)input.Format);
+    writer.Write(input.Columns);
+  }
+
+  writer.Write((uint32_t)Bindings.size());
+  for (const VulkanDescriptorBinding &binding : Bindings) {
+    writer.Write(binding.Name);
+    writer.Write(binding.Set);
+    writer.Write(binding.Binding);
+    writer.Write((uint32_t)binding.Type);
+    writer.Write(binding.Count);
+    writer.Write(binding.Size);
+    writer.Write(binding.Stages);
+    writer.Write(binding.Members);
+  }
+
+  writer.Write((uint32_t)PushConstants.size());
+  for (const VkPushConstantRange &range : PushConstants) {
+    writer.Write(range.stageFlags);
+    writer.Write(range.offset);
+    writer.Write(range.size);
+  }
+  writer.Write(PushConstantMembers);
+}
+
+bool VulkanShaderReflection::Deserialize(const uint8_t *data, size_t size) {
+  ReflectionReader reader(data, size);
+  uint32_t count, value;
+
+  if (!reader.Read(&count)) {
+    return false;
+  }
+  Inputs.resize(count);
+  for (VulkanStageInput &input : Inputs) {
+    if (!reader.Read(&input.Name) || !reader.Read(&input.Location) ||
+        !reader.Read(&value) || !reader.Read(&input.Columns)) {
+      return false;
+    }
+    input.Format = (VkFormat)value;
+  }
+
+  if (!reader.Read(&count)) {
+    return false;
+  }
+  Bindings.resize(count);
+  for (VulkanDescriptorBinding &binding : Bindings) {
+    if (!reader.Read(&binding.Name) || !reader.Read(&binding.Set) ||
+        !reader.Read(&binding.Binding) || !reader.Read(&value) ||
+        !reader.Read(&binding.Count) || !reader.Read(&binding.Size) ||
+        !reader.Read(&binding.Stages) || !reader.Read(&binding.Members)) {
+      return false;
+    }
+    binding.Type = (VkDescriptorType)value;
+  }
+
+  if (!reader.Read(&count)) {
+    return false;
+  }
+  PushConstants.resize(count);
+  for (VkPushConstantRange &range : PushConstants) {
+    if (!reader.Read(&range.stageFlags) || !reader.Read(&range.offset) ||
+        !reader.Read(&range.size)) {
+      return false;
+    }
+  }
+
+  if (!reader.Read(&PushConstantMembers)) {
+    return false;
+  }
+
+  return reader.IsAtEnd();
+}
+} // namespace MyEngine
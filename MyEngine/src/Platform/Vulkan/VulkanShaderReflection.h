@@ -0,0 +1,54 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+struct VulkanStageInput {
+  std::string Name;
+  uint32_t Location;
+  // Format of a single column, matrices take Columns consecutive locations
+  VkFormat Format;
+  uint32_t Columns;
+};
+
+// Member of a uniform block or push constant block, offsets are relative to
+// the start of the block
+struct VulkanBlockMember {
+  std::string Name;
+  uint32_t Offset;
+  uint32_t Size;
+  // Distance between array elements, 0 for members that are not arrays
+  uint32_t ArrayStride;
+};
+
+struct VulkanDescriptorBinding {
+  std::string Name;
+  uint32_t Set;
+  uint32_t Binding;
+  VkDescriptorType Type;
+  // 0 for runtime sized arrays
+  uint32_t Count;
+  // Declared size of uniform and storage blocks
+  uint32_t Size;
+  VkShaderStageFlags Stages;
+  std::vector<VulkanBlockMember> Members;
+};
+
+// Interface of a shader stage read from its SPIR-V. Reflected once at compile
+// time and stored in the shader cache next to the SPIR-V.
+struct VulkanShaderReflection {
+  std::vector<VulkanStageInput> Inputs;
+  std::vector<VulkanDescriptorBinding> Bindings;
+  std::vector<VkPushConstantRange> PushConstants;
+  std::vector<VulkanBlockMember> PushConstantMembers;
+
+  static VulkanShaderReflection Reflect(const std::vector<uint32_t> &spirv,
+                                        VkShaderStageFlagBits stage);
+
+  void Serialize(std::vector<uint8_t> *pData) const;
+  // Returns false if the data is truncated or malformed
+  bool Deserialize(const uint8_t *data, size_t size);
+};
+} // namespace MyEngine
@@ -0,0 +1,163 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Application.h"
+#include "MyEngine/Core/FileWatcher.h"
+#include "MyEngine/Core/ThreadPool.h"
+
+#include "Platform/Vulkan/VulkanShader.h"
+#include "Platform/Vulkan/VulkanShaderReloader.h"
+#include "Platform/Vulkan/VulkanShaderStage.h"
+
+#include <future>
+#include <unordered_set>
+
+namespace MyEngine {
+struct ShaderReloaderData {
+  FileWatcher Watcher;
+
+  std::unordered_set<VulkanShader *> Shaders;
+  // Normalized path of a source or include to the stages depending on it
+  std::unordered_map<std::string, std::unordered_set<VulkanShaderStage *>>
+      Dependents;
+  std::unordered_map<VulkanShaderStage *,
+                     std::future<VulkanShaderStage::CompileResult>>
+      PendingCompiles;
+};
+
+static Unique<ShaderReloaderData> s_Data;
+
+static void WatchStage(VulkanShaderStage *stage) {
+  s_Data->Watcher.Watch(stage->GetFilepath());
+  s_Data->Dependents[FileWatcher::Normalize(stage->GetFilepath())].insert(
+      stage);
+
+  for (const std::string &dependency : stage->GetDependencies()) {
+    s_Data->Watcher.Watch(dependency);
+    s_Data->Dependents[FileWatcher::Normalize(dependency)].insert(stage);
+  }
+}
+
+static void UnwatchStage(VulkanShaderStage *stage) {
+  for (auto &[path, stages] : s_Data->Dependents) {
+    stages.erase(stage);
+  }
+}
+
+void VulkanShaderReloader::Init() {
+  const ApplicationCommandLineArgs &args =
+      Application::Get().GetSpecification().CommandLineArgs;
+#ifdef ME_DEBUG
+  bool enabled = !args.HasFlag("no-shader-hot-reload");
+#else
+  bool enabled = args.HasFlag("shader-hot-reload");
+#endif
+  if (!enabled) {
+    return;
+  }
+
+  s_Data = CreateUnique<ShaderReloaderData>();
+  ME_CORE_INFO("Shader hot reload enabled");
+}
+
+void VulkanShaderReloader::Shutdown() {
+  // Results of compiles that are still running are dropped
+  s_Data.reset();
+}
+
+bool VulkanShaderReloader::IsEnabled() { return s_Data != nullptr; }
+
+void VulkanShaderReloader::Update() {
+  if (s_Data == nullptr) {
+    return;
+  }
+
+  for (const std::string &path : s_Data->Watcher.Poll()) {
+    auto it = s_Data->Dependents.find(path);
+    if (it == s_Data->Dependents.end()) {
+      continue;
+    }
+
+    for (VulkanShaderStage *stage : it->second) {
+      ME_CORE_INFO("Recompiling shader stage {0}", stage->GetFilepath());
+      // A newer compile replaces one that is still running
+      std::string filepath = stage->GetFilepath();
+      ShaderStage::StageType type = stage->GetType();
+      s_Data->PendingCompiles[stage] =
+          ThreadPool::Get().Submit([filepath, type]() {
+            return VulkanShaderStage::CompileOrLoadFromCache(filepath, type);
+          });
+    }
+  }
+
+  std::vector<VulkanShaderStage *> reloaded;
+  for (auto it = s_Data->PendingCompiles.begin();
+       it != s_Data->PendingCompiles.end();) {
+    if (it->second.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      ++it;
+      continue;
+    }
+
+    VulkanShaderStage *stage = it->first;
+    VulkanShaderStage::CompileResult result = it->second.get();
+    it = s_Data->PendingCompiles.erase(it);
+    if (!result.Success) {
+      ME_CORE_ERROR("Keeping the previous version of shader stage {0}",
+                    stage->GetFilepath());
+      continue;
+    }
+
+    // Includes may have been added or removed
+    UnwatchStage(stage);
+    stage->Reload(std::move(result));
+    WatchStage(stage);
+    reloaded.push_back(stage);
+  }
+
+  if (reloaded.empty()) {
+    return;
+  }
+
+  for (VulkanShader *shader : s_Data->Shaders) {
+    for (VulkanShaderStage *stage : reloaded) {
+      if (shader->UsesStage(stage)) {
+        shader->Reload();
+        break;
+      }
+    }
+  }
+}
+
+void VulkanShaderReloader::RegisterStage(VulkanShaderStage *stage) {
+  if (s_Data == nullptr) {
+    return;
+  }
+
+  WatchStage(stage);
+}
+
+void VulkanShaderReloader::UnregisterStage(VulkanShaderStage *stage) {
+  if (s_Data == nullptr) {
+    return;
+  }
+
+  s_Data->PendingCompiles.erase(stage);
+  UnwatchStage(stage);
+}
+
+void VulkanShaderReloader::RegisterShader(VulkanShader *shader) {
+  if (s_Data == nullptr) {
+    return;
+  }
+
+  s_Data->Shaders.insert(shader);
+}
+
+void VulkanShaderReloader::UnregisterShader(VulkanShader *shader) {
+  if (s_Data == nullptr) {
+    return;
+  }
+
+  s_Data->Shaders.erase(shader);
+}
+} // namespace MyEngine
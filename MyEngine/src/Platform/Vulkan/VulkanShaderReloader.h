@@ -0,0 +1,30 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+namespace MyEngine {
+class VulkanShader;
+class VulkanShaderStage;
+
+// Watches the source files and includes of every live shader stage, recompiles
+// changed stages on the thread pool and swaps the new modules and pipelines in
+// at the start of a frame. Enabled by default in debug builds, pass
+// --shader-hot-reload to enable it in release builds and
+// --no-shader-hot-reload to disable it.
+class VulkanShaderReloader {
+public:
+  static void Init();
+  static void Shutdown();
+
+  static bool IsEnabled();
+
+  // Never blocks, compiles that are still running are picked up by a later
+  // frame. Failed compiles keep the previous version.
+  static void Update();
+
+  static void RegisterStage(VulkanShaderStage *stage);
+  static void UnregisterStage(VulkanShaderStage *stage);
+  static void RegisterShader(VulkanShader *shader);
+  static void UnregisterShader(VulkanShader *shader);
+};
+} // namespace MyEngine
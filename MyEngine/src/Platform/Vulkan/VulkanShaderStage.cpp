@@ -1,19 +1,99 @@
 #include "mepch.h"
 
 #include "MyEngine/Core/Application.h"
+#include "MyEngine/Core/FileWatcher.h"
+#include "MyEngine/Core/Hash.h"
+#include "MyEngine/Core/ThreadPool.h"
 #include "MyEngine/Filesystem/Filesystem.h"
 
 #include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanShaderReloader.h"
 #include "Platform/Vulkan/VulkanShaderStage.h"
 
+#include <cstring>
+#include <filesystem>
 #include <shaderc/shaderc.hpp>
-#include <spirv_cross/spirv_cross.hpp>
 
 namespace MyEngine {
 VulkanShaderStage::VulkanShaderStage(const std::string &filepath,
-                                     ShaderStage::StageType type) {
-  CompileOrLoadFromCache(filepath, type);
+                                     ShaderStage::StageType type)
+    : VulkanShaderStage(filepath, type,
+                        CompileOrLoadFromCache(filepath, type)) {}
 
+VulkanShaderStage::VulkanShaderStage(const std::string &filepath,
+                                     ShaderStage::StageType type,
+                                     CompileResult &&result)
+    : m_Type(type), m_Filepath(filepath), m_SPIRV(std::move(result.SPIRV)),
+      m_Dependencies(std::move(result.Dependencies)),
+      m_Reflection(std::move(result.Reflection)) {
+  // Registered either way, so fixing the source reloads the stage
+  VulkanShaderReloader::RegisterStage(this);
+  if (!result.Success) {
+    ME_CORE_ERROR("Unable to compile shader stage {0}, shaders using it "
+                  "don't draw",
+                  filepath);
+    m_ShaderModule = VK_NULL_HANDLE;
+    return;
+  }
+  CreateModule();
+}
+
+VulkanShaderStage::~VulkanShaderStage() {
+  VulkanShaderReloader::UnregisterStage(this);
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  vkDestroyShaderModule(context->LogicalDevice, m_ShaderModule,
+                        context->AllocationCallback);
+}
+
+std::vector<Ref<ShaderStage>>
+VulkanShaderStage::CreateBatch(const std::vector<Source> &sources) {
+  std::vector<CompileResult> results(sources.size());
+  ThreadPool::Get().ParallelFor(
+      (uint32_t)sources.size(), [&sources, &results](uint32_t i) {
+        results[i] =
+            CompileOrLoadFromCache(sources[i].Filepath, sources[i].Type);
+      });
+
+  std::vector<Ref<ShaderStage>> stages;
+  stages.reserve(sources.size());
+  for (size_t i = 0; i < sources.size(); i++) {
+    stages.push_back(CreateRef<VulkanShaderStage>(
+        sources[i].Filepath, sources[i].Type, std::move(results[i])));
+  }
+
+  return stages;
+}
+
+void VulkanShaderStage::Reload(CompileResult &&result) {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  VkShaderModule oldModule = m_ShaderModule;
+  context->Defer([context, oldModule]() {
+    vkDestroyShaderModule(context->LogicalDevice, oldModule,
+                          context->AllocationCallback);
+  });
+
+  m_SPIRV = std::move(result.SPIRV);
+  m_Dependencies = std::move(result.Dependencies);
+  m_Reflection = std::move(result.Reflection);
+  CreateModule();
+}
+
+static VkShaderStageFlagBits StageTypeToVulkan(ShaderStage::StageType type) {
+  switch (type) {
+  case ShaderStage::Vertex:
+    return VK_SHADER_STAGE_VERTEX_BIT;
+  case ShaderStage::Fragment:
+    return VK_SHADER_STAGE_FRAGMENT_BIT;
+  }
+
+  ME_CORE_ASSERT(false);
+  return (VkShaderStageFlagBits)0;
+}
+
+void VulkanShaderStage::CreateModule() {
   VkShaderModuleCreateInfo shaderCreateInfo{};
   shaderCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
   shaderCreateInfo.codeSize = m_SPIRV.size() * sizeof(uint32_t);
@@ -29,19 +109,9 @@ VulkanShaderStage::VulkanShaderStage(const std::string &filepath,
   m_StageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
   m_StageInfo.module = m_ShaderModule;
   m_StageInfo.pName = "main";
-
-  switch (type) {
-  case ShaderStage::Vertex: {
-    m_StageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-  } break;
-  case ShaderStage::Fragment: {
-    m_StageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-  } break;
-  }
+  m_StageInfo.stage = StageTypeToVulkan(m_Type);
 }
 
-VulkanShaderStage::~VulkanShaderStage() {}
-
 ShaderStage::StageType VulkanShaderStage::GetType() const { return m_Type; }
 
 static shaderc_shader_kind StageTypeToShaderC(ShaderStage::StageType type) {
@@ -56,78 +126,266 @@ static shaderc_shader_kind StageTypeToShaderC(ShaderStage::StageType type) {
   return (shaderc_shader_kind)0;
 }
 
-void VulkanShaderStage::CompileOrLoadFromCache(const std::string &filepath,
-                                               StageType type) {
-  const std::string cachePath = GetCachePath(filepath, type);
+// shaderc compilers are created once per thread so batch compiles running on
+// the thread pool never share one
+static shaderc::Compiler &GetCompiler() {
+  thread_local shaderc::Compiler s_Compiler;
+  return s_Compiler;
+}
 
-  if (Filesystem::Exists(cachePath)) {
-    ME_CORE_INFO("Loading shader stage {0} from cache",
-                 Filesystem::GetFilename(filepath));
-    if (Filesystem::ReadSpvFile(cachePath, &m_SPIRV) ==
+// Every setting that changes the generated SPIR-V is part of the cache key
+static constexpr shaderc_target_env s_TargetEnv = shaderc_target_env_vulkan;
+static constexpr shaderc_env_version s_TargetEnvVersion =
+    shaderc_env_version_vulkan_1_3;
+#ifdef ME_DEBUG
+static constexpr shaderc_optimization_level s_OptimizationLevel =
+    shaderc_optimization_level_zero;
+#else
+static constexpr shaderc_optimization_level s_OptimizationLevel =
+    shaderc_optimization_level_performance;
+#endif
+
+// Resolves #include relative to the including file and records every file it
+// opened so hot reload can watch them
+class ShaderIncluder : public shaderc::CompileOptions::IncluderInterface {
+public:
+  explicit ShaderIncluder(std::vector<std::string> *pDependencies)
+      : m_Dependencies(pDependencies) {}
+
+  virtual shaderc_include_result *GetInclude(const char *requestedSource,
+                                             shaderc_include_type type,
+                                             const char *requestingSource,
+                                             size_t includeDepth) override {
+    std::filesystem::path path =
+        std::filesystem::path(requestingSource).parent_path() /
+        requestedSource;
+
+    IncludeData *include = new IncludeData();
+    include->Name = path.lexically_normal().string();
+    if (Filesystem::ReadFile(include->Name, &include->Content) !=
         Filesystem::READ_SUCCESS) {
-      return;
+      // An empty name tells shaderc the include failed, the content is the
+      // error message
+      include->Content =
+          "Unable to read include " + std::string(requestedSource);
+      include->Name.clear();
+    } else {
+      m_Dependencies->push_back(include->Name);
     }
-    ME_CORE_ERROR("Unable to read shader stage from cache, attempting to "
-                  "compile from source");
+
+    include->Result.source_name = include->Name.c_str();
+    include->Result.source_name_length = include->Name.size();
+    include->Result.content = include->Content.c_str();
+    include->Result.content_length = include->Content.size();
+    include->Result.user_data = include;
+    return &include->Result;
   }
 
+  virtual void ReleaseInclude(shaderc_include_result *data) override {
+    delete static_cast<IncludeData *>(data->user_data);
+  }
+
+private:
+  struct IncludeData {
+    std::string Name;
+    std::string Content;
+    shaderc_include_result Result;
+  };
+
+  std::vector<std::string> *m_Dependencies;
+};
+
+static shaderc::CompileOptions
+GetCompileOptions(std::vector<std::string> *pDependencies = nullptr) {
+  shaderc::CompileOptions options;
+  options.SetTargetEnvironment(s_TargetEnv, s_TargetEnvVersion);
+  options.SetOptimizationLevel(s_OptimizationLevel);
+  if (pDependencies != nullptr) {
+    options.SetIncluder(CreateUnique<ShaderIncluder>(pDependencies));
+  }
+  return options;
+}
+
+// Cached stages are the header followed by the SPIR-V words and the
+// serialized reflection
+static constexpr char s_CacheMagic[4] = {'M', 'E', 'S', 'C'};
+static constexpr uint32_t s_CacheVersion = 3;
+
+struct ShaderCacheHeader {
+  char Magic[4];
+  uint32_t Version;
+  uint64_t Key;
+  uint32_t WordCount;
+  uint32_t ReflectionSize;
+};
+
+static uint64_t GetCacheKey(const std::string &preprocessed,
+                            ShaderStage::StageType type) {
+  uint64_t key = Hash::XXH64(preprocessed);
+  key = Hash::Combine(key, (uint64_t)type);
+  key = Hash::Combine(key, (uint64_t)s_TargetEnv);
+  key = Hash::Combine(key, (uint64_t)s_TargetEnvVersion);
+  key = Hash::Combine(key, (uint64_t)s_OptimizationLevel);
+  return Hash::Combine(key, s_CacheVersion);
+}
+
+static bool ReadCachedStage(const std::string &cachePath, uint64_t key,
+                            std::vector<uint32_t> *pSpirv,
+                            VulkanShaderReflection *pReflection) {
+  std::vector<uint8_t> contents;
+  if (Filesystem::ReadBinaryFile(cachePath, &contents) !=
+      Filesystem::READ_SUCCESS) {
+    return false;
+  }
+
+  ShaderCacheHeader header;
+  if (contents.size() < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, contents.data(), sizeof(header));
+  if (memcmp(header.Magic, s_CacheMagic, sizeof(s_CacheMagic)) != 0 ||
+      header.Version != s_CacheVersion || header.Key != key ||
+      contents.size() != sizeof(header) +
+                             (size_t)header.WordCount * sizeof(uint32_t) +
+                             header.ReflectionSize) {
+    return false;
+  }
+
+  const size_t spirvSize = (size_t)header.WordCount * sizeof(uint32_t);
+  pSpirv->resize(header.WordCount);
+  memcpy(pSpirv->data(), contents.data() + sizeof(header), spirvSize);
+  return pReflection->Deserialize(contents.data() + sizeof(header) + spirvSize,
+                                  header.ReflectionSize);
+}
+
+static bool WriteCachedStage(const std::string &cachePath, uint64_t key,
+                             const std::vector<uint32_t> &spirv,
+                             const VulkanShaderReflection &reflection) {
+  std::vector<uint8_t> reflectionData;
+  reflection.Serialize(&reflectionData);
+
+  ShaderCacheHeader header{};
+  memcpy(header.Magic, s_CacheMagic, sizeof(s_CacheMagic));
+  header.Version = s_CacheVersion;
+  header.Key = key;
+  header.WordCount = (uint32_t)spirv.size();
+  header.ReflectionSize = (uint32_t)reflectionData.size();
+
+  const size_t spirvSize = spirv.size() * sizeof(uint32_t);
+  std::vector<uint8_t> contents(sizeof(header) + spirvSize +
+                                reflectionData.size());
+  memcpy(contents.data(), &header, sizeof(header));
+  memcpy(contents.data() + sizeof(header), spirv.data(), spirvSize);
+  memcpy(contents.data() + sizeof(header) + spirvSize, reflectionData.data(),
+         reflectionData.size());
+  return Filesystem::WriteBinaryFile(cachePath, contents.data(),
+                                     contents.size()) ==
+         Filesystem::WRITE_SUCCESS;
+}
+
+// Every cached stage of a source starts with its file name and path hash,
+// followed by the key of the preprocessed source
+static std::string GetCachePrefix(const std::string &filepath) {
+  return Filesystem::GetFilename(filepath) + "." +
+         Hash::ToHexString(Hash::XXH64(FileWatcher::Normalize(filepath))) +
+         ".";
+}
+
+// Removes the binaries of earlier versions of the source next to cachePath
+static void PruneCachedStages(const std::string &filepath,
+                              const std::string &cachePath) {
+  const std::string prefix = GetCachePrefix(filepath);
+  const std::filesystem::path current(cachePath);
+  std::error_code error;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(current.parent_path(), error)) {
+    const std::string name = entry.path().filename().string();
+    if (entry.path() != current &&
+        name.compare(0, prefix.size(), prefix) == 0 &&
+        entry.path().extension() == ".spv") {
+      std::filesystem::remove(entry.path(), error);
+    }
+  }
+}
+
+VulkanShaderStage::CompileResult
+VulkanShaderStage::CompileOrLoadFromCache(const std::string &filepath,
+                                          StageType type) {
+  CompileResult result;
+
   std::string glsl;
   if (Filesystem::ReadFile(filepath, &glsl) != Filesystem::READ_SUCCESS) {
-    ME_CORE_ERROR("Unable to read shader stage source file");
-    ME_CORE_ASSERT(false);
+    ME_CORE_ERROR("Unable to read shader stage source file {0}", filepath);
+    return result;
   }
 
-  const std::string preprocessed =
-      PreProcess(Filesystem::GetFilename(filepath), type, glsl);
+  // The key covers the preprocessed source so edits, including changed
+  // defines and includes, never reuse a stale binary
+  std::string preprocessed;
+  if (!PreProcess(filepath, type, glsl, &preprocessed,
+                  &result.Dependencies)) {
+    return result;
+  }
+  const uint64_t key = GetCacheKey(preprocessed, type);
+  const std::string cachePath = GetCachePath(filepath, key);
 
-  shaderc::Compiler compiler;
-  shaderc::CompileOptions options;
-  options.SetTargetEnvironment(shaderc_target_env_vulkan,
-                               shaderc_env_version_vulkan_1_3);
-#ifndef ME_DEBUG
-  options.SetOptimizationLevel(shaderc_optimization_level_performance);
-#endif
+  if (Filesystem::Exists(cachePath)) {
+    if (ReadCachedStage(cachePath, key, &result.SPIRV, &result.Reflection)) {
+      ME_CORE_INFO("Loading shader stage {0} from cache",
+                   Filesystem::GetFilename(filepath));
+      result.Success = true;
+      return result;
+    }
+    ME_CORE_ERROR("Unable to read shader stage from cache, attempting to "
+                  "compile from source");
+  }
 
-  shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-      preprocessed, StageTypeToShaderC(type), filepath.c_str(), options);
+  shaderc::Compiler &compiler = GetCompiler();
+  shaderc::SpvCompilationResult module =
+      compiler.CompileGlslToSpv(preprocessed, StageTypeToShaderC(type),
+                                filepath.c_str(), GetCompileOptions());
   if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
     ME_CORE_ERROR(module.GetErrorMessage());
-    ME_CORE_ASSERT(false);
+    return result;
   }
 
-  m_SPIRV = std::vector<uint32_t>(module.cbegin(), module.cend());
+  result.SPIRV = std::vector<uint32_t>(module.cbegin(), module.cend());
+  result.Reflection =
+      VulkanShaderReflection::Reflect(result.SPIRV, StageTypeToVulkan(type));
+  result.Success = true;
 
-  if (Filesystem::WriteSpvFile(cachePath, m_SPIRV) !=
-      Filesystem::WRITE_SUCCESS) {
+  if (!WriteCachedStage(cachePath, key, result.SPIRV, result.Reflection)) {
     ME_CORE_ERROR("Unable to write shader stage spv binary to file");
-    ME_CORE_ASSERT(false);
+  } else {
+    PruneCachedStages(filepath, cachePath);
   }
-}
 
-std::string VulkanShaderStage::PreProcess(const std::string &fileName,
-                                          ShaderStage::StageType type,
-                                          const std::string &source) {
-  shaderc::Compiler compiler;
-  shaderc::CompileOptions options;
-  options.SetTargetEnvironment(shaderc_target_env_vulkan,
-                               shaderc_env_version_vulkan_1_0);
+  return result;
+}
 
+bool VulkanShaderStage::PreProcess(const std::string &filepath,
+                                   ShaderStage::StageType type,
+                                   const std::string &source,
+                                   std::string *pPreprocessed,
+                                   std::vector<std::string> *pDependencies) {
+  shaderc::Compiler &compiler = GetCompiler();
   shaderc_shader_kind kind = StageTypeToShaderC(type);
 
-  shaderc::PreprocessedSourceCompilationResult result =
-      compiler.PreprocessGlsl(source, kind, fileName.c_str(), options);
+  shaderc::PreprocessedSourceCompilationResult result = compiler.PreprocessGlsl(
+      source, kind, filepath.c_str(), GetCompileOptions(pDependencies));
   if (result.GetCompilationStatus() != shaderc_compilation_status_success) {
-    ME_CORE_ERROR("Unable to preprocess shader stage", "file", fileName);
-    ME_CORE_ASSERT(false);
-    return "";
+    ME_CORE_ERROR("Unable to preprocess shader stage {0}: {1}", filepath,
+                  result.GetErrorMessage());
+    return false;
   }
 
-  return {result.cbegin(), result.cend()};
+  *pPreprocessed = {result.cbegin(), result.cend()};
+  return true;
 }
 
 std::string VulkanShaderStage::GetCachePath(const std::string &filepath,
-                                            ShaderStage::StageType type) {
-  return Filesystem::GetCacheDirectory() + "/shaders/vulkan/" + "cached." +
-         Filesystem::GetFilename(filepath) + ".spv";
+                                            uint64_t key) {
+  return Filesystem::GetCacheDirectory() + "/shaders/vulkan/" +
+         GetCachePrefix(filepath) + Hash::ToHexString(key) + ".spv";
 }
 } // namespace MyEngine
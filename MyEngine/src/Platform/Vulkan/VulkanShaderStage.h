@@ -1,29 +1,67 @@
 #pragma once
 
 #include "MyEngine/Renderer/ShaderStage.h"
+#include "Platform/Vulkan/VulkanShaderReflection.h"
 
 #include <vulkan/vulkan.h>
 
 namespace MyEngine {
 class VulkanShaderStage : public ShaderStage {
 public:
+  struct CompileResult {
+    std::vector<uint32_t> SPIRV;
+    // Files pulled in through #include, resolved relative to the stage
+    std::vector<std::string> Dependencies;
+    VulkanShaderReflection Reflection;
+    bool Success = false;
+  };
+
+  // Stages that fail to compile log the error and have a null module until a
+  // reload succeeds
   VulkanShaderStage(const std::string &filepath, StageType type);
+  // Creates the module from a stage that was already compiled
+  VulkanShaderStage(const std::string &filepath, StageType type,
+                    CompileResult &&result);
   virtual ~VulkanShaderStage() override;
 
   virtual StageType GetType() const override;
 
   VkShaderModule GetShaderModule() const { return m_ShaderModule; }
   VkPipelineShaderStageCreateInfo GetStageInfo() const { return m_StageInfo; }
+  const std::string &GetFilepath() const { return m_Filepath; }
+  const std::vector<std::string> &GetDependencies() const {
+    return m_Dependencies;
+  }
+  const VulkanShaderReflection &GetReflection() const { return m_Reflection; }
+
+  // Swaps in a recompiled module, the old one is destroyed once the frames
+  // using it finished
+  void Reload(CompileResult &&result);
+
+  // Compiles the sources on the thread pool, the modules are created on the
+  // calling thread afterwards.
+  static std::vector<Ref<ShaderStage>>
+  CreateBatch(const std::vector<Source> &sources);
+
+  // Safe to call from any thread. Failures are logged and reported through
+  // CompileResult::Success.
+  static CompileResult CompileOrLoadFromCache(const std::string &filepath,
+                                              StageType type);
 
 private:
-  void CompileOrLoadFromCache(const std::string &filepath, StageType type);
-  std::string PreProcess(const std::string &fileName, StageType type,
-                         const std::string &source);
-  std::string GetCachePath(const std::string &filepath, StageType type);
+  void CreateModule();
+
+  static bool PreProcess(const std::string &filepath, StageType type,
+                         const std::string &source, std::string *pPreprocessed,
+                         std::vector<std::string> *pDependencies);
+  static std::string GetCachePath(const std::string &filepath, uint64_t key);
 
-  VkShaderModule m_ShaderModule;
+  VkShaderModule m_ShaderModule = VK_NULL_HANDLE;
   VkPipelineShaderStageCreateInfo m_StageInfo{};
   StageType m_Type;
+  std::string m_Filepath;
   std::vector<uint32_t> m_SPIRV;
+  std::vector<std::string> m_Dependencies;
+  VulkanShaderReflection m_Reflection;
 };
 } // namespace MyEngine
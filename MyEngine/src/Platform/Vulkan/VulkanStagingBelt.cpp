@@ -0,0 +1,74 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanStagingBelt.h"
+
+namespace MyEngine {
+void VulkanStagingBelt::Init(VulkanContext *context) { m_Context = context; }
+
+void VulkanStagingBelt::Destroy() {
+  m_FramePages.clear();
+  m_RetiredPages.clear();
+  m_FreePages.clear();
+  m_FreeBytes = 0;
+}
+
+void VulkanStagingBelt::BeginFrame(uint64_t completedSerial) {
+  while (!m_RetiredPages.empty() &&
+         m_RetiredPages.front().first <= completedSerial) {
+    Page page = std::move(m_RetiredPages.front().second);
+    m_RetiredPages.pop_front();
+
+    const VkDeviceSize size = page.Buffer->GetSize();
+    if (m_FreeBytes + size <= MaxFreeBytes) {
+      page.Head = 0;
+      m_FreeBytes += size;
+      m_FreePages.push_back(std::move(page));
+    }
+  }
+}
+
+void VulkanStagingBelt::EndFrame(uint64_t frameSerial) {
+  for (Page &page : m_FramePages) {
+    m_RetiredPages.emplace_back(frameSerial, std::move(page));
+  }
+  m_FramePages.clear();
+}
+
+VulkanHostBuffer *VulkanStagingBelt::AllocateBytes(VkDeviceSize size,
+                                                   VkDeviceSize *pOffset) {
+  if (!m_FramePages.empty()) {
+    Page &page = m_FramePages.back();
+    const VkDeviceSize offset = (page.Head + Alignment - 1) & ~(Alignment - 1);
+    if (offset + size <= page.Buffer->GetSize()) {
+      page.Head = offset + size;
+      *pOffset = offset;
+      return page.Buffer.get();
+    }
+  }
+
+  // The smallest free page that fits, or a new one
+  auto best = m_FreePages.end();
+  for (auto it = m_FreePages.begin(); it != m_FreePages.end(); it++) {
+    if (it->Buffer->GetSize() >= size &&
+        (best == m_FreePages.end() ||
+         it->Buffer->GetSize() < best->Buffer->GetSize())) {
+      best = it;
+    }
+  }
+
+  Page page;
+  if (best != m_FreePages.end()) {
+    page = std::move(*best);
+    m_FreePages.erase(best);
+    m_FreeBytes -= page.Buffer->GetSize();
+  } else {
+    page.Buffer = CreateUnique<VulkanHostBuffer>(
+        m_Context, std::max(size, PageSize), VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+  }
+  page.Head = size;
+  *pOffset = 0;
+  m_FramePages.push_back(std::move(page));
+  return m_FramePages.back().Buffer.get();
+}
+} // namespace MyEngine
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Platform/Vulkan/VulkanHostBuffer.h"
+
+#include <deque>
+#include <vector>
+
+namespace MyEngine {
+class VulkanContext;
+
+// Space in a staging page, valid until the end of the frame being recorded
+template <typename T> struct VulkanStagingSpan {
+  VkBuffer Buffer = VK_NULL_HANDLE;
+  // Byte offset of Data inside Buffer, the source offset of copies
+  VkDeviceSize Offset = 0;
+  Span<T> Data;
+};
+
+// Staging memory for the copies recorded during a frame. Allocations
+// are carved linearly out of persistently mapped pages, which are recycled
+// once the GPU finished the frame that copied from them, so uploads neither
+// create buffers nor map memory. Pages larger than the default size are made
+// for single large uploads and dropped instead of kept when freed past
+// MaxFreeBytes.
+class VulkanStagingBelt {
+public:
+  static constexpr VkDeviceSize PageSize = 4 * 1024 * 1024;
+  static constexpr VkDeviceSize MaxFreeBytes = 64 * 1024 * 1024;
+  // Enough for the texel blocks of every texture format
+  static constexpr VkDeviceSize Alignment = 16;
+
+  void Init(VulkanContext *context);
+  void Destroy();
+
+  // Called once the fence of a frame was waited on, pages of frames up to
+  // completedSerial are reused
+  void BeginFrame(uint64_t completedSerial);
+  // Called before the frame is submitted, the pages used since the last call
+  // belong to frameSerial
+  void EndFrame(uint64_t frameSerial);
+
+  // Space for count elements, written in place by the caller
+  template <typename T> VulkanStagingSpan<T> Allocate(size_t count) {
+    VkDeviceSize offset;
+    VulkanHostBuffer *page = AllocateBytes(sizeof(T) * count, &offset);
+
+    VulkanStagingSpan<T> span;
+    span.Buffer = page->GetBuffer();
+    span.Offset = offset;
+    span.Data = page->Map<T>(offset, count);
+    return span;
+  }
+
+private:
+  struct Page {
+    Unique<VulkanHostBuffer> Buffer;
+    VkDeviceSize Head = 0;
+  };
+
+  VulkanHostBuffer *AllocateBytes(VkDeviceSize size, VkDeviceSize *pOffset);
+
+  VulkanContext *m_Context = nullptr;
+  // Pages used by the frame being recorded, the last one is allocated from
+  std::vector<Page> m_FramePages;
+  // Pages of frames the GPU may still be copying from
+  std::deque<std::pair<uint64_t, Page>> m_RetiredPages;
+  std::vector<Page> m_FreePages;
+  VkDeviceSize m_FreeBytes = 0;
+};
+} // namespace MyEngine
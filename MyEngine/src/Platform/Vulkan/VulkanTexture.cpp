@@ -0,0 +1,566 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Application.h"
+#include "Platform/Vulkan/VulkanBuffer.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanTexture.h"
+#include "Platform/Vulkan/VulkanTextureStreamer.h"
+#include "Platform/Vulkan/VulkanTextureUploader.h"
+
+#include <cstring>
+
+namespace MyEngine {
+VkFormat ToVulkanFormat(TextureFormat format) {
+  switch (format) {
+  case TextureFormat::RGBA8:
+    return VK_FORMAT_R8G8B8A8_UNORM;
+  case TextureFormat::RGBA8_SRGB:
+    return VK_FORMAT_R8G8B8A8_SRGB;
+  case TextureFormat::BC1:
+    return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+  case TextureFormat::BC1_SRGB:
+    return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+  case TextureFormat::BC3:
+    return VK_FORMAT_BC3_UNORM_BLOCK;
+  case TextureFormat::BC3_SRGB:
+    return VK_FORMAT_BC3_SRGB_BLOCK;
+  case TextureFormat::BC5:
+    return VK_FORMAT_BC5_UNORM_BLOCK;
+  case TextureFormat::BC7:
+    return VK_FORMAT_BC7_UNORM_BLOCK;
+  case TextureFormat::BC7_SRGB:
+    return VK_FORMAT_BC7_SRGB_BLOCK;
+  case TextureFormat::ETC2_RGBA8:
+    return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+  case TextureFormat::ETC2_RGBA8_SRGB:
+    return VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
+  case TextureFormat::ASTC_4x4:
+    return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+  case TextureFormat::ASTC_4x4_SRGB:
+    return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+  }
+
+  ME_CORE_ASSERT(false, "Unknown texture format!");
+  return VK_FORMAT_UNDEFINED;
+}
+
+static void TransitionMips(VkCommandBuffer commandBuffer, VkImage image,
+                           uint32_t baseMip, uint32_t mipCount,
+                           VkImageLayout oldLayout, VkImageLayout newLayout,
+                           VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+                           VkPipelineStageFlags srcStage,
+                           VkPipelineStageFlags dstStage) {
+  VkImageMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.srcAccessMask = srcAccess;
+  barrier.dstAccessMask = dstAccess;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel = baseMip;
+  barrier.subresourceRange.levelCount = mipCount;
+  barrier.subresourceRange.baseArrayLayer = 0;
+  barrier.subresourceRange.layerCount = 1;
+  vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0,
+                       nullptr, 1, &barrier);
+}
+
+VulkanTexture2D::VulkanTexture2D(const TextureSpecification &specification)
+    : m_Specification(specification),
+      m_Format(ToVulkanFormat(specification.Format)),
+      m_Index(VulkanBindlessTable::InvalidIndex) {}
+
+VulkanTexture2D::VulkanTexture2D(const std::string &filepath,
+                                 const TextureSpecification &specification)
+    : VulkanTexture2D(specification) {
+  m_Filepath = filepath;
+  m_Decoding = true;
+  VulkanTextureUploader::QueueDecode(this, filepath);
+}
+
+VulkanTexture2D::~VulkanTexture2D() {
+  VulkanTextureUploader::Cancel(this);
+  VulkanTextureStreamer::Unregister(this);
+  ReleaseImage();
+}
+
+uint32_t VulkanTexture2D::GetIndex() const {
+  m_LastUsed =
+      Application::Get().GetGraphicsContext<VulkanContext>()->FrameSerial;
+  return GetResident()->m_Index;
+}
+
+void VulkanTexture2D::RequestSize(uint32_t pixels) {
+  const uint64_t serial =
+      Application::Get().GetGraphicsContext<VulkanContext>()->FrameSerial;
+  m_RequestedSize = m_RequestSerial == serial
+                        ? std::max(m_RequestedSize, pixels)
+                        : pixels;
+  m_RequestSerial = serial;
+  m_LastUsed = serial;
+}
+
+VkImageView VulkanTexture2D::GetImageView() const {
+  return GetResident()->m_View;
+}
+
+VkSampler VulkanTexture2D::GetSampler() const {
+  return GetResident()->m_Sampler;
+}
+
+void VulkanTexture2D::SetData(const void *data, uint32_t size) {
+  ME_CORE_ASSERT(size == TextureFormatImageSize(m_Specification.Format,
+                                                m_Specification.Width,
+                                                m_Specification.Height),
+                 "Texture data must cover the whole texture!");
+
+  ImageData image;
+  image.Width = m_Specification.Width;
+  image.Height = m_Specification.Height;
+  image.Format = m_Specification.Format;
+  image.Pixels.resize(size);
+  memcpy(image.Pixels.data(), data, size);
+  VulkanTextureUploader::QueueData(this, std::move(image));
+}
+
+const VulkanTexture2D *VulkanTexture2D::GetResident() const {
+  if (m_Resident) {
+    return this;
+  }
+
+  const VulkanTexture2D *fallback =
+      m_Failed ? VulkanTextureUploader::GetErrorTexture()
+               : VulkanTextureUploader::GetPlaceholder();
+  // The fallbacks are uploaded before anything is drawn
+  return fallback != nullptr && fallback != this ? fallback : this;
+}
+
+void VulkanTexture2D::Upload(VkCommandBuffer commandBuffer,
+                             const ImageData &image) {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+
+  if (m_Image == VK_NULL_HANDLE) {
+    m_Specification.Width = image.Width;
+    m_Specification.Height = image.Height;
+
+    // Mips are blitted from each other, which needs linear filtering support
+    // and rules out compressed formats
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(context->PhysicalDevice, m_Format,
+                                        &formatProperties);
+    const bool canBlit =
+        TextureFormatBlockSize(image.Format) == 0 &&
+        (formatProperties.optimalTilingFeatures &
+         VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+    uint32_t mipLevels = 1;
+    if (m_Specification.GenerateMips && canBlit) {
+      for (uint32_t extent = std::max(image.Width, image.Height); extent > 1;
+           extent /= 2) {
+        mipLevels++;
+      }
+    }
+    CreateImage(image.Width, image.Height, mipLevels);
+  }
+  ME_CORE_ASSERT(image.Width == m_Specification.Width &&
+                     image.Height == m_Specification.Height,
+                 "Texture data doesn't match the size of the texture!");
+
+  VulkanStagingSpan<uint8_t> staging =
+      context->StagingBelt.Allocate<uint8_t>(image.Pixels.size());
+  memcpy(staging.Data.data(), image.Pixels.data(), image.Pixels.size());
+
+  // Reuploads wait for earlier frames sampling the image, they were submitted
+  // to the same queue before
+  TransitionMips(commandBuffer, m_Image, 0, m_MipLevels,
+                 m_Resident ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                            : VK_IMAGE_LAYOUT_UNDEFINED,
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                 VK_ACCESS_TRANSFER_WRITE_BIT,
+                 m_Resident ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+                            : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                 VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+  VkBufferImageCopy region{};
+  region.bufferOffset = staging.Offset;
+  region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  region.imageSubresource.mipLevel = 0;
+  region.imageSubresource.baseArrayLayer = 0;
+  region.imageSubresource.layerCount = 1;
+  region.imageExtent = {image.Width, image.Height, 1};
+  vkCmdCopyBufferToImage(commandBuffer, staging.Buffer, m_Image,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+  GenerateMips(commandBuffer);
+
+  if (m_Index == VulkanBindlessTable::InvalidIndex) {
+    m_Index = context->Bindless.AddTexture(
+        m_View, m_Sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  }
+  m_Resident = true;
+  m_Failed = false;
+}
+
+void VulkanTexture2D::CreateImage(uint32_t width, uint32_t height,
+                                  uint32_t mipLevels) {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  m_MipLevels = mipLevels;
+
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.format = m_Format;
+  imageInfo.extent = {width, height, 1};
+  imageInfo.mipLevels = m_MipLevels;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                    VK_IMAGE_USAGE_SAMPLED_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkResult res = vkCreateImage(context->LogicalDevice, &imageInfo,
+                               context->AllocationCallback, &m_Image);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create texture image!");
+
+  VkMemoryRequirements requirements;
+  vkGetImageMemoryRequirements(context->LogicalDevice, m_Image,
+                               &requirements);
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.allocationSize = requirements.size;
+  allocInfo.memoryTypeIndex = VulkanBufferHelper::FindMemoryType(
+      context->PhysicalDevice, requirements.memoryTypeBits,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  res = vkAllocateMemory(context->LogicalDevice, &allocInfo,
+                         context->AllocationCallback, &m_Memory);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to allocate texture memory!");
+  vkBindImageMemory(context->LogicalDevice, m_Image, m_Memory, 0);
+
+  VkImageViewCreateInfo viewInfo{};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = m_Image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = m_Format;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.baseMipLevel = 0;
+  viewInfo.subresourceRange.levelCount = m_MipLevels;
+  viewInfo.subresourceRange.baseArrayLayer = 0;
+  viewInfo.subresourceRange.layerCount = 1;
+  res = vkCreateImageView(context->LogicalDevice, &viewInfo,
+                          context->AllocationCallback, &m_View);
+  ME_CORE_ASSERT(res == VK_SUCCESS, "Unable to create texture image view!");
+
+  m_Sampler = context->SamplerCache.GetSampler(
+      context->LogicalDevice, context->AllocationCallback,
+      m_Specification.Filter, m_Specification.Wrap);
+}
+
+void VulkanTexture2D::GenerateMips(VkCommandBuffer commandBuffer) {
+  int32_t width = (int32_t)m_Specification.Width;
+  int32_t height = (int32_t)m_Specification.Height;
+
+  // Every mip is blitted from the previous one, which is moved to shader
+  // read once it was read
+  for (uint32_t mip = 1; mip < m_MipLevels; mip++) {
+    TransitionMips(commandBuffer, m_Image, mip - 1, 1,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    const int32_t mipWidth = std::max(width / 2, 1);
+    const int32_t mipHeight = std::max(height / 2, 1);
+    VkImageBlit blit{};
+    blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip - 1, 0, 1};
+    blit.srcOffsets[1] = {width, height, 1};
+    blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, 1};
+    blit.dstOffsets[1] = {mipWidth, mipHeight, 1};
+    vkCmdBlitImage(commandBuffer, m_Image,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_Image,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
+                   VK_FILTER_LINEAR);
+
+    TransitionMips(commandBuffer, m_Image, mip - 1, 1,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                   VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT,
+                   VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    width = mipWidth;
+    height = mipHeight;
+  }
+
+  TransitionMips(commandBuffer, m_Image, m_MipLevels - 1, 1,
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                 VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+}
+
+void VulkanTexture2D::ReleaseImage() {
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  context->Bindless.RemoveTexture(m_Index);
+  m_Index = VulkanBindlessTable::InvalidIndex;
+  if (m_Image == VK_NULL_HANDLE) {
+    return;
+  }
+
+  // Frames in flight may still sample the image
+  VkImage image = m_Image;
+  VkImageView view = m_View;
+  VkDeviceMemory memory = m_Memory;
+  context->Defer([context, image, view, memory]() {
+    vkDestroyImageView(context->LogicalDevice, view,
+                       context->AllocationCallback);
+    vkDestroyImage(context->LogicalDevice, image, context->AllocationCallback);
+    vkFreeMemory(context->LogicalDevice, memory, context->AllocationCallback);
+  });
+  m_Image = VK_NULL_HANDLE;
+  m_View = VK_NULL_HANDLE;
+  m_Memory = VK_NULL_HANDLE;
+}
+
+// +===========+
+// | STREAMING |
+// +===========+
+void VulkanTexture2D::OnLoadFailed() {
+  m_Decoding = false;
+  m_Failed = true;
+  if (m_Resident) {
+    ME_CORE_ERROR("Unable to decode {0} again, keeping its resident mips",
+                  m_Filepath);
+  }
+}
+
+uint32_t VulkanTexture2D::GetResidentWidth() const {
+  return m_Mips.empty() ? m_Specification.Width : m_Mips[m_ResidentMip].Width;
+}
+
+uint32_t VulkanTexture2D::GetResidentHeight() const {
+  return m_Mips.empty() ? m_Specification.Height
+                        : m_Mips[m_ResidentMip].Height;
+}
+
+void VulkanTexture2D::RecordCopyToBuffer(VkCommandBuffer commandBuffer,
+                                         VkBuffer buffer) {
+  ME_CORE_ASSERT(m_Resident, "Texture isn't loaded!");
+
+  TransitionMips(commandBuffer, m_Image, 0, 1,
+                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                 VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+  VkBufferImageCopy region{};
+  region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.imageExtent = {GetResidentWidth(), GetResidentHeight(), 1};
+  vkCmdCopyImageToBuffer(commandBuffer, m_Image,
+                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1,
+                         &region);
+
+  TransitionMips(commandBuffer, m_Image, 0, 1,
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                 VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
+                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+}
+
+void VulkanTexture2D::OnDecoded(std::vector<ImageData> &&mips) {
+  m_Decoding = false;
+
+  // Decoded again to raise the texture, only the pixels are taken
+  if (!m_Mips.empty()) {
+    bool matches = mips.size() == m_Mips.size();
+    for (size_t i = 0; matches && i < mips.size(); i++) {
+      matches = mips[i].Width == m_Mips[i].Width &&
+                mips[i].Height == m_Mips[i].Height &&
+                mips[i].Format == m_Mips[i].Format;
+    }
+    if (!matches) {
+      ME_CORE_ERROR("{0} changed since it was loaded, keeping its resident "
+                    "mips",
+                    m_Filepath);
+      m_Failed = true;
+      return;
+    }
+    m_Mips = std::move(mips);
+    return;
+  }
+
+  m_Mips = std::move(mips);
+  m_MipBytes.clear();
+  for (const ImageData &image : m_Mips) {
+    m_MipBytes.push_back(image.Pixels.size());
+  }
+  m_Specification.Width = m_Mips[0].Width;
+  m_Specification.Height = m_Mips[0].Height;
+  m_Specification.Format = m_Mips[0].Format;
+  m_Format = ToVulkanFormat(m_Specification.Format);
+  m_ResidentMip = GetMipCount();
+  VulkanTextureStreamer::Register(this);
+}
+
+uint32_t VulkanTexture2D::GetMinResidentMip() const {
+  uint32_t mip = 0;
+  while (mip + 1 < GetMipCount() &&
+         std::max(m_Mips[mip].Width, m_Mips[mip].Height) >
+             VulkanTextureStreamer::MinResidentSize) {
+    mip++;
+  }
+  return mip;
+}
+
+uint32_t VulkanTexture2D::GetWantedMip(uint64_t frameSerial) const {
+  // Textures nobody asked a size for stay small
+  if (m_RequestedSize == 0 ||
+      m_RequestSerial + VulkanTextureStreamer::RequestFrames < frameSerial) {
+    return GetMinResidentMip();
+  }
+
+  uint32_t mip = 0;
+  while (mip + 1 < GetMipCount() &&
+         std::max(m_Mips[mip + 1].Width, m_Mips[mip + 1].Height) >=
+             m_RequestedSize) {
+    mip++;
+  }
+  return std::min(mip, GetMinResidentMip());
+}
+
+uint64_t VulkanTexture2D::GetMipBytes(uint32_t firstMip) const {
+  uint64_t bytes = 0;
+  for (uint32_t mip = firstMip; mip < GetMipCount(); mip++) {
+    bytes += m_MipBytes[mip];
+  }
+  return bytes;
+}
+
+bool VulkanTexture2D::HasMipData(uint32_t firstMip) const {
+  const uint32_t end = m_Resident ? m_ResidentMip : GetMipCount();
+  for (uint32_t mip = firstMip; mip < end; mip++) {
+    if (m_Mips[mip].Pixels.size() != m_MipBytes[mip]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void VulkanTexture2D::RequestMipData() {
+  if (m_Decoding || m_Failed || m_Filepath.empty()) {
+    return;
+  }
+
+  m_Decoding = true;
+  VulkanTextureUploader::QueueDecode(this, m_Filepath);
+}
+
+void VulkanTexture2D::SetResidentMip(VkCommandBuffer commandBuffer,
+                                     uint32_t mip) {
+  ME_CORE_ASSERT(mip < GetMipCount(), "Resident mip is out of range!");
+  if (m_Resident && mip == m_ResidentMip) {
+    return;
+  }
+  ME_CORE_ASSERT(HasMipData(mip), "Raised mips aren't decoded!");
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  const uint32_t mipCount = GetMipCount();
+
+  // The old image stays alive for the copy and the frames still using it
+  const VkImage oldImage = m_Image;
+  const uint32_t oldMip = m_ResidentMip;
+  const bool hadImage = m_Resident;
+  ReleaseImage();
+  CreateImage(m_Mips[mip].Width, m_Mips[mip].Height, mipCount - mip);
+
+  TransitionMips(commandBuffer, m_Image, 0, m_MipLevels,
+                 VK_IMAGE_LAYOUT_UNDEFINED,
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                 VK_ACCESS_TRANSFER_WRITE_BIT,
+                 VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                 VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+  // Mips the old image holds are copied on the GPU, the earlier frames
+  // sampling it were submitted to the same queue before
+  const uint32_t firstCopied = hadImage ? std::max(mip, oldMip) : mipCount;
+  if (firstCopied < mipCount) {
+    TransitionMips(commandBuffer, oldImage, firstCopied - oldMip,
+                   mipCount - firstCopied,
+                   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 0,
+                   VK_ACCESS_TRANSFER_READ_BIT,
+                   VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    std::vector<VkImageCopy> regions;
+    for (uint32_t level = firstCopied; level < mipCount; level++) {
+      VkImageCopy region{};
+      region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - oldMip, 0,
+                               1};
+      region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - mip, 0, 1};
+      region.extent = {m_Mips[level].Width, m_Mips[level].Height, 1};
+      regions.push_back(region);
+    }
+    vkCmdCopyImage(commandBuffer, oldImage,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_Image,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   (uint32_t)regions.size(), regions.data());
+  }
+
+  // The remaining mips come from memory through one staging buffer
+  if (mip < firstCopied) {
+    const VkDeviceSize size = GetMipBytes(mip) - GetMipBytes(firstCopied);
+    VulkanStagingSpan<uint8_t> staging =
+        context->StagingBelt.Allocate<uint8_t>(size);
+
+    std::vector<VkBufferImageCopy> regions;
+    VkDeviceSize offset = 0;
+    for (uint32_t level = mip; level < firstCopied; level++) {
+      const ImageData &image = m_Mips[level];
+      memcpy(staging.Data.data() + offset, image.Pixels.data(),
+             image.Pixels.size());
+
+      VkBufferImageCopy region{};
+      region.bufferOffset = staging.Offset + offset;
+      region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - mip, 0,
+                                 1};
+      region.imageExtent = {image.Width, image.Height, 1};
+      regions.push_back(region);
+      offset += image.Pixels.size();
+    }
+
+    vkCmdCopyBufferToImage(commandBuffer, staging.Buffer, m_Image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           (uint32_t)regions.size(), regions.data());
+  }
+
+  TransitionMips(commandBuffer, m_Image, 0, m_MipLevels,
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                 VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+  // A new slot, the old one may still be read by frames in flight
+  m_Index = context->Bindless.AddTexture(
+      m_View, m_Sampler, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  m_ResidentMip = mip;
+  m_Resident = true;
+
+  // Copied into staging memory, the pixels are decoded again when needed
+  for (ImageData &image : m_Mips) {
+    image.Pixels.clear();
+    image.Pixels.shrink_to_fit();
+  }
+}
+} // namespace MyEngine
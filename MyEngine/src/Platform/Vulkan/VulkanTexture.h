@@ -0,0 +1,115 @@
+#pragma once
+
+#include "MyEngine/Renderer/Image.h"
+#include "MyEngine/Renderer/Texture.h"
+
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+VkFormat ToVulkanFormat(TextureFormat format);
+
+// Texture whose image is created and filled at the start of a frame. Until
+// then the placeholder of the uploader is sampled in its place, textures that
+// fail to decode keep sampling the error texture.
+//
+// Textures loaded from files are streamed: the image only holds the mips from
+// the resident mip on, the texture streamer moves it up and down the chain
+// under its memory budget. The decoded pixels are dropped once the image was
+// created, raising the texture again decodes the file again.
+class VulkanTexture2D : public Texture2D {
+public:
+  VulkanTexture2D(const TextureSpecification &specification);
+  VulkanTexture2D(const std::string &filepath,
+                  const TextureSpecification &specification);
+  virtual ~VulkanTexture2D();
+
+  virtual uint32_t GetWidth() const override { return m_Specification.Width; }
+  virtual uint32_t GetHeight() const override {
+    return m_Specification.Height;
+  }
+
+  const TextureSpecification &GetSpecification() const {
+    return m_Specification;
+  }
+
+  virtual bool IsLoaded() const override { return m_Resident; }
+  virtual uint32_t GetIndex() const override;
+  virtual void RequestSize(uint32_t pixels) override;
+
+  virtual void SetData(const void *data, uint32_t size) override;
+
+  // For descriptor sets outside of the bindless table, the placeholder's
+  // until the texture is loaded
+  VkImageView GetImageView() const;
+  VkSampler GetSampler() const;
+
+  // Records the copy of the pixels into the image and the generation of its
+  // mip chain. The image is created on the first upload.
+  void Upload(VkCommandBuffer commandBuffer, const ImageData &image);
+  void OnLoadFailed();
+
+  // Size of the largest mip the image holds
+  uint32_t GetResidentWidth() const;
+  uint32_t GetResidentHeight() const;
+  // Records the copy of the largest mip into the buffer, tightly packed.
+  // The texture has to be loaded.
+  void RecordCopyToBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer);
+
+  // +===========+
+  // | STREAMING |
+  // +===========+
+  void OnDecoded(std::vector<ImageData> &&mips);
+  uint32_t GetMipCount() const { return (uint32_t)m_Mips.size(); }
+  uint32_t GetResidentMip() const { return m_ResidentMip; }
+  // Largest mip that is no bigger than the streamer's minimum size
+  uint32_t GetMinResidentMip() const;
+  // Smallest mip that still covers the requested size, the minimum resident
+  // mip when no size was requested recently
+  uint32_t GetWantedMip(uint64_t frameSerial) const;
+  // Whether the pixels of the mips from firstMip up to the resident mip are
+  // in memory, SetResidentMip needs them to raise the texture
+  bool HasMipData(uint32_t firstMip) const;
+  // Decodes the file again on the thread pool, the streamer raises the
+  // texture once the pixels arrived
+  void RequestMipData();
+  uint64_t GetLastUsed() const { return m_LastUsed; }
+  // Memory of the image holding every mip from firstMip on
+  uint64_t GetMipBytes(uint32_t firstMip) const;
+  // Recreates the image with the mips from mip on. Mips the current image
+  // holds are copied on the GPU, the others are uploaded from memory. Draws
+  // recorded afterwards use the new bindless slot, the old image and slot are
+  // released once the frames using them finished.
+  void SetResidentMip(VkCommandBuffer commandBuffer, uint32_t mip);
+
+private:
+  // The texture sampled instead of this one, itself once it is loaded
+  const VulkanTexture2D *GetResident() const;
+  void CreateImage(uint32_t width, uint32_t height, uint32_t mipLevels);
+  void ReleaseImage();
+  void GenerateMips(VkCommandBuffer commandBuffer);
+
+  TextureSpecification m_Specification;
+  VkFormat m_Format;
+
+  VkImage m_Image = VK_NULL_HANDLE;
+  VkDeviceMemory m_Memory = VK_NULL_HANDLE;
+  VkImageView m_View = VK_NULL_HANDLE;
+  VkSampler m_Sampler = VK_NULL_HANDLE;
+  uint32_t m_MipLevels = 1;
+  uint32_t m_Index;
+
+  // Mips of streamed textures, the first is the full texture. Their pixels
+  // are only kept until the next SetResidentMip.
+  std::string m_Filepath;
+  std::vector<ImageData> m_Mips;
+  std::vector<uint64_t> m_MipBytes;
+  bool m_Decoding = false;
+  uint32_t m_ResidentMip = 0;
+  uint32_t m_RequestedSize = 0;
+  uint64_t m_RequestSerial = 0;
+  mutable uint64_t m_LastUsed = 0;
+
+  bool m_Resident = false;
+  bool m_Failed = false;
+};
+} // namespace MyEngine
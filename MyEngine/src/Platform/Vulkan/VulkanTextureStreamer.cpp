@@ -0,0 +1,158 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Application.h"
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanTexture.h"
+#include "Platform/Vulkan/VulkanTextureStreamer.h"
+#include "Platform/Vulkan/VulkanTextureUploader.h"
+
+#include <unordered_set>
+
+namespace MyEngine {
+struct TextureStreamerData {
+  std::unordered_set<VulkanTexture2D *> Textures;
+  uint64_t Budget = VulkanTextureStreamer::DefaultBudget;
+  uint64_t ResidentBytes = 0;
+};
+
+static Unique<TextureStreamerData> s_Data;
+
+static bool IsLoaded(const VulkanTexture2D *texture) {
+  return texture->GetResidentMip() < texture->GetMipCount();
+}
+
+void VulkanTextureStreamer::Init() {
+  const ApplicationCommandLineArgs &args =
+      Application::Get().GetSpecification().CommandLineArgs;
+
+  s_Data = CreateUnique<TextureStreamerData>();
+  s_Data->Budget = args.GetUnsignedOption("texture-budget", 0) * 1024 * 1024;
+  if (s_Data->Budget == 0) {
+    s_Data->Budget = DefaultBudget;
+  }
+  ME_CORE_INFO("Texture streaming budget is {0} MiB",
+               s_Data->Budget / (1024 * 1024));
+}
+
+void VulkanTextureStreamer::Shutdown() { s_Data.reset(); }
+
+void VulkanTextureStreamer::Update(VkCommandBuffer commandBuffer) {
+  if (!s_Data) {
+    return;
+  }
+
+  const uint64_t serial =
+      Application::Get().GetGraphicsContext<VulkanContext>()->FrameSerial;
+  // Textures of the last recorded frame are in use, older ones can be evicted
+  auto isRecent = [serial](const VulkanTexture2D *texture) {
+    return texture->GetLastUsed() + 1 >= serial;
+  };
+
+  uint64_t resident = 0;
+  std::vector<VulkanTexture2D *> raises;
+  std::vector<VulkanTexture2D *> victims;
+  for (VulkanTexture2D *texture : s_Data->Textures) {
+    if (!IsLoaded(texture)) {
+      raises.push_back(texture);
+      continue;
+    }
+
+    resident += texture->GetMipBytes(texture->GetResidentMip());
+    if (isRecent(texture)) {
+      if (texture->GetWantedMip(serial) < texture->GetResidentMip()) {
+        raises.push_back(texture);
+      }
+    } else if (texture->GetResidentMip() < texture->GetMinResidentMip()) {
+      victims.push_back(texture);
+    }
+  }
+
+  // Textures that can't be sampled yet go first, then the most recently used
+  std::sort(raises.begin(), raises.end(),
+            [](const VulkanTexture2D *a, const VulkanTexture2D *b) {
+              if (IsLoaded(a) != IsLoaded(b)) {
+                return !IsLoaded(a);
+              }
+              return a->GetLastUsed() > b->GetLastUsed();
+            });
+  // Least recently used at the back
+  std::sort(victims.begin(), victims.end(),
+            [](const VulkanTexture2D *a, const VulkanTexture2D *b) {
+              return a->GetLastUsed() > b->GetLastUsed();
+            });
+
+  // Evictions only copy on the GPU, uploads are limited like the uploader's.
+  // The first upload of a frame always goes through.
+  uint64_t uploaded = 0;
+  for (VulkanTexture2D *texture : raises) {
+    const bool loaded = IsLoaded(texture);
+    const uint32_t current = loaded ? texture->GetResidentMip()
+                                    : texture->GetMinResidentMip();
+    const uint64_t currentBytes = loaded ? texture->GetMipBytes(current) : 0;
+
+    uint32_t mip = std::min(texture->GetWantedMip(serial), current);
+    // Raised once the evicted pixels are decoded again
+    if (loaded && mip < current && !texture->HasMipData(mip)) {
+      texture->RequestMipData();
+      continue;
+    }
+    while (mip < current &&
+           resident - currentBytes + texture->GetMipBytes(mip) >
+               s_Data->Budget &&
+           !victims.empty()) {
+      VulkanTexture2D *victim = victims.back();
+      victims.pop_back();
+      resident -= victim->GetMipBytes(victim->GetResidentMip());
+      victim->SetResidentMip(commandBuffer, victim->GetMinResidentMip());
+      resident += victim->GetMipBytes(victim->GetResidentMip());
+    }
+
+    // What doesn't fit is raised as far as it does, unloaded textures always
+    // get their smallest mips
+    while (mip < current &&
+           resident - currentBytes + texture->GetMipBytes(mip) >
+               s_Data->Budget) {
+      mip++;
+    }
+    if (loaded && mip == current) {
+      continue;
+    }
+
+    const uint64_t size =
+        texture->GetMipBytes(mip) -
+        (loaded ? texture->GetMipBytes(current) : 0);
+    if (uploaded > 0 && uploaded + size > VulkanTextureUploader::FrameBudget) {
+      break;
+    }
+    texture->SetResidentMip(commandBuffer, mip);
+    resident += texture->GetMipBytes(mip) - currentBytes;
+    uploaded += size;
+  }
+
+  s_Data->ResidentBytes = resident;
+}
+
+void VulkanTextureStreamer::Register(VulkanTexture2D *texture) {
+  if (!s_Data) {
+    return;
+  }
+
+  s_Data->Textures.insert(texture);
+}
+
+void VulkanTextureStreamer::Unregister(VulkanTexture2D *texture) {
+  if (!s_Data) {
+    return;
+  }
+
+  s_Data->Textures.erase(texture);
+}
+
+uint64_t VulkanTextureStreamer::GetResidentBytes() {
+  return s_Data ? s_Data->ResidentBytes : 0;
+}
+
+uint64_t VulkanTextureStreamer::GetBudget() {
+  return s_Data ? s_Data->Budget : 0;
+}
+} // namespace MyEngine
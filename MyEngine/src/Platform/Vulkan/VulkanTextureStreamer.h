@@ -0,0 +1,36 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+class VulkanTexture2D;
+
+// Keeps the mips of decoded textures resident under a memory budget. Textures
+// report the size they are drawn at through RequestSize, every frame the
+// streamer raises textures that were drawn recently to the mip covering that
+// size and drops the large mips of the least recently used ones to make room.
+// Mips up to MinResidentSize stay resident, so every texture can always be
+// sampled, and textures without a requested size stay at them. Pass
+// --texture-budget=<MiB> to change the budget.
+class VulkanTextureStreamer {
+public:
+  static constexpr uint32_t MinResidentSize = 64;
+  static constexpr uint64_t DefaultBudget = 256ull * 1024 * 1024;
+  // Frames a requested size is remembered for
+  static constexpr uint64_t RequestFrames = 30;
+
+  static void Init();
+  static void Shutdown();
+
+  // Records the image copies of this frame, before its render pass
+  static void Update(VkCommandBuffer commandBuffer);
+
+  static void Register(VulkanTexture2D *texture);
+  static void Unregister(VulkanTexture2D *texture);
+
+  static uint64_t GetResidentBytes();
+  static uint64_t GetBudget();
+};
+} // namespace MyEngine
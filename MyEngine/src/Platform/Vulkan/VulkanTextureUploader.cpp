@@ -0,0 +1,202 @@
+#include "mepch.h"
+
+#include "MyEngine/Core/Application.h"
+#include "MyEngine/Core/ThreadPool.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanTexture.h"
+#include "Platform/Vulkan/VulkanTextureUploader.h"
+
+#include <deque>
+#include <future>
+
+namespace MyEngine {
+struct UploadRequest {
+  VulkanTexture2D *Texture;
+  // Decoded files are handed to the streamer, data is uploaded right away
+  std::future<std::vector<ImageData>> Decode;
+  ImageData Image;
+  bool Decoded = false;
+};
+
+struct TextureUploaderData {
+  // Uploaded in the order they were queued
+  std::deque<UploadRequest> Pending;
+
+  // Compressed formats the device samples, by their linear variant in order
+  // of preference
+  std::vector<TextureFormat> Formats;
+
+  Ref<VulkanTexture2D> Placeholder;
+  Ref<VulkanTexture2D> ErrorTexture;
+};
+
+static Unique<TextureUploaderData> s_Data;
+
+static Ref<VulkanTexture2D> CreateFallback(uint32_t size, uint32_t color0,
+                                           uint32_t color1) {
+  TextureSpecification specification;
+  specification.Width = size;
+  specification.Height = size;
+  specification.Filter = TextureFilter::Nearest;
+  specification.GenerateMips = false;
+
+  std::vector<uint32_t> pixels(size * size);
+  for (uint32_t y = 0; y < size; y++) {
+    for (uint32_t x = 0; x < size; x++) {
+      pixels[y * size + x] = ((x ^ y) & 1) ? color1 : color0;
+    }
+  }
+
+  Ref<VulkanTexture2D> texture = CreateRef<VulkanTexture2D>(specification);
+  texture->SetData(pixels.data(), (uint32_t)(pixels.size() * 4));
+  return texture;
+}
+
+// Linear and sRGB variant, best quality per bit first
+static const std::pair<TextureFormat, TextureFormat> s_CompressedFormats[] = {
+    {TextureFormat::BC7, TextureFormat::BC7_SRGB},
+    {TextureFormat::ASTC_4x4, TextureFormat::ASTC_4x4_SRGB},
+    {TextureFormat::ETC2_RGBA8, TextureFormat::ETC2_RGBA8_SRGB},
+    {TextureFormat::BC3, TextureFormat::BC3_SRGB},
+    {TextureFormat::BC1, TextureFormat::BC1_SRGB},
+    {TextureFormat::BC5, TextureFormat::BC5},
+};
+
+static bool IsSampled(VkPhysicalDevice physicalDevice, TextureFormat format) {
+  VkFormatProperties properties;
+  vkGetPhysicalDeviceFormatProperties(physicalDevice, ToVulkanFormat(format),
+                                      &properties);
+  return properties.optimalTilingFeatures &
+         VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+}
+
+void VulkanTextureUploader::Init() {
+  s_Data = CreateUnique<TextureUploaderData>();
+
+  VulkanContext *context =
+      Application::Get().GetGraphicsContext<VulkanContext>();
+  for (const auto &[linear, srgb] : s_CompressedFormats) {
+    if (IsSampled(context->PhysicalDevice, linear) &&
+        IsSampled(context->PhysicalDevice, srgb)) {
+      s_Data->Formats.push_back(linear);
+    }
+  }
+  ME_CORE_INFO("{0} compressed texture formats supported",
+               s_Data->Formats.size());
+
+  // Queued first, so they are resident before any draw of the first frame.
+  // Colors are little endian ABGR so their bytes are RGBA.
+  s_Data->Placeholder = CreateFallback(1, 0xFFFFFFFF, 0xFFFFFFFF);
+  s_Data->ErrorTexture = CreateFallback(8, 0xFFFF00FF, 0xFF000000);
+}
+
+void VulkanTextureUploader::Shutdown() { s_Data.reset(); }
+
+void VulkanTextureUploader::Update(VkCommandBuffer commandBuffer) {
+  if (!s_Data) {
+    return;
+  }
+
+  VkDeviceSize uploaded = 0;
+  auto it = s_Data->Pending.begin();
+  while (it != s_Data->Pending.end()) {
+    if (!it->Decoded) {
+      if (it->Decode.wait_for(std::chrono::seconds(0)) !=
+          std::future_status::ready) {
+        it++;
+        continue;
+      }
+      std::vector<ImageData> mips = it->Decode.get();
+      if (mips.empty()) {
+        it->Texture->OnLoadFailed();
+      } else {
+        it->Texture->OnDecoded(std::move(mips));
+      }
+      it = s_Data->Pending.erase(it);
+      continue;
+    }
+
+    // The first upload of a frame always goes through, so a single large
+    // texture can't stall the queue
+    const VkDeviceSize size = it->Image.Pixels.size();
+    if (uploaded > 0 && uploaded + size > FrameBudget) {
+      break;
+    }
+    it->Texture->Upload(commandBuffer, it->Image);
+    uploaded += size;
+    it = s_Data->Pending.erase(it);
+  }
+}
+
+void VulkanTextureUploader::QueueDecode(VulkanTexture2D *texture,
+                                        const std::string &filepath) {
+  ME_CORE_ASSERT(s_Data, "Textures can't be loaded before the renderer!");
+  Cancel(texture);
+
+  UploadRequest request;
+  request.Texture = texture;
+  const TextureSpecification &specification = texture->GetSpecification();
+  request.Decode = ThreadPool::Get().Submit(
+      [filepath, specification, formats = s_Data->Formats]() {
+        std::vector<ImageData> mips;
+        if (ImageDecoder::IsKTX2(filepath)) {
+          if (!ImageDecoder::DecodeKTX2(filepath, formats, &mips)) {
+            return std::vector<ImageData>();
+          }
+        } else {
+          ImageData image;
+          if (!ImageDecoder::Decode(filepath, &image)) {
+            return std::vector<ImageData>();
+          }
+          // Only KTX2 files bring their format, sRGB is up to the caller
+          if (specification.Format == TextureFormat::RGBA8_SRGB) {
+            image.Format = TextureFormat::RGBA8_SRGB;
+          }
+          mips.push_back(std::move(image));
+        }
+
+        // Compressed files bring their mips, when they have any
+        if (specification.GenerateMips && mips.size() == 1 &&
+            TextureFormatBlockSize(mips[0].Format) == 0) {
+          return ImageDecoder::GenerateMips(std::move(mips[0]));
+        }
+        return mips;
+      });
+  s_Data->Pending.push_back(std::move(request));
+}
+
+void VulkanTextureUploader::QueueData(VulkanTexture2D *texture,
+                                      ImageData &&image) {
+  ME_CORE_ASSERT(s_Data, "Textures can't be loaded before the renderer!");
+  Cancel(texture);
+
+  UploadRequest request;
+  request.Texture = texture;
+  request.Image = std::move(image);
+  request.Decoded = true;
+  s_Data->Pending.push_back(std::move(request));
+}
+
+void VulkanTextureUploader::Cancel(VulkanTexture2D *texture) {
+  if (!s_Data) {
+    return;
+  }
+
+  // A decode that is still running finishes into its abandoned future
+  for (auto it = s_Data->Pending.begin(); it != s_Data->Pending.end(); it++) {
+    if (it->Texture == texture) {
+      s_Data->Pending.erase(it);
+      return;
+    }
+  }
+}
+
+const VulkanTexture2D *VulkanTextureUploader::GetPlaceholder() {
+  return s_Data ? s_Data->Placeholder.get() : nullptr;
+}
+
+const VulkanTexture2D *VulkanTextureUploader::GetErrorTexture() {
+  return s_Data ? s_Data->ErrorTexture.get() : nullptr;
+}
+} // namespace MyEngine
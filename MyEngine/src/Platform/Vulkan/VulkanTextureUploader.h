@@ -0,0 +1,40 @@
+#pragma once
+
+#include "MyEngine/Core/Base.h"
+#include "MyEngine/Renderer/Image.h"
+
+#include <vulkan/vulkan.h>
+
+namespace MyEngine {
+class VulkanTexture2D;
+
+// Moves texture data to the GPU without stalling the frame loop. Images are
+// decoded on the thread pool together with their mip chain, KTX2 files in the
+// best compressed format the device samples, and handed to the
+// texture streamer, which uploads them under its memory budget. Data set
+// directly is copied through the staging belt by the command buffer of the
+// next frame, before its render pass. At most FrameBudget bytes are uploaded
+// per frame so loading many textures spreads over several frames.
+class VulkanTextureUploader {
+public:
+  static constexpr VkDeviceSize FrameBudget = 32 * 1024 * 1024;
+
+  static void Init();
+  static void Shutdown();
+
+  // Never blocks, decodes that are still running are picked up by a later
+  // frame
+  static void Update(VkCommandBuffer commandBuffer);
+
+  // A new request for a texture replaces its pending one
+  static void QueueDecode(VulkanTexture2D *texture,
+                          const std::string &filepath);
+  static void QueueData(VulkanTexture2D *texture, ImageData &&image);
+  static void Cancel(VulkanTexture2D *texture);
+
+  // Sampled in place of textures that aren't loaded yet
+  static const VulkanTexture2D *GetPlaceholder();
+  // Sampled in place of textures that failed to decode
+  static const VulkanTexture2D *GetErrorTexture();
+};
+} // namespace MyEngine
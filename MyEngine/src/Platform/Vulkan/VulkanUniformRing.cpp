@@ -0,0 +1,75 @@
+#include "mepch.h"
+
+#include "Platform/Vulkan/VulkanContext.h"
+#include "Platform/Vulkan/VulkanUniformRing.h"
+
+namespace MyEngine {
+void VulkanUniformRing::Init(VulkanContext *context, VkDeviceSize size) {
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(context->PhysicalDevice, &properties);
+  m_Alignment = properties.limits.minUniformBufferOffsetAlignment;
+  m_MaxRange = properties.limits.maxUniformBufferRange;
+  m_Size = size;
+  m_Context = context;
+
+  m_Buffer = CreateUnique<VulkanHostBuffer>(context, m_Size,
+                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+}
+
+void VulkanUniformRing::Destroy(VulkanContext *context) { m_Buffer.reset(); }
+
+void VulkanUniformRing::BeginFrame(uint64_t frameSerial,
+                                   uint64_t completedSerial) {
+  if (m_FrameEnds.empty() || m_FrameEnds.back().second != m_Allocated) {
+    m_FrameEnds.emplace_back(frameSerial, m_Allocated);
+  }
+
+  while (!m_FrameEnds.empty() && m_FrameEnds.front().first <= completedSerial) {
+    m_Released = m_FrameEnds.front().second;
+    m_FrameEnds.pop_front();
+  }
+}
+
+uint32_t VulkanUniformRing::Push(const void *data, uint32_t size) {
+  VkDeviceSize offset = (m_Head + m_Alignment - 1) & ~(m_Alignment - 1);
+  // Blocks never wrap, the tail end of the buffer is skipped instead
+  if (offset + size > m_Size) {
+    offset = 0;
+  }
+  VkDeviceSize end = offset + size;
+  uint64_t consumed = offset >= m_Head ? end - m_Head : (m_Size - m_Head) + end;
+
+  // Never overwrites blocks the frames in flight may still read
+  if (m_Allocated + consumed - m_Released > m_Size) {
+    Grow(size);
+    offset = 0;
+    end = size;
+    consumed = size;
+  }
+
+  m_Buffer->Write(offset, data, size);
+  m_Allocated += consumed;
+  m_Head = end;
+  return (uint32_t)offset;
+}
+
+void VulkanUniformRing::Grow(uint32_t size) {
+  const VkDeviceSize newSize = std::max(m_Size * 2, (VkDeviceSize)size);
+  ME_CORE_WARN("Uniform ring exhausted, growing it from {0} to {1} bytes",
+               m_Size, newSize);
+
+  // Draws recorded so far still read the old buffer
+  Ref<VulkanHostBuffer> oldBuffer(m_Buffer.release());
+  m_Context->DescriptorAllocator.ReleasePersistentSets(oldBuffer->GetBuffer());
+  m_Context->Defer([oldBuffer]() mutable { oldBuffer.reset(); });
+
+  m_Size = newSize;
+  m_Buffer = CreateUnique<VulkanHostBuffer>(m_Context, m_Size,
+                                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+  m_Head = 0;
+  m_Allocated = 0;
+  m_Released = 0;
+  m_FrameEnds.clear();
+  m_Generation++;
+}
+} // namespace MyEngine
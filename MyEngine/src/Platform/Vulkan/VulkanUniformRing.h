@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Platform/Vulkan/VulkanHostBuffer.h"
+
+#include <deque>
+
+namespace MyEngine {
+class VulkanContext;
+
+// Persistently mapped host visible buffer that per draw uniform data is
+// linearly written into. Space is handed out in order and given back once the
+// frame that used it finished on the GPU, so every draw gets its own copy of
+// its constants without allocations or descriptor updates. Shaders bind it as
+// VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC and select their block with the
+// returned offset. When the frames in flight fill it the ring moves to a
+// buffer twice the size, the old one is destroyed once those frames finished.
+class VulkanUniformRing {
+public:
+  static constexpr VkDeviceSize DefaultSize = 8 * 1024 * 1024;
+
+  void Init(VulkanContext *context, VkDeviceSize size = DefaultSize);
+  void Destroy(VulkanContext *context);
+
+  // Called once the fence of a frame was waited on. Everything written so far
+  // belongs to frameSerial, space of frames up to completedSerial is reused.
+  void BeginFrame(uint64_t frameSerial, uint64_t completedSerial);
+
+  // Copies the block into the ring, returns its dynamic offset into the
+  // current buffer
+  uint32_t Push(const void *data, uint32_t size);
+
+  VkBuffer GetBuffer() const { return m_Buffer->GetBuffer(); }
+  // Changes whenever the ring moved to a new buffer. Offsets and descriptor
+  // sets of older generations point at the old buffer.
+  uint32_t GetGeneration() const { return m_Generation; }
+  // Largest block that can be bound with a single descriptor
+  uint32_t GetMaxRange() const { return m_MaxRange; }
+
+private:
+  void Grow(uint32_t size);
+
+  VulkanContext *m_Context = nullptr;
+  Unique<VulkanHostBuffer> m_Buffer;
+  uint32_t m_Generation = 0;
+  VkDeviceSize m_Size = 0;
+  VkDeviceSize m_Alignment = 1;
+  uint32_t m_MaxRange = 0;
+  // Write position inside the buffer
+  VkDeviceSize m_Head = 0;
+  // Monotonic byte counters, their difference is the space in flight
+  uint64_t m_Allocated = 0;
+  uint64_t m_Released = 0;
+  std::deque<std::pair<uint64_t, uint64_t>> m_FrameEnds;
+};
+} // namespace MyEngine
@@ -1,38 +1,82 @@
 #include "mepch.h"
 
 #include "MyEngine/Core/Application.h"
+#include "Platform/Vulkan/VulkanBuffer.h"
 #include "Platform/Vulkan/VulkanContext.h"
 #include "Platform/Vulkan/VulkanVertexArray.h"
 
 #include <vulkan/vulkan.h>
 
 namespace MyEngine {
+// Buffers bound in the command buffer of the frame with Serial. Destroyed
+// buffers release their handles with a later frame, so a handle can't be
+// reused while it is recorded here.
+struct VertexArrayBinding {
+  uint64_t Serial = 0;
+  uint32_t Count = 0;
+  VkBuffer Buffers[VulkanVertexArray::MaxVertexBuffers] = {};
+  VkBuffer IndexBuffer = VK_NULL_HANDLE;
+};
+
+static VertexArrayBinding s_Binding;
+
 VulkanVertexArray::VulkanVertexArray() {}
 VulkanVertexArray::~VulkanVertexArray() {}
 
 void VulkanVertexArray::Bind() const {
-  for (auto &buffer : m_VertexBuffers) {
-    buffer->Bind();
+  VulkanContext *context = static_cast<VulkanContext *>(
+      Application::Get().GetWindow().GetGraphicsContext());
+
+  // Every stream in one call. The handles are read at bind time since
+  // buffers may recreate theirs.
+  VkBuffer buffers[MaxVertexBuffers];
+  VkDeviceSize offsets[MaxVertexBuffers] = {};
+  const uint32_t count = (uint32_t)m_VertexBuffers.size();
+  for (uint32_t i = 0; i < count; i++) {
+    const VulkanVertexBuffer *buffer =
+        static_cast<const VulkanVertexBuffer *>(m_VertexBuffers[i].get());
+    buffers[i] = buffer->GetBuffer();
   }
+  const VkBuffer indexBuffer =
+      static_cast<const VulkanIndexBuffer *>(m_IndexBuffer.get())->GetBuffer();
 
+  if (s_Binding.Serial == context->FrameSerial && s_Binding.Count == count &&
+      s_Binding.IndexBuffer == indexBuffer &&
+      std::equal(buffers, buffers + count, s_Binding.Buffers)) {
+    return;
+  }
+
+  if (count > 0) {
+    vkCmdBindVertexBuffers(context->Window.GetCurrentFrame()->CommandBuffer, 0,
+                           count, buffers, offsets);
+  }
   m_IndexBuffer->Bind();
+
+  s_Binding.Serial = context->FrameSerial;
+  s_Binding.Count = count;
+  std::copy(buffers, buffers + count, s_Binding.Buffers);
+  s_Binding.IndexBuffer = indexBuffer;
 }
 
 void VulkanVertexArray::Unbind() const {}
 
-void VulkanVertexArray::Draw() const {
+void VulkanVertexArray::Draw(const DrawRange &range) const {
   VulkanContext *context = static_cast<VulkanContext *>(
       Application::Get().GetWindow().GetGraphicsContext());
-  uint32_t count = m_IndexBuffer->GetCount();
-  vkCmdDrawIndexed(context->Window.GetCurrentFrame()->CommandBuffer, count, 1,
-                   0, 0, 0);
+  vkCmdDrawIndexed(context->Window.GetCurrentFrame()->CommandBuffer,
+                   range.IndexCount, 1, range.FirstIndex, range.VertexOffset,
+                   0);
 }
 
 void VulkanVertexArray::AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) {
+  ME_CORE_ASSERT(m_VertexBuffers.size() < MaxVertexBuffers,
+                 "Too many vertex buffers in one vertex array!");
   m_VertexBuffers.push_back(vertexBuffer);
 }
 
 void VulkanVertexArray::SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) {
   m_IndexBuffer = indexBuffer;
 }
+
+void VulkanVertexArray::InvalidateBinding() { s_Binding = {}; }
 } // namespace MyEngine
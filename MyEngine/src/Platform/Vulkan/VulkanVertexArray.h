@@ -3,14 +3,21 @@
 #include "MyEngine/Renderer/VertexArray.h"
 
 namespace MyEngine {
+// Vertex buffer i is bound to binding i, matching the bindings of the
+// pipelines VulkanShader creates for the array's layouts. Binds are skipped
+// when the same buffers are already bound in the frame, so meshes of one
+// GeometryPool page are drawn back to back without rebinding.
 class VulkanVertexArray : public VertexArray {
 public:
+  // Lowest maxVertexInputBindings the spec allows
+  static constexpr uint32_t MaxVertexBuffers = 16;
+
   VulkanVertexArray();
   virtual ~VulkanVertexArray();
 
   virtual void Bind() const override;
   virtual void Unbind() const override;
-  virtual void Draw() const override;
+  virtual void Draw(const DrawRange &range) const override;
 
   virtual void AddVertexBuffer(const Ref<VertexBuffer> &vertexBuffer) override;
   virtual void SetIndexBuffer(const Ref<IndexBuffer> &indexBuffer) override;
@@ -23,8 +30,11 @@ public:
     return m_IndexBuffer;
   }
 
+  // Forgets the bound buffers, for code binding vertex or index buffers of
+  // its own into the frame's command buffer
+  static void InvalidateBinding();
+
 private:
-  uint32_t m_VertexBufferIndex = 0;
   std::vector<Ref<VertexBuffer>> m_VertexBuffers;
   Ref<IndexBuffer> m_IndexBuffer;
 };
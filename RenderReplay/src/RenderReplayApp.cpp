@@ -0,0 +1,30 @@
+#include "MyEngine/Core/Application.h"
+#include "ReplayLayer.h"
+#include <MyEngine.h>
+#include <MyEngine/Core/EntryPoint.h>
+
+class RenderReplay : public MyEngine::Application {
+public:
+  RenderReplay(const MyEngine::ApplicationSpecification &specification)
+      : MyEngine::Application(specification) {
+    const MyEngine::ApplicationCommandLineArgs &args =
+        specification.CommandLineArgs;
+    PushLayer(new ReplayLayer(args.GetOption("capture"),
+                              (uint32_t)args.GetUnsignedOption("loops", 1)));
+  }
+
+  ~RenderReplay() {}
+};
+
+MyEngine::Application *
+MyEngine::CreateApplication(MyEngine::ApplicationCommandLineArgs args) {
+  ApplicationSpecification spec;
+  spec.Name = "RenderReplay";
+  spec.CommandLineArgs = args;
+  // Replays run as fast as the backend can go
+  spec.VSync = false;
+  // The replay layer closes the app after the last loop
+  spec.ClosesItself = true;
+
+  return new RenderReplay(spec);
+}
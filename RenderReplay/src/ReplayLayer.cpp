@@ -0,0 +1,56 @@
+#include "ReplayLayer.h"
+
+#include "MyEngine/Time/Time.h"
+
+using namespace MyEngine;
+
+ReplayLayer::ReplayLayer(const std::string &capturePath, uint32_t loops)
+    : Layer("ReplayLayer"), m_CapturePath(capturePath),
+      m_Loops(loops > 0 ? loops : 1) {}
+
+void ReplayLayer::OnAttach() {
+  if (m_CapturePath.empty()) {
+    ME_ERROR("No capture given, pass --capture=<path>");
+    Application::Get().Close();
+    return;
+  }
+
+  if (!m_Replayer.Load(m_CapturePath)) {
+    Application::Get().Close();
+    return;
+  }
+
+  ME_INFO("Replaying {0} frames {1} times", m_Replayer.GetFrameCount(),
+          m_Loops);
+  m_StartTime = Time::GetTime();
+}
+
+void ReplayLayer::OnUpdate(Timestep ts) {
+  if (m_CurrentLoop >= m_Loops) {
+    return;
+  }
+
+  if (m_Replayer.ReplayFrame()) {
+    m_FramesReplayed++;
+    return;
+  }
+
+  if (++m_CurrentLoop >= m_Loops) {
+    Finish();
+    return;
+  }
+
+  m_Replayer.Rewind();
+  if (m_Replayer.ReplayFrame()) {
+    m_FramesReplayed++;
+  }
+}
+
+void ReplayLayer::Finish() {
+  unsigned long elapsed = Time::GetTime() - m_StartTime;
+  float seconds = elapsed / 1000.0f;
+  ME_INFO("Replayed {0} frames in {1} ms ({2} frames/s)", m_FramesReplayed,
+          elapsed, seconds > 0.0f ? m_FramesReplayed / seconds : 0.0f);
+
+  Application::Get().Close();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "MyEngine.h"
+
+// Replays a render capture as fast as the backend allows and reports the
+// achieved frame rate once every loop finished.
+class ReplayLayer : public MyEngine::Layer {
+public:
+  ReplayLayer(const std::string &capturePath, uint32_t loops);
+  virtual ~ReplayLayer() = default;
+
+  virtual void OnAttach() override;
+  virtual void OnUpdate(MyEngine::Timestep ts) override;
+
+private:
+  void Finish();
+
+  MyEngine::RenderCaptureReplayer m_Replayer;
+  std::string m_CapturePath;
+  uint32_t m_Loops;
+  uint32_t m_CurrentLoop = 0;
+  uint32_t m_FramesReplayed = 0;
+  unsigned long m_StartTime = 0;
+};
@@ -2,9 +2,13 @@
 
 #include "imgui.h"
 
+#include <glm/gtc/matrix_transform.hpp>
+
 using namespace MyEngine;
 
-ExampleLayer::ExampleLayer() {
+ExampleLayer::ExampleLayer() : m_Camera(45.0f, 1.778f, 0.1f, 1000.0f) {
+  m_Camera.SetDistance(2.0f);
+
   m_VertexArray = VertexArray::Create();
 
   m_Vertices = {{{-0.5f, -0.5f, 0.0f}, {1.0f, 0.0f, 0.0f, 1.0f}},
@@ -14,10 +18,7 @@ ExampleLayer::ExampleLayer() {
 
   Ref<VertexBuffer> vertexBuffer =
       VertexBuffer::Create(m_Vertices.data(), m_Vertices.size());
-  BufferLayout layout = {{ShaderDataType::Float3, "a_position"},
-                         {ShaderDataType::Float4, "a_color"}};
-
-  vertexBuffer->SetLayout(layout);
+  vertexBuffer->SetLayout(DefaultVertexLayout::Get());
   m_VertexArray->AddVertexBuffer(vertexBuffer);
 
   m_Indices = {0, 1, 2, 2, 3, 0};
@@ -25,13 +26,42 @@ ExampleLayer::ExampleLayer() {
       IndexBuffer::Create(m_Indices.data(), m_Indices.size());
   m_VertexArray->SetIndexBuffer(indexBuffer);
 
-  Ref<MyEngine::ShaderStage> vertModule =
-      ShaderStage::Create("shaders/vertexColor.vert.glsl", ShaderStage::Vertex);
-  Ref<MyEngine::ShaderStage> fragModule = ShaderStage::Create(
-      "shaders/vertexColor.frag.glsl", ShaderStage::Fragment);
-
-  std::vector<Ref<MyEngine::ShaderStage>> modules{vertModule, fragModule};
+  std::vector<Ref<MyEngine::ShaderStage>> modules = ShaderStage::CreateBatch(
+      {{"shaders/vertexColor.vert.glsl", ShaderStage::Vertex},
+       {"shaders/vertexColor.frag.glsl", ShaderStage::Fragment}});
   m_Shader = Shader::Create("VertexColorShader", modules);
+
+  const ApplicationCommandLineArgs &args =
+      Application::Get().GetSpecification().CommandLineArgs;
+  const std::string meshPath = args.GetOption("mesh");
+  const uint32_t batchSize = (uint32_t)args.GetUnsignedOption("batch", 0);
+  if (!meshPath.empty() && batchSize > 0) {
+    BuildBatch(meshPath, batchSize);
+  } else if (!meshPath.empty()) {
+    m_Mesh = Mesh::Load(meshPath);
+  }
+}
+
+void ExampleLayer::BuildBatch(const std::string &meshPath, uint32_t size) {
+  MeshData mesh;
+  if (!Mesh::LoadData(meshPath, &mesh)) {
+    return;
+  }
+
+  // A size x size grid of copies, a mesh apart
+  const Vector3 extent = mesh.Bounds.Max - mesh.Bounds.Min;
+  const float spacing = std::max(extent.x, extent.z) * 1.5f;
+  m_Batch = CreateUnique<StaticBatch>(spacing * 8.0f);
+  const float center = (float)(size / 2);
+  for (uint32_t x = 0; x < size; x++) {
+    for (uint32_t z = 0; z < size; z++) {
+      const Vector3 offset(((float)x - center) * spacing, 0.0f,
+                           ((float)z - center) * spacing);
+      m_Batch->Add(m_Shader, mesh, glm::translate(Matrix4(1.0f), offset));
+    }
+  }
+  m_Batch->Build();
+  m_Camera.SetDistance(spacing * size);
 }
 
 void ExampleLayer::OnAttach() {}
@@ -39,7 +69,26 @@ void ExampleLayer::OnAttach() {}
 void ExampleLayer::OnDetach() {}
 
 void ExampleLayer::OnUpdate(Timestep ts) {
-  Renderer::Submit(m_Shader, m_VertexArray);
+  Window &window = Application::Get().GetWindow();
+  if (window.GetWidth() > 0 && window.GetHeight() > 0) {
+    m_Camera.SetViewportSize((float)window.GetWidth(),
+                             (float)window.GetHeight());
+  }
+  m_Camera.OnUpdate(ts);
+
+  m_Shader->SetMat4("u_ViewProjection", m_Camera.GetViewProjection());
+  if (m_Batch) {
+    Renderer::Submit(*m_Batch, m_Camera.GetViewProjection());
+    return;
+  }
+  m_Shader->SetMat4("u_Transform",
+                    m_Mesh ? m_Mesh->GetTransform() : Matrix4(1.0f));
+  if (m_Mesh) {
+    Renderer::Submit(m_Shader, m_Mesh->GetVertexArray(),
+                     m_Mesh->GetDrawRange());
+  } else {
+    Renderer::Submit(m_Shader, m_VertexArray);
+  }
 }
 
 void ExampleLayer::OnImGuiRender() {
@@ -112,4 +161,4 @@ void ExampleLayer::OnImGuiRender() {
   ImGui::End();
 }
 
-void ExampleLayer::OnEvent(Event &e, void *pData) {}
+void ExampleLayer::OnEvent(Event &e, void *pData) { m_Camera.OnEvent(e); }
@@ -16,8 +16,15 @@ public:
   virtual void OnEvent(MyEngine::Event &e, void *pData) override;
 
 private:
+  void BuildBatch(const std::string &meshPath, uint32_t size);
+
   MyEngine::Ref<MyEngine::VertexArray> m_VertexArray;
+  // Drawn instead of the quad when --mesh=<path> is passed
+  MyEngine::Ref<MyEngine::Mesh> m_Mesh;
+  // With --batch=<n> as well, an n x n grid of the mesh is drawn instead
+  MyEngine::Unique<MyEngine::StaticBatch> m_Batch;
   MyEngine::Ref<MyEngine::Shader> m_Shader;
+  MyEngine::EditorCamera m_Camera;
 
   std::vector<MyEngine::Vertex> m_Vertices;
   std::vector<uint32_t> m_Indices;
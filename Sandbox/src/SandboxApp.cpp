@@ -13,9 +13,11 @@ public:
   ~Sandbox() {}
 };
 
-MyEngine::Application *MyEngine::CreateApplication() {
+MyEngine::Application *
+MyEngine::CreateApplication(MyEngine::ApplicationCommandLineArgs args) {
   ApplicationSpecification spec;
   spec.Name = "Sandbox";
+  spec.CommandLineArgs = args;
 
   return new Sandbox(spec);
 }
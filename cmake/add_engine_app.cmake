@@ -0,0 +1,37 @@
+# Executable built from the sources in src/ of the calling directory and linked
+# against the engine. A macro so the flags apply to the calling directory.
+macro(ADD_ENGINE_APP NAME)
+  if(UNIX AND NOT APPLE)
+    set(LINUX TRUE)
+  endif()
+
+  # -------------------------------------------
+  # COMPILER FLAGS/HINTS
+  # -------------------------------------------
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DNOMINMAX -D_USE_MATH_DEFINES")
+
+  if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-switch-enum")
+  endif()
+
+  add_definitions(-D_CRT_SECURE_NO_WARNINGS)
+  set(CMAKE_CXX_STANDARD 17)
+  set(CMAKE_CXX_STANDARD_REQUIRED ON)
+  set(CMAKE_POSITION_INDEPENDENT_CODE TRUE)
+  set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
+  # -------------------------------------------
+
+  include("${CMAKE_SOURCE_DIR}/cmake/find_spdlog.cmake")
+  find_spdlog()
+
+  # -------------------------------------------
+  # COMPILE/LINKING
+  # -------------------------------------------
+  file(GLOB ${NAME}_SOURCE "${CMAKE_CURRENT_SOURCE_DIR}/src/*.cpp")
+
+  include_directories("${CMAKE_SOURCE_DIR}/MyEngine/src")
+  link_directories(${CMAKE_BINARY_DIR}/bin)
+  add_executable(${NAME} ${${NAME}_SOURCE})
+  target_link_libraries(${NAME} PRIVATE ImGui MyEngine)
+  # -------------------------------------------
+endmacro()
@@ -0,0 +1,23 @@
+function(FIND_BASISU)
+  include(FetchContent)
+
+  # Only the transcoder and the zstd decoder are built, the encoder and its
+  # tools aren't needed to read textures
+  FetchContent_Declare(
+    basisu
+    GIT_REPOSITORY https://github.com/BinomialLLC/basis_universal.git
+    GIT_TAG v1_50_0_2
+    GIT_SHALLOW TRUE
+    GIT_PROGRESS TRUE)
+  FetchContent_GetProperties(basisu)
+  if(NOT basisu_POPULATED)
+    FetchContent_Populate(basisu)
+  endif()
+
+  add_library(basisu_transcoder STATIC
+              "${basisu_SOURCE_DIR}/transcoder/basisu_transcoder.cpp"
+              "${basisu_SOURCE_DIR}/zstd/zstddeclib.c")
+  target_include_directories(basisu_transcoder PUBLIC "${basisu_SOURCE_DIR}")
+  target_compile_definitions(basisu_transcoder
+                             PUBLIC BASISD_SUPPORT_KTX2_ZSTD=1)
+endfunction()
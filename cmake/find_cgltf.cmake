@@ -0,0 +1,14 @@
+function(FIND_CGLTF)
+  include(FetchContent)
+
+  # Header only, the implementation is compiled into the engine
+  FetchContent_Declare(
+    cgltf
+    GIT_REPOSITORY https://github.com/jkuhlmann/cgltf.git
+    GIT_TAG v1.14
+    GIT_SHALLOW TRUE
+    GIT_PROGRESS TRUE)
+  FetchContent_MakeAvailable(cgltf)
+
+  include_directories("${cgltf_SOURCE_DIR}")
+endfunction()
@@ -0,0 +1,19 @@
+function(FIND_GOOGLETEST)
+  find_package(GTest CONFIG)
+
+  if(NOT GTest_FOUND)
+    include(FetchContent)
+
+    # Links against the same runtime as the engine on windows
+    set(gtest_force_shared_crt
+        ON
+        CACHE BOOL "" FORCE)
+    FetchContent_Declare(
+      googletest
+      GIT_REPOSITORY https://github.com/google/googletest.git
+      GIT_TAG v1.14.0
+      GIT_SHALLOW TRUE
+      GIT_PROGRESS TRUE)
+    FetchContent_MakeAvailable(googletest)
+  endif()
+endfunction()
@@ -0,0 +1,11 @@
+function(FIND_MESHOPTIMIZER)
+  include(FetchContent)
+
+  FetchContent_Declare(
+    meshoptimizer
+    GIT_REPOSITORY https://github.com/zeux/meshoptimizer.git
+    GIT_TAG v0.21
+    GIT_SHALLOW TRUE
+    GIT_PROGRESS TRUE)
+  FetchContent_MakeAvailable(meshoptimizer)
+endfunction()
@@ -0,0 +1,33 @@
+function(FIND_SPIRV_CROSS)
+  find_package(spirv_cross_core CONFIG QUIET)
+
+  if(NOT spirv_cross_core_FOUND)
+    message(
+      STATUS
+        "SPIRV-Cross package was not found locally, attempting to fetch content"
+    )
+    include(FetchContent)
+
+    # Sources are placed in a spirv_cross folder so includes resolve as
+    # <spirv_cross/spirv_cross.hpp> like they do with the Vulkan SDK
+    FetchContent_Declare(
+      spirv_cross
+      GIT_REPOSITORY https://github.com/KhronosGroup/SPIRV-Cross.git
+      GIT_TAG vulkan-sdk-1.3.278.0
+      GIT_SHALLOW TRUE
+      GIT_PROGRESS TRUE
+      SOURCE_DIR "${CMAKE_BINARY_DIR}/_deps/spirv_cross_src/spirv_cross")
+    set(SPIRV_CROSS_CLI OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_TESTS OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_GLSL OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_HLSL OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_MSL OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_CPP OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_REFLECT OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_C_API OFF CACHE BOOL "" FORCE)
+    set(SPIRV_CROSS_ENABLE_UTIL OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(spirv_cross)
+
+    include_directories("${CMAKE_BINARY_DIR}/_deps/spirv_cross_src")
+  endif()
+endfunction()
@@ -0,0 +1,15 @@
+function(FIND_STB)
+  include(FetchContent)
+
+  # Header only, the implementation is compiled into the engine. stb has no
+  # releases, so it is pinned to a commit; a shallow clone can't check out a
+  # commit behind the tip of master.
+  FetchContent_Declare(
+    stb
+    GIT_REPOSITORY https://github.com/nothings/stb.git
+    GIT_TAG f75e8d1cad7d90d72ef7a4661f1b994ef78b4e31
+    GIT_PROGRESS TRUE)
+  FetchContent_MakeAvailable(stb)
+
+  include_directories("${stb_SOURCE_DIR}")
+endfunction()
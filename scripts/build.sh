@@ -10,13 +10,15 @@ HELP() {
     echo "-c RelWithDebInfo"
     echo "-c Release"
     echo "-m (use multi-configuration generator)"
+    echo "-a (build the AVX2 rasterizer path, needs an AVX2 cpu to run)"
     echo
 }
 
 config="Release"
 multiconfig=false
+avx2=OFF
 
-while getopts c:m:h: flag
+while getopts c:mah flag
 do
     case "${flag}" in
         h)  HELP
@@ -24,6 +26,7 @@ do
             ;;
         c) config=${OPTARG};;
         m) multiconfig=true;;
+        a) avx2=ON;;
         \?) # Incorrect option
             echo "Error: Invalid option"
             HELP
@@ -39,9 +42,9 @@ echo "Building in multiconfig mode: ${multiconfig}"
 echo
 
 if ${multiconfig}; then
-    cmake -S . -B ./build
+    cmake -S . -B ./build -D ME_WITH_AVX2=${avx2}
     cmake --build ./build --config ${config}
 else
-    cmake -S . -B ./build -D CMAKE_BUILD_TYPE=${config}
+    cmake -S . -B ./build -D CMAKE_BUILD_TYPE=${config} -D ME_WITH_AVX2=${avx2}
     cmake --build ./build # --config ${config}
 fi
@@ -0,0 +1,102 @@
+#!/bin/bash
+
+HELP() {
+    echo "This script runs the perf targets and compares them to the baseline"
+    echo
+    echo "Syntax: $0 [-n <runs>] [-f <frames>] [-t <target>] [-b <baseline>] [-a <args>] [-u] [-s]"
+    echo
+    echo "Options:"
+    echo "-n Number of runs per target (default 5)"
+    echo "-f Measured frames per run (default 600)"
+    echo "-t Target executable, may be repeated (default ./build/Sandbox/Sandbox)"
+    echo "-b Baseline json (default ./perf/baseline.json)"
+    echo "-a Extra arguments for the targets, like \"--renderer=software --headless\""
+    echo "-u Update the baseline with the results instead of comparing"
+    echo "-s Use the software vulkan driver (lavapipe) and a virtual display"
+    echo
+}
+
+runs=5
+frames=600
+warmup=60
+targets=()
+baseline="./perf/baseline.json"
+extra=""
+update=false
+software=false
+output="./build/perf"
+
+while getopts n:f:t:b:a:ush flag
+do
+    case "${flag}" in
+        h)  HELP
+            exit 0
+            ;;
+        n) runs=${OPTARG};;
+        f) frames=${OPTARG};;
+        t) targets+=("${OPTARG}");;
+        b) baseline=${OPTARG};;
+        a) extra=${OPTARG};;
+        u) update=true;;
+        s) software=true;;
+        \?) # Incorrect option
+            echo "Error: Invalid option"
+            HELP
+            exit 1
+            ;;
+    esac
+done
+
+if [ ${#targets[@]} -eq 0 ]; then
+    targets=("./build/Sandbox/Sandbox")
+fi
+
+launcher=()
+if ${software}; then
+    # Prefer lavapipe so the numbers do not depend on the host gpu
+    for icd in /usr/share/vulkan/icd.d/lvp_icd*.json; do
+        if [ -f "${icd}" ]; then
+            export VK_ICD_FILENAMES="${icd}"
+            echo "Using software vulkan driver: ${icd}"
+            break
+        fi
+    done
+
+    if [ -z "${DISPLAY}" ] && command -v xvfb-run > /dev/null; then
+        launcher=(xvfb-run -a)
+    fi
+fi
+
+rm -rf "${output}"
+mkdir -p "${output}"
+
+for target in "${targets[@]}"; do
+    if [ ! -x "${target}" ]; then
+        echo "Error: ${target} is not built, run ./scripts/build.sh first"
+        exit 1
+    fi
+
+    name=$(basename "${target}")
+    mkdir -p "${output}/${name}"
+
+    for ((run = 0; run < runs; run++)); do
+        echo "Running ${name} (${run}/${runs})"
+        "${launcher[@]}" "${target}" --perf-frames=${frames} \
+            --perf-warmup=${warmup} ${extra} \
+            --perf-output="${output}/${name}/run${run}.json" > /dev/null
+        if [ $? -ne 0 ]; then
+            echo "Error: ${name} exited with a failure"
+            exit 1
+        fi
+    done
+done
+
+# Next to this script, so it also runs from other checkouts
+compare="$(dirname "$0")/perf_compare.py"
+if ${update}; then
+    python3 "${compare}" --baseline "${baseline}" \
+        --results "${output}" --update
+else
+    python3 "${compare}" --baseline "${baseline}" \
+        --results "${output}"
+fi
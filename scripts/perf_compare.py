@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Aggregates perf runs and compares them against the checked in baseline.
+
+Every run writes one json report (see MyEngine/Core/PerfStats.cpp). For each
+target and metric the median across runs is compared against the baseline. A
+metric regresses when its median is worse than the baseline by more than its
+threshold, a percentage of the baseline plus an absolute slack for values
+close to zero. The median already ignores single noisy runs. The distribution
+free 95% confidence interval of the median is printed to judge the noise.
+
+Exits with 1 when any metric regressed, or has no baseline value to compare
+against. Record those with --update first.
+"""
+
+import argparse
+import json
+import math
+import os
+import sys
+
+DEFAULT_THRESHOLD = 0.10
+
+
+def median(values):
+    values = sorted(values)
+    mid = len(values) // 2
+    if len(values) % 2 == 0:
+        return (values[mid - 1] + values[mid]) * 0.5
+    return values[mid]
+
+
+def median_confidence_interval(values, z=1.96):
+    """Order statistic interval around the median (binomial approximation)."""
+    values = sorted(values)
+    n = len(values)
+    half_width = z * math.sqrt(n) * 0.5
+    lower = max(int(math.floor(n * 0.5 - half_width)), 0)
+    upper = min(int(math.ceil(n * 0.5 + half_width)), n - 1)
+    return values[lower], values[upper]
+
+
+def load_results(directory):
+    results = {}
+    for target in sorted(os.listdir(directory)):
+        target_dir = os.path.join(directory, target)
+        if not os.path.isdir(target_dir):
+            continue
+
+        runs = {}
+        for name in sorted(os.listdir(target_dir)):
+            if not name.endswith(".json"):
+                continue
+            with open(os.path.join(target_dir, name)) as f:
+                report = json.load(f)
+            for metric, value in report["metrics"].items():
+                runs.setdefault(metric, []).append(float(value))
+
+        if runs:
+            results[target] = runs
+    return results
+
+
+def summarize(results):
+    summary = {}
+    for target, metrics in results.items():
+        summary[target] = {}
+        for metric, values in metrics.items():
+            lower, upper = median_confidence_interval(values)
+            summary[target][metric] = {
+                "median": median(values),
+                "lower": lower,
+                "upper": upper,
+                "runs": len(values),
+            }
+    return summary
+
+
+def update_baseline(path, baseline, summary):
+    for target, metrics in summary.items():
+        entry = baseline.setdefault(target, {})
+        for metric, stats in metrics.items():
+            limits = entry.setdefault(metric, {"threshold": DEFAULT_THRESHOLD})
+            limits["value"] = round(stats["median"], 4)
+
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    with open(path, "w") as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+        f.write("\n")
+    print("Baseline updated: {}".format(path))
+
+
+def compare(baseline, summary):
+    header = "{:<12} {:<22} {:>12} {:>12} {:>25} {:>9}  {}".format(
+        "target", "metric", "baseline", "median", "95% ci", "delta", "status")
+    print(header)
+    print("-" * len(header))
+
+    regressions = 0
+    missing = 0
+    for target, metrics in summary.items():
+        limits = baseline.get(target, {})
+        for metric, stats in sorted(metrics.items()):
+            entry = limits.get(metric, {})
+            base = entry.get("value")
+            threshold = entry.get("threshold", DEFAULT_THRESHOLD)
+            slack = entry.get("abs", 0.0)
+
+            ci = "[{:.3f}, {:.3f}]".format(stats["lower"], stats["upper"])
+            if base is None:
+                status, delta = "NO BASELINE", ""
+                missing += 1
+            else:
+                if base != 0:
+                    delta = "{:+.1f}%".format(
+                        (stats["median"] - base) / abs(base) * 100.0)
+                else:
+                    delta = "{:+.3f}".format(stats["median"])
+
+                limit = base + abs(base) * threshold + slack
+                if stats["median"] > limit:
+                    status = "REGRESSION"
+                    regressions += 1
+                elif stats["median"] < base - abs(base) * threshold - slack:
+                    status = "improved"
+                else:
+                    status = "ok"
+
+            print("{:<12} {:<22} {:>12} {:>12.3f} {:>25} {:>9}  {}".format(
+                target, metric,
+                "-" if base is None else "{:.3f}".format(base),
+                stats["median"], ci, delta, status))
+
+    print()
+    if missing:
+        print("{} metric(s) have no baseline, record one with "
+              "./scripts/perf.sh -u".format(missing))
+    if regressions:
+        print("{} metric(s) regressed".format(regressions))
+    elif not missing:
+        print("No regressions")
+    return regressions + missing
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--baseline", required=True)
+    parser.add_argument("--results", required=True)
+    parser.add_argument("--update", action="store_true")
+    args = parser.parse_args()
+
+    results = load_results(args.results)
+    if not results:
+        print("No perf results found in {}".format(args.results))
+        return 1
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    elif not args.update:
+        print("Baseline {} not found, record one with ./scripts/perf.sh -u"
+              .format(args.baseline))
+        return 1
+
+    summary = summarize(results)
+    if args.update:
+        update_baseline(args.baseline, baseline, summary)
+        return 0
+
+    return 1 if compare(baseline, summary) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
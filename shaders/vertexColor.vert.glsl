@@ -1,12 +1,20 @@
 #version 450
 #pragma shader_stage(vertex)
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec4 inColor;
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec4 a_color;
 
 layout(location = 0) out vec4 fragColor;
 
+layout(set = 0, binding = 0) uniform Camera {
+    mat4 u_ViewProjection;
+};
+
+layout(push_constant) uniform Transform {
+    mat4 u_Transform;
+};
+
 void main() {
-    gl_Position = vec4(inPosition, 1.0);
-    fragColor = inColor;
+    gl_Position = u_ViewProjection * u_Transform * vec4(a_position, 1.0);
+    fragColor = a_color;
 }